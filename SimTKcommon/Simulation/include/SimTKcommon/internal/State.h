@@ -299,6 +299,14 @@ State(State&& source);
 /// copying only state variables and not the cache. If the source state hasn't
 /// been realized to at least Stage::Model, then we don't copy its state
 /// variables either, except those associated with the Topology stage.
+///
+/// If both States have been realized through Stage::Instance and have
+/// identical allocations (typically because they belong to the same System
+/// and were given the same Model- and Instance-stage choices), the copy is
+/// done in place: existing storage for state variables and cache entries is
+/// reused and nothing is freed or reallocated. The result is the same either
+/// way. This makes repeatedly resetting a scratch %State from a saved one
+/// cheap; see StatePool.
 State& operator=(const State&);
 
 /// Move assignment is very fast. The source object is left in a valid but
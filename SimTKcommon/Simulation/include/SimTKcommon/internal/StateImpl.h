@@ -171,6 +171,23 @@ public:
         return *this;
     }
 
+    // Return true if this variable was allocated exactly like the source, so
+    // that copyValueFrom() can be used instead of deepAssign().
+    bool isSameAllocationAs(const DiscreteVarInfo& src) const {
+        return m_allocationStage  == src.m_allocationStage
+            && m_invalidatedStage == src.m_invalidatedStage
+            && m_autoUpdateEntry  == src.m_autoUpdateEntry
+            && m_value && src.m_value && m_value->isCompatible(*src.m_value);
+    }
+
+    // Like deepAssign() but the source value is assigned into the existing
+    // value object rather than cloned, and the list of dependents is kept.
+    void copyValueFrom(const DiscreteVarInfo& src) {
+        m_value->compatibleAssign(*src.m_value);
+        m_valueVersion    = src.m_valueVersion;
+        m_timeLastUpdated = src.m_timeLastUpdated;
+    }
+
     // For use in the containing class's destructor.
     void deepDestruct(StateImpl&) {
         m_value.reset();
@@ -337,6 +354,43 @@ public:
         return *this;
     }
 
+    // Return true if this cache entry was allocated exactly like the source,
+    // with the same prerequisites, so that copyValueFrom() can be used instead
+    // of deepAssign() followed by registerWithPrerequisites().
+    bool isSameAllocationAs(const CacheEntryInfo& src) const {
+        return m_myKey           == src.m_myKey
+            && m_allocationStage == src.m_allocationStage
+            && m_dependsOnStage  == src.m_dependsOnStage
+            && m_computedByStage == src.m_computedByStage
+            && m_associatedVar   == src.m_associatedVar
+            && m_qIsPrerequisite == src.m_qIsPrerequisite
+            && m_uIsPrerequisite == src.m_uIsPrerequisite
+            && m_zIsPrerequisite == src.m_zIsPrerequisite
+            && m_discreteVarPrerequisites == src.m_discreteVarPrerequisites
+            && m_cacheEntryPrerequisites  == src.m_cacheEntryPrerequisites
+            && m_value && src.m_value && m_value->isCompatible(*src.m_value);
+    }
+
+    // Like deepAssign() but the source value is assigned into the existing
+    // value object rather than cloned. Since this entry is already registered
+    // with its prerequisites, it is left in the same condition it would have
+    // after registerWithPrerequisites(): an entry with prerequisites must be 
+    // recomputed in the destination State.
+    void copyValueFrom(const CacheEntryInfo& src) {
+        m_value->compatibleAssign(*src.m_value);
+        m_valueVersion = src.m_valueVersion;
+        m_dependsOnVersionWhenLastComputed = 
+            src.m_dependsOnVersionWhenLastComputed;
+        m_isUpToDateWithPrerequisites = !hasPrerequisites();
+        #ifndef NDEBUG
+        m_qVersion = src.m_qVersion; 
+        m_uVersion = src.m_uVersion; 
+        m_zVersion = src.m_zVersion;
+        m_discreteVarVersions = src.m_discreteVarVersions;
+        m_cacheEntryVersions  = src.m_cacheEntryVersions;
+        #endif
+    }
+
     // For use in the containing class's destructor.
     void deepDestruct(StateImpl& stateImpl) {
         m_value.reset(); // destruct the AbstractValue
@@ -378,6 +432,11 @@ public:
     bool isQPrerequisite() const {return m_qIsPrerequisite;}
     bool isUPrerequisite() const {return m_uIsPrerequisite;}
     bool isZPrerequisite() const {return m_zIsPrerequisite;}
+    bool hasPrerequisites() const {
+        return m_qIsPrerequisite || m_uIsPrerequisite || m_zIsPrerequisite
+            || !m_discreteVarPrerequisites.empty()
+            || !m_cacheEntryPrerequisites.empty();
+    }
     bool isPrerequisite(const DiscreteVarKey& dk) const { 
         return std::find(m_discreteVarPrerequisites.cbegin(),
                          m_discreteVarPrerequisites.cend(), dk)
@@ -474,6 +533,9 @@ public:
     // These the the "virtual" methods required by template methods elsewhere.
     TriggerInfo& deepAssign(const TriggerInfo& src) 
     {   return operator=(src); }
+    bool isSameAllocationAs(const TriggerInfo& src) const 
+    {   return allocationStage == src.allocationStage 
+            && firstIndex == src.firstIndex && nslots == src.nslots; }
     void         deepDestruct(StateImpl&) {}
     const Stage& getAllocationStage() const {return allocationStage;}
 private:
@@ -529,6 +591,10 @@ public:
     // These the the "virtual" methods required by template methods elsewhere.
     ContinuousVarInfo& deepAssign(const ContinuousVarInfo& src) 
     {   return operator=(src); }
+    bool isSameAllocationAs(const ContinuousVarInfo& src) const 
+    {   return allocationStage == src.allocationStage 
+            && firstIndex == src.firstIndex 
+            && getNumVars() == src.getNumVars(); }
     void               deepDestruct(StateImpl&) {}
     const Stage&       getAllocationStage() const {return allocationStage;}
 private:
@@ -580,6 +646,10 @@ public:
     // These the the "virtual" methods required by template methods elsewhere.
     ConstraintErrInfo& deepAssign(const ConstraintErrInfo& src) 
     {   return operator=(src); }
+    bool isSameAllocationAs(const ConstraintErrInfo& src) const 
+    {   return allocationStage == src.allocationStage 
+            && firstIndex == src.firstIndex 
+            && getNumErrs() == src.getNumErrs(); }
     void               deepDestruct(StateImpl&) {}
     const Stage&       getAllocationStage() const {return allocationStage;}
 private:
@@ -906,6 +976,17 @@ private:
     // forgotten as Instance, Model, and Topology stages are invalidated.
     void restoreToStage(Stage g);
 
+    // Return true if this subsystem and the source have both been realized
+    // through Instance stage and have identical allocations, so that 
+    // copyValuesFrom() can be used in place of copyFrom(src,Stage::Instance).
+    bool hasSameAllocationsAs(const PerSubsystemInfo& src) const;
+
+    // Same result as copyFrom(src, Stage::Instance) but values are assigned 
+    // into the existing allocations, so no heap allocation is needed provided
+    // that the values themselves can be assigned without it. References to
+    // global resources are kept since they are unchanged.
+    void copyValuesFrom(const PerSubsystemInfo& src);
+
     // Utility which makes "this" a copy of the source subsystem exactly as it
     // was after being realized to stage maxStage. If maxStage >= Model then
     // all the subsystem-private state variables will be copied, but only
@@ -924,6 +1005,9 @@ private:
     template <class T>
     void copyAllocationStackThroughStage(Array_<T>& stack, 
                                          const Array_<T>& src, const Stage&);
+    template <class T>
+    static bool isSameAllocationStack(const Array_<T>& stack, 
+                                      const Array_<T>& src);
 };
 
 
@@ -2106,6 +2190,14 @@ private:
     // cache entries are valid.
     void copyFrom(const StateImpl& source);
 
+    // Copy assignment can overwrite this State in place, without freeing and
+    // reallocating anything, if both States have been realized through 
+    // Instance stage and have identical allocations -- typically because they
+    // are States of the same System with the same Model- and Instance-stage
+    // choices. The result is the same as copyFrom().
+    bool canCopyInPlaceFrom(const StateImpl& source) const;
+    void copyInPlaceFrom(const StateImpl& source);
+
     // Make sure that no cache entry copied from src could accidentally think
     // it was up to date, by setting all the version counters higher than
     // the ones in the source. (Don't set these to zero because then a
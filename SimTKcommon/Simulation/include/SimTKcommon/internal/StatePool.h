@@ -0,0 +1,98 @@
+#ifndef SimTK_SimTKCOMMON_STATE_POOL_H_
+#define SimTK_SimTKCOMMON_STATE_POOL_H_
+
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** @file
+Declares the StatePool class for recycling State objects. **/
+
+#include "SimTKcommon/basics.h"
+#include "SimTKcommon/internal/State.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SimTK {
+
+/** A %StatePool hands out scratch copies of a prototype State and takes them
+back when they are no longer needed, so that States can be recycled instead of
+being constructed and destructed. This is intended for loops that perform many
+short simulations ("rollouts") starting from the same or similar States.
+
+The prototype should have been realized through at least Stage::Instance. Then
+every State in the pool has the same allocations as the prototype, and
+resetting a pooled State from the prototype or from any other State of the
+same System with the same Model- and Instance-stage choices is done in place by
+State's copy assignment operator, without heap allocation. States returned by
+acquire() have the prototype's contents (or the given source's) with cache
+entries valid through Stage::Instance, exactly as they would after an ordinary
+copy.
+
+%StatePool is thread safe; acquire() and release() may be called concurrently.
+The prototype is copied when the pool is constructed and is not affected by
+later changes to the State from which it was copied. **/
+class SimTK_SimTKCOMMON_EXPORT StatePool {
+public:
+    /** Create a pool whose States are copies of `prototype`, and optionally
+    create `numPreallocated` of them now so that later calls to acquire()
+    don't have to. **/
+    explicit StatePool(const State& prototype, int numPreallocated = 0);
+
+    /** Get the prototype State that was supplied on construction. **/
+    const State& getPrototype() const {return m_prototype;}
+
+    /** Obtain a State from the pool, reset to a copy of the prototype. A new
+    State is created if the pool is empty. Give it back with release() when
+    done. **/
+    std::unique_ptr<State> acquire();
+
+    /** Obtain a State from the pool, reset to a copy of `source` rather than
+    the prototype. This is in place if `source` has the same allocations as
+    the prototype. **/
+    std::unique_ptr<State> acquire(const State& source);
+
+    /** Return a State to the pool for later reuse. It is not necessary to
+    release States obtained from acquire(); any that are not released are just
+    deleted normally. A null pointer is ignored. **/
+    void release(std::unique_ptr<State> state);
+
+    /** Return the number of States currently available for reuse. **/
+    int getNumAvailable() const;
+
+    /** Delete all the States currently available for reuse. **/
+    void clear();
+
+private:
+    // Remove a State from the free list or return null if it is empty.
+    std::unique_ptr<State> takeFree();
+
+    State                                   m_prototype;
+    mutable std::mutex                      m_freeLock;
+    std::vector<std::unique_ptr<State>>     m_free;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SimTKCOMMON_STATE_POOL_H_
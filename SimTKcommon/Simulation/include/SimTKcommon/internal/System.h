@@ -281,6 +281,32 @@ requested stage or higher, nothing happens here. Otherwise, the state is
 realized one stage at a time until it reaches the requested stage. 
 @see realizeTopology(), realizeModel() **/
 void realize(const State& state, Stage stage = Stage::HighestRuntime) const;
+
+/** Realize each of the given \a states to the indicated \a stage, dividing
+the States among multiple threads. The result is the same as calling
+realize(state, stage) for each State in turn, but a batch of many States (as
+arises in parameter sweeps and sampling-based planning) is realized with one
+call and with all processors busy. Each State is realized entirely by a 
+single thread, so the States must be distinct objects, but they may be in any
+stage at or above Stage::Model and need not be in the same stage.
+
+If realizing any of the States throws an exception, the other States are
+still realized and then the exception from the lowest-numbered failing State
+is rethrown here. If this %System is already realizing a batch in another
+thread, this batch is realized serially in the calling thread instead.
+
+Any force elements or other components that you have added to this %System
+must support concurrent realization of different States, which means they
+must not write to their own data members while realizing a State.
+@see realize() **/
+void realizeBatch(const ArrayViewConst_<State>& states,
+                  Stage stage = Stage::HighestRuntime) const;
+
+/** Same as the other signature but for a batch of States that are not
+stored contiguously, such as those obtained from a StatePool. None of the
+pointers may be null. **/
+void realizeBatch(const ArrayViewConst_<const State*>& states,
+                  Stage stage = Stage::HighestRuntime) const;
 /**@}**/
 
 
@@ -696,6 +722,29 @@ void multiplyByNPInvTranspose(const State& state, const Vector& fu,
 /**@}**/
 
 
+//------------------------------------------------------------------------------
+/**@name                      Mass matrix operators
+
+These methods are primarily for use by numerical integration methods, for 
+example to precondition the iteration matrix of an implicit method.
+
+Some Systems have a mass matrix M(q) relating generalized forces f to 
+generalized accelerations udot by M*udot = f, and can apply it and its 
+inverse in O(n) time. Those Systems return true from these methods. The 
+default is to have no mass matrix, in which case these methods return false
+and leave their output unchanged. The State must have been realized through
+Stage::Position. **/
+/**@{**/
+/** Calculate Ma=M*a. Returns false if this %System has no mass matrix. **/
+bool multiplyByM(const State& state, const Vector& a, Vector& Ma) const;
+/** Calculate x=(M+D)^-1*f where D is a diagonal matrix whose nu entries are 
+given in \a d and must be nonnegative; with \a d all zero this is M^-1*f. 
+Returns false if this %System has no mass matrix. **/
+bool multiplyByMPlusDInv(const State& state, const Vector& d, 
+                         const Vector& f, Vector& x) const;
+/**@}**/
+
+
 //------------------------------------------------------------------------------
 /**@name                         Statistics
 
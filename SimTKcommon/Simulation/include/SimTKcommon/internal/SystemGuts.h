@@ -147,6 +147,10 @@ public:
                          Vector& u) const;
     void multiplyByNPInvTranspose(const State& state, const Vector& fu, 
                                   Vector& fq) const;
+    bool multiplyByM(const State& state, const Vector& a, 
+                     Vector& Ma) const;
+    bool multiplyByMPlusDInv(const State& state, const Vector& d,
+                             const Vector& f, Vector& x) const;
 
     bool prescribeQ(State&) const;
     bool prescribeU(State&) const;
@@ -254,6 +258,16 @@ protected:
             freeUs[i] = SystemUIndex(i);
     }
 
+    // New virtual methods go here at the end so that the VFT ordering of 
+    // the ones above doesn't change; see the layout notes at the top.
+
+    // Defaults assume there is no mass matrix; hence, no output.
+    virtual bool multiplyByMImpl(const State& state, const Vector& a, 
+                                 Vector& Ma) const {return false;}
+    virtual bool multiplyByMPlusDInvImpl(const State& state, const Vector& d,
+                                         const Vector& f, Vector& x) const
+    {   return false; }
+
 private:
     Guts& operator=(const Guts&); // suppress default copy assignment operator
 
@@ -222,6 +222,26 @@ void PerSubsystemInfo::copyAllocationStackThroughStage
         stack[i].deepAssign(src[i]);
 }
 
+// Return true if the entries of these two allocation stacks that were made
+// through Instance stage are identical. Later entries are ignored since they
+// would not be copied anyway.
+template <class T>
+bool PerSubsystemInfo::isSameAllocationStack
+   (const Array_<T>& stack, const Array_<T>& src) 
+{
+    unsigned n = stack.size(), nsrc = src.size();
+    while (n && stack[n-1].getAllocationStage() > Stage::Instance)
+        --n;
+    while (nsrc && src[nsrc-1].getAllocationStage() > Stage::Instance)
+        --nsrc;
+    if (n != nsrc)
+        return false;
+    for (unsigned i=0; i < n; ++i)
+        if (!stack[i].isSameAllocationAs(src[i]))
+            return false;
+    return true;
+}
+
 void PerSubsystemInfo::clearContinuousVars() {
     clearAllocationStack(q_info); 
     clearAllocationStack(uInfo);                                
@@ -348,6 +368,67 @@ void PerSubsystemInfo::restoreToStage(Stage g) {
     currentStage = g;
 }
 
+bool PerSubsystemInfo::hasSameAllocationsAs(const PerSubsystemInfo& src) const {
+    if (currentStage < Stage::Instance || src.currentStage < Stage::Instance)
+        return false;
+    if (name != src.name || version != src.version)
+        return false;
+
+    if (!(   isSameAllocationStack(q_info, src.q_info)
+          && isSameAllocationStack(uInfo,  src.uInfo)
+          && isSameAllocationStack(zInfo,  src.zInfo)
+          && isSameAllocationStack(discreteInfo, src.discreteInfo)
+          && isSameAllocationStack(qerrInfo,    src.qerrInfo)
+          && isSameAllocationStack(uerrInfo,    src.uerrInfo)
+          && isSameAllocationStack(udoterrInfo, src.udoterrInfo)
+          && isSameAllocationStack(cacheInfo,   src.cacheInfo)))
+        return false;
+    for (int i=0; i < Stage::NValid; ++i)
+        if (!isSameAllocationStack(triggerInfo[i], src.triggerInfo[i]))
+            return false;
+    return true;
+}
+
+// Caller must have checked hasSameAllocationsAs(src) first.
+void PerSubsystemInfo::copyValuesFrom(const PerSubsystemInfo& src) {
+    assert(hasSameAllocationsAs(src));
+
+    // Forget anything allocated or computed past Instance stage. The global
+    // resource views stay valid since the global layout is unchanged.
+    restoreToStage(Stage::Instance);
+
+    // These are small descriptors; assignment reuses existing space.
+    for (unsigned i=0; i < q_info.size(); ++i) q_info[i].deepAssign(src.q_info[i]);
+    for (unsigned i=0; i < uInfo.size();  ++i) uInfo[i].deepAssign(src.uInfo[i]);
+    for (unsigned i=0; i < zInfo.size();  ++i) zInfo[i].deepAssign(src.zInfo[i]);
+    for (unsigned i=0; i < qerrInfo.size(); ++i) 
+        qerrInfo[i].deepAssign(src.qerrInfo[i]);
+    for (unsigned i=0; i < uerrInfo.size(); ++i) 
+        uerrInfo[i].deepAssign(src.uerrInfo[i]);
+    for (unsigned i=0; i < udoterrInfo.size(); ++i) 
+        udoterrInfo[i].deepAssign(src.udoterrInfo[i]);
+    for (int g=0; g < Stage::NValid; ++g)
+        for (unsigned i=0; i < triggerInfo[g].size(); ++i)
+            triggerInfo[g][i].deepAssign(src.triggerInfo[g][i]);
+
+    // Discrete variables and cache entries keep their value objects and their
+    // registrations with prerequisites and dependents.
+    for (unsigned i=0; i < discreteInfo.size(); ++i)
+        discreteInfo[i].copyValueFrom(src.discreteInfo[i]);
+    for (unsigned i=0; i < cacheInfo.size(); ++i)
+        cacheInfo[i].copyValueFrom(src.cacheInfo[i]);
+
+    // Same stage versions as copyFrom(src,Instance) through Instance stage. 
+    // Later stages must not match any version recorded either here or in the
+    // source.
+    for (int i=0; i <= Stage::Instance; ++i)
+        stageVersions[i] = src.stageVersions[i];
+    for (int i=Stage::Instance+1; i < Stage::NValid; ++i)
+        stageVersions[i] = std::max(stageVersions[i], src.stageVersions[i]) + 1;
+
+    currentStage = Stage::Instance;
+}
+
 void PerSubsystemInfo::copyFrom(const PerSubsystemInfo& src, Stage maxStage) {
     const Stage targetStage = std::min<Stage>(src.currentStage, maxStage);
 
@@ -428,6 +509,57 @@ void StateImpl::copyFrom(const StateImpl& src) {
     registerWithPrerequisitesAfterCopy();
 }
 
+//------------------------------------------------------------------------------
+//                          COPY IN PLACE FROM
+//------------------------------------------------------------------------------
+bool StateImpl::canCopyInPlaceFrom(const StateImpl& src) const {
+    if (currentSystemStage < Stage::Instance 
+        || src.currentSystemStage < Stage::Instance)
+        return false;
+    if (subsystems.size() != src.subsystems.size())
+        return false;
+    if (   y.size() != src.y.size() || yerr.size() != src.yerr.size()
+        || udoterr.size() != src.udoterr.size() 
+        || allTriggers.size() != src.allTriggers.size())
+        return false;
+    for (SubsystemIndex i(0); i < (int)subsystems.size(); ++i)
+        if (!subsystems[i].hasSameAllocationsAs(src.subsystems[i]))
+            return false;
+    return true;
+}
+
+// Produces the same result as invalidating everything and then calling
+// copyFrom(src), but nothing is freed or reallocated. Dependency lists are
+// already correct since every cache entry has the same prerequisites as 
+// the corresponding one in the source.
+void StateImpl::copyInPlaceFrom(const StateImpl& src) {
+    assert(canCopyInPlaceFrom(src));
+
+    // Forget everything past Instance stage; this does not touch any of the
+    // Model- or Instance-stage global resources.
+    if (currentSystemStage > Stage::Instance)
+        invalidateJustSystemStage(Stage::Time);
+
+    for (SubsystemIndex i(0); i < (int)subsystems.size(); ++i)
+        subsystems[i].copyValuesFrom(src.subsystems[i]);
+
+    t = src.t;
+    y = src.y; // same size; no reallocation
+    qVersion = src.qVersion; 
+    uVersion = src.uVersion; 
+    zVersion = src.zVersion;
+    uWeights = src.uWeights;
+    zWeights = src.zWeights;
+    qerrWeights = src.qerrWeights;
+    uerrWeights = src.uerrWeights;
+
+    for (int i=1; i <= Stage::Instance; ++i)
+        systemStageVersions[i] = src.systemStageVersions[i];
+    for (int i=Stage::Instance+1; i < Stage::NValid; ++i)
+        systemStageVersions[i] = 
+            std::max(systemStageVersions[i], src.systemStageVersions[i]) + 1;
+}
+
 //------------------------------------------------------------------------------
 //                           COPY CONSTRUCTOR
 //------------------------------------------------------------------------------
@@ -441,6 +573,12 @@ StateImpl::StateImpl(const StateImpl& src) : StateImpl() {
 StateImpl& StateImpl::operator=(const StateImpl& src) {
     if (&src == this) return *this;
 
+    // Reuse this State's memory if it already has the source's layout.
+    if (canCopyInPlaceFrom(src)) {
+        copyInPlaceFrom(src);
+        return *this;
+    }
+
     // Make sure no stage is valid.
     invalidateJustSystemStage(Stage::Topology);
     for (SubsystemIndex i(0); i<(int)subsystems.size(); ++i)
@@ -0,0 +1,75 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon/internal/StatePool.h"
+
+namespace SimTK {
+
+StatePool::StatePool(const State& prototype, int numPreallocated)
+:   m_prototype(prototype) {
+    SimTK_APIARGCHECK1_ALWAYS(numPreallocated >= 0, "StatePool", "StatePool",
+        "Number of preallocated States must be nonnegative but was %d.",
+        numPreallocated);
+    m_free.reserve(numPreallocated);
+    for (int i=0; i < numPreallocated; ++i)
+        m_free.emplace_back(new State(m_prototype));
+}
+
+std::unique_ptr<State> StatePool::takeFree() {
+    std::lock_guard<std::mutex> lock(m_freeLock);
+    if (m_free.empty())
+        return nullptr;
+    std::unique_ptr<State> state = std::move(m_free.back());
+    m_free.pop_back();
+    return state;
+}
+
+std::unique_ptr<State> StatePool::acquire() {
+    return acquire(m_prototype);
+}
+
+std::unique_ptr<State> StatePool::acquire(const State& source) {
+    std::unique_ptr<State> state = takeFree();
+    if (state) *state = source; // in place when allocations match
+    else state.reset(new State(source));
+    return state;
+}
+
+void StatePool::release(std::unique_ptr<State> state) {
+    if (!state) return;
+    std::lock_guard<std::mutex> lock(m_freeLock);
+    m_free.push_back(std::move(state));
+}
+
+int StatePool::getNumAvailable() const {
+    std::lock_guard<std::mutex> lock(m_freeLock);
+    return (int)m_free.size();
+}
+
+void StatePool::clear() {
+    std::vector<std::unique_ptr<State>> discard;
+    {   std::lock_guard<std::mutex> lock(m_freeLock);
+        discard.swap(m_free); }
+}
+
+} // namespace SimTK
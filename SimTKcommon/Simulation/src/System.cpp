@@ -39,8 +39,12 @@
 
 #include "SystemGutsRep.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <map>
+#include <mutex>
 #include <set>
 
 namespace SimTK {
@@ -169,6 +173,13 @@ void System::invalidateSystemTopologyCache() const
 const State& System::realizeTopology() const {return getSystemGuts().realizeTopology();}
 void System::realizeModel(State& s) const {getSystemGuts().realizeModel(s);}
 void System::realize(const State& s, Stage g) const {getSystemGuts().realize(s,g);}
+
+void System::realizeBatch(const ArrayViewConst_<State>& states, Stage g) const {
+    Array_<const State*> statePtrs(states.size());
+    for (unsigned i=0; i < states.size(); ++i)
+        statePtrs[i] = &states[i];
+    realizeBatch(statePtrs, g);
+}
 void System::calcDecorativeGeometryAndAppend
    (const State& s, Stage g, Array_<DecorativeGeometry>& geom) const 
 {   getSystemGuts().calcDecorativeGeometryAndAppend(s,g,geom); }
@@ -181,6 +192,11 @@ void System::multiplyByNPInv(const State& s, const Vector& dq, Vector& u) const
 {   getSystemGuts().multiplyByNPInv(s,dq,u); }
 void System::multiplyByNPInvTranspose(const State& s, const Vector& fu, Vector& fq) const
 {   getSystemGuts().multiplyByNPInvTranspose(s,fu,fq); }
+bool System::multiplyByM(const State& s, const Vector& a, Vector& Ma) const
+{   return getSystemGuts().multiplyByM(s,a,Ma); }
+bool System::multiplyByMPlusDInv(const State& s, const Vector& d, 
+                                 const Vector& f, Vector& x) const
+{   return getSystemGuts().multiplyByMPlusDInv(s,d,f,x); }
 
 bool System::prescribeQ(State& s) const
 {   return getSystemGuts().prescribeQ(s); }
@@ -591,6 +607,25 @@ void System::Guts::multiplyByNPInvTranspose(const State& s, const Vector& fu,
 
 
 
+//------------------------------------------------------------------------------
+//                       MULTIPLY BY M, (M+D)^-1
+//------------------------------------------------------------------------------
+
+bool System::Guts::multiplyByM(const State& s, const Vector& a, 
+                               Vector& Ma) const {
+    SimTK_STAGECHECK_GE(s.getSystemStage(), Stage::Position,
+        "System::Guts::multiplyByM()");
+    return multiplyByMImpl(s,a,Ma);
+}
+bool System::Guts::multiplyByMPlusDInv(const State& s, const Vector& d,
+                                       const Vector& f, Vector& x) const {
+    SimTK_STAGECHECK_GE(s.getSystemStage(), Stage::Position,
+        "System::Guts::multiplyByMPlusDInv()");
+    return multiplyByMPlusDInvImpl(s,d,f,x);
+}
+
+
+
 //------------------------------------------------------------------------------
 //                              PRESCRIBE Q
 //------------------------------------------------------------------------------
@@ -791,6 +826,69 @@ void System::Guts::realize(const State& s, Stage g) const {
     }
 }
 
+//------------------------------------------------------------------------------
+//                              REALIZE BATCH
+//------------------------------------------------------------------------------
+namespace {
+// This is the ParallelExecutor Task used by System::realizeBatch(). Each
+// thread repeatedly claims the next unrealized State, so that threads that
+// get cheap States don't sit idle. Exceptions are caught and saved with the
+// State that caused them since ParallelExecutor would otherwise swallow them.
+class RealizeBatchTask : public ParallelExecutor::Task {
+public:
+    RealizeBatchTask(const System::Guts&                 guts,
+                     const ArrayViewConst_<const State*>& states,
+                     Stage                                stage)
+    :   guts(guts), states(states), stage(stage), nextState(0),
+        errors(states.size()) {}
+
+    void execute(int) override {
+        const int nStates = (int)states.size();
+        int i;
+        while ((i = nextState++) < nStates) {
+            try {guts.realize(*states[i], stage);}
+            catch (...) {errors[i] = std::current_exception();}
+        }
+    }
+
+    void rethrowAnyError() const {
+        for (const std::exception_ptr& error : errors)
+            if (error) std::rethrow_exception(error);
+    }
+private:
+    const System::Guts&                     guts;
+    const ArrayViewConst_<const State*>&    states;
+    const Stage                             stage;
+    std::atomic<int>                        nextState;
+    Array_<std::exception_ptr>              errors;
+};
+}
+
+void System::realizeBatch
+   (const ArrayViewConst_<const State*>& states, Stage g) const {
+    const System::Guts& guts = getSystemGuts();
+    const auto& rep = guts.getRep();
+    for (unsigned i=0; i < states.size(); ++i)
+        SimTK_APIARGCHECK1_ALWAYS(states[i] != nullptr, "System",
+            "realizeBatch", "State pointer %u was null.", i);
+
+    RealizeBatchTask task(guts, states, g);
+
+    // Don't wait for the executor if some other batch is using it.
+    if (states.size() < 2 || !rep.batchExecutorLock.try_lock()) {
+        task.execute(0);
+    } else {
+        std::lock_guard<std::mutex> 
+            guard(rep.batchExecutorLock, std::adopt_lock);
+        if (!rep.batchExecutor)
+            rep.batchExecutor.reset(new ParallelExecutor());
+        const int nThreads = 
+            std::min(rep.batchExecutor->getMaxThreads(), (int)states.size());
+        rep.batchExecutor->execute(task, nThreads);
+    }
+    task.rethrowAnyError();
+}
+
 //------------------------------------------------------------------------------
 //                   CALC DECORATIVE GEOMETRY AND APPEND
 //------------------------------------------------------------------------------
@@ -37,6 +37,11 @@
 
 #include "SimTKcommon/internal/System.h"
 #include "SimTKcommon/internal/SystemGuts.h"
+#include "SimTKcommon/internal/ParallelExecutor.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace SimTK {
 
@@ -199,20 +204,28 @@ private:
     // Topology version cannot be used with this Subsystem.
     mutable State           defaultState;
 
+    // BATCH REALIZATION //
+    // Threads for realizeBatch(), created the first time they are needed.
+    // The lock is held while the executor is in use.
+    mutable std::unique_ptr<ParallelExecutor>   batchExecutor;
+    mutable std::mutex                          batchExecutorLock;
+
         // STATISTICS //
-    mutable int nRealizationsOfStage[Stage::NValid];
-    mutable int nRealizeCalls; // counts realizeTopology(), realizeModel(), realize()
+    // These are atomic because different States may be realized 
+    // concurrently, e.g. by System::realizeBatch().
+    mutable std::atomic<int> nRealizationsOfStage[Stage::NValid];
+    mutable std::atomic<int> nRealizeCalls; // counts realizeTopology(), realizeModel(), realize()
 
-    mutable int nPrescribeQCalls, nPrescribeUCalls;
+    mutable std::atomic<int> nPrescribeQCalls, nPrescribeUCalls;
 
-    mutable int nProjectQCalls, nProjectUCalls;
-    mutable int nFailedProjectQCalls, nFailedProjectUCalls;
-    mutable int nQProjections, nUProjections; // the ones that did something
-    mutable int nQErrEstProjections, nUErrEstProjections;
+    mutable std::atomic<int> nProjectQCalls, nProjectUCalls;
+    mutable std::atomic<int> nFailedProjectQCalls, nFailedProjectUCalls;
+    mutable std::atomic<int> nQProjections, nUProjections; // the ones that did something
+    mutable std::atomic<int> nQErrEstProjections, nUErrEstProjections;
 
-    mutable int nHandlerCallsThatChangedStage[Stage::NValid];
-    mutable int nHandleEventsCalls;
-    mutable int nReportEventsCalls;
+    mutable std::atomic<int> nHandlerCallsThatChangedStage[Stage::NValid];
+    mutable std::atomic<int> nHandleEventsCalls;
+    mutable std::atomic<int> nReportEventsCalls;
 
     void resetAllCounters() {
         for (int i=0; i<Stage::NValid; ++i)
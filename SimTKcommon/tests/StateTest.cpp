@@ -518,6 +518,120 @@ void testConsistent() {
 
 }
 
+// Build a two-subsystem State with a little of everything, realized through
+// Instance stage.
+void buildStateForCopy(State& s, DiscreteVariableIndex& dvx,
+                       CacheEntryIndex& cxPlain, CacheEntryIndex& cxPrereq) {
+    const SubsystemIndex Sub0(0), Sub1(1);
+    s.setNumSubsystems(2);
+    s.allocateQ(Sub0, Vector(3, Real(1)));
+    s.allocateZ(Sub1, Vector(2, Real(2)));
+    dvx = s.allocateDiscreteVariable(Sub0, Stage::Position, 
+                                     new Value<Vector>(Vector(4, Real(3))));
+    cxPlain = s.allocateCacheEntry(Sub1, Stage::Instance, Stage::Infinity,
+                                   new Value<Vector>(Vector(5, Real(0))));
+    advanceStage(s, Stage::Topology);
+    advanceStage(s, Stage::Model);
+    cxPrereq = s.allocateCacheEntryWithPrerequisites(Sub1, Stage::Instance, 
+        Stage::Infinity, false, false, true, // depends on z
+        {DiscreteVarKey(Sub0,dvx)}, {}, new Value<String>("initial"));
+    s.allocateEventTrigger(Sub0, Stage::Position, 2);
+    advanceStage(s, Stage::Instance);
+}
+
+void testCopyInPlace() {
+    const SubsystemIndex Sub0(0), Sub1(1);
+    DiscreteVariableIndex dvx; CacheEntryIndex cxPlain, cxPrereq;
+    State sA; buildStateForCopy(sA, dvx, cxPlain, cxPrereq);
+    State sB(sA); // ordinary copy
+    SimTK_TEST(sB.getSystemStage() == Stage::Instance);
+
+    // Change everything in the source and realize further.
+    sA.updQ() = Vector(3, Real(7)); sA.updZ() = Vector(2, Real(8));
+    sA.updTime() = 1.5;
+    Value<Vector>::updDowncast(sA.updDiscreteVariable(Sub0,dvx)).upd() = 
+        Vector(4, Real(9));
+    advanceStage(sA, Stage::Time);
+    Value<Vector>::updDowncast(sA.updCacheEntry(Sub1,cxPlain)).upd() = 
+        Vector(5, Real(10));
+    sA.markCacheValueRealized(Sub1, cxPlain);
+    Value<String>::updDowncast(sA.updCacheEntry(Sub1,cxPrereq)).upd() = "A";
+    sA.markCacheValueRealized(Sub1, cxPrereq);
+
+    // Remember where the destination's values live.
+    const Real* dvData = &Value<Vector>::downcast
+        (sB.getDiscreteVariable(Sub0,dvx)).get()[0];
+    const Real* ceData = &Value<Vector>::downcast
+        (sB.updCacheEntry(Sub1,cxPlain)).get()[0];
+    const Real* yData = &sB.getY()[0];
+
+    sB = sA; // should be done in place
+    State sC(sA); // reference result
+
+    SimTK_TEST(&Value<Vector>::downcast
+        (sB.getDiscreteVariable(Sub0,dvx)).get()[0] == dvData);
+    SimTK_TEST(&Value<Vector>::downcast
+        (sB.getCacheEntry(Sub1,cxPlain)).get()[0] == ceData);
+    SimTK_TEST(&sB.getY()[0] == yData);
+
+    for (const State* sp : {&sB, &sC}) {
+        const State& s = *sp;
+        SimTK_TEST(s.getSystemStage() == Stage::Instance);
+        SimTK_TEST(s.getTime() == 1.5);
+        SimTK_TEST_EQ(s.getY(), sA.getY());
+        SimTK_TEST_EQ(Value<Vector>::downcast
+            (s.getDiscreteVariable(Sub0,dvx)).get(), Vector(4, Real(9)));
+        SimTK_TEST(s.isCacheValueRealized(Sub1,cxPlain));
+        SimTK_TEST_EQ(Value<Vector>::downcast
+            (s.getCacheEntry(Sub1,cxPlain)).get(), Vector(5, Real(10)));
+        // An entry with prerequisites must be recomputed after a copy.
+        SimTK_TEST(!s.isCacheValueRealized(Sub1,cxPrereq));
+    }
+
+    // Dependencies must still work in the in-place copy.
+    sB.markCacheValueRealized(Sub1, cxPrereq);
+    SimTK_TEST(sB.isCacheValueRealized(Sub1,cxPrereq));
+    sB.updZ()[0] = 99;
+    SimTK_TEST(!sB.isCacheValueRealized(Sub1,cxPrereq));
+    sB.markCacheValueRealized(Sub1, cxPrereq);
+    Value<Vector>::updDowncast(sB.updDiscreteVariable(Sub0,dvx)).upd()[0] = 1;
+    SimTK_TEST(!sB.isCacheValueRealized(Sub1,cxPrereq));
+    SimTK_TEST_EQ(Value<Vector>::downcast
+        (sA.getDiscreteVariable(Sub0,dvx)).get(), Vector(4, Real(9)));
+
+    // A State with a different layout is copied the ordinary way.
+    State sD; sD.setNumSubsystems(2);
+    sD.allocateQ(Sub0, Vector(6));
+    for (Stage g=Stage::Topology; g <= Stage::Instance; ++g)
+        advanceStage(sD, g);
+    sD = sA;
+    SimTK_TEST(sD.getNQ() == 3);
+    SimTK_TEST_EQ(sD.getY(), sA.getY());
+    SimTK_TEST(sD.isCacheValueRealized(Sub1,cxPlain));
+
+    // Pooled States are reset from the prototype or another State.
+    StatePool pool(sA, 2);
+    SimTK_TEST(pool.getNumAvailable() == 2);
+    std::unique_ptr<State> p1 = pool.acquire();
+    std::unique_ptr<State> p2 = pool.acquire();
+    std::unique_ptr<State> p3 = pool.acquire(sB);
+    SimTK_TEST(pool.getNumAvailable() == 0);
+    SimTK_TEST_EQ(p1->getY(), sA.getY());
+    SimTK_TEST_EQ(p3->getY(), sB.getY());
+    p1->updQ()[0] = -1;
+    const State* p1Address = p1.get();
+    pool.release(std::move(p2));
+    pool.release(std::move(p1));
+    pool.release(nullptr);
+    SimTK_TEST(pool.getNumAvailable() == 2);
+    std::unique_ptr<State> p4 = pool.acquire();
+    SimTK_TEST(p4.get() == p1Address); // most recently released
+    SimTK_TEST_EQ(p4->getY(), sA.getY());
+    SimTK_TEST_EQ(pool.getPrototype().getY(), sA.getY());
+    pool.clear();
+    SimTK_TEST(pool.getNumAvailable() == 0);
+}
+
 int main() {
     int major,minor,build;
     char out[100];
@@ -537,5 +651,6 @@ int main() {
         SimTK_SUBTEST(testCacheValidity);
         SimTK_SUBTEST(testMisc);
         SimTK_SUBTEST(testConsistent);
+        SimTK_SUBTEST(testCopyInPlace);
     SimTK_END_TEST();
 }
@@ -386,6 +386,25 @@ public:
     at their contact points without overlap. **/
     Real getDepth() const;
 
+    /** Record the contact points that were found on each surface, each
+    measured and expressed in its own surface's frame, and how many Newton 
+    iterations it took to find them. A tracker that is handed this Contact as 
+    the prior status of the same surface pair on a later step can start its
+    search from these points rather than from scratch. **/
+    void setWitnessPoints(const Vec3& point1_S1, const Vec3& point2_S2,
+                          int numIterations);
+    /** Return true if setWitnessPoints() was called for this Contact. **/
+    bool hasWitnessPoints() const;
+    /** Get the contact point on surface 1, in S1. Only valid if 
+    hasWitnessPoints() is true. **/
+    const Vec3& getWitnessPoint1() const;
+    /** Get the contact point on surface 2, in S2. Only valid if 
+    hasWitnessPoints() is true. **/
+    const Vec3& getWitnessPoint2() const;
+    /** Get the number of Newton iterations that were needed to find the 
+    witness points, or -1 if they weren't recorded. **/
+    int getNumIterations() const;
+
     /** Determine whether a Contact object is an EllipticalPointContact. **/
     static bool isInstance(const Contact& contact);
     static const EllipticalPointContact& getAs(const Contact& contact)
@@ -35,6 +35,7 @@ individual contact shapes. **/
 #include "simmath/internal/BicubicSurface.h"
 
 #include <cassert>
+#include <utility>
 
 namespace SimTK {
 
@@ -1267,6 +1268,33 @@ may return any of them.
 specified point. **/
 Vec3 findNearestPoint(const Vec3& position, bool& inside, int& face, Vec2& uv) const;
 
+/** Find the nearest point on the surface of this mesh to each of a batch of 
+points. The result is the same as calling findNearestPoint() for each point 
+(except perhaps for which of two equally near faces is reported), but a guess 
+at the nearest face can be supplied for each one. The guesses never change 
+the result: of several faces that are equally near within roundoff, the one 
+seen most nearly head-on is reported, and then the lowest numbered one. 
+Only the parts of
+the Oriented Bounding Box Tree that are closer than the guessed face are then
+searched, so a good guess, such as the face that was nearest the same point on 
+the previous time step, makes each query much cheaper. A bad guess only costs 
+one extra point-face distance calculation.
+@param positions     The points in question, in this mesh's frame.
+@param faces         On entry, the guessed nearest face for each point, or -1 
+                     for no guess; if this is empty no guesses are used. On 
+                     exit, the face containing each returned point, ready to
+                     be passed in again as guesses next time.
+@param nearestPoints On exit, the point on the surface of the mesh nearest 
+                     each of the given points.
+@param inside        On exit, inside[i] is true if positions[i] is inside 
+                     this mesh.
+@param normals       On exit, the surface normal at each returned point. **/
+void findNearestPoints(const ArrayViewConst_<Vec3>& positions, 
+                       Array_<int>&                 faces,
+                       Array_<Vec3>&                nearestPoints,
+                       Array_<bool>&                inside,
+                       Array_<UnitVec3>&            normals) const;
+
 /** Given a point and a face of this object, find the point of the face that is
 nearest the given point. If multiple points on the face are equally close to 
 the specified point, this may return any of them.
@@ -1309,6 +1337,34 @@ bool intersectsRay(const Vec3& origin, const UnitVec3& direction, Real& distance
 Box Tree. **/
 OBBTreeNode getOBBTreeNode() const;
 
+/** Find all pairs of faces, one from this mesh and one from \a otherMesh, that
+might intersect. This uses a second bounding volume hierarchy, made of 
+axis-aligned boxes with four children per node, which is much cheaper to 
+traverse than the Oriented Bounding Box Tree. Each mesh builds it the first 
+time it is needed here. The result is 
+conservative: every pair of intersecting faces is reported, but the reported 
+faces still need to be tested against each other.
+@param otherMesh  The mesh to test against this one; may be this mesh.
+@param X_MO       The pose of \a otherMesh's frame O in this mesh's frame M.
+@param facePairs  On exit, holds one entry (face of this mesh, face of 
+                  \a otherMesh) for each candidate pair. Any previous contents
+                  are discarded. **/
+void findCandidateFacePairs(const TriangleMesh& otherMesh, 
+                            const Transform& X_MO,
+                            Array_< std::pair<int,int> >& facePairs) const;
+
+/** Move the vertices of this mesh, keeping its faces and edges. Face normals 
+and areas, vertex normals, and the bounding sphere are recalculated, and both 
+bounding volume hierarchies are refit to the new positions bottom-up rather 
+than rebuilt, so the cost is linear in the size of the mesh. Use this for a 
+mesh that deforms or is rescaled during a simulation. The hierarchies keep the 
+structure they had when the mesh was created, so after very large deformations 
+queries slow down, though they remain correct; construct a new mesh if that 
+becomes a problem.
+@param positions  The new position of every vertex, in the same order as they
+                  were supplied when the mesh was created. **/
+void setVertexPositions(const ArrayViewConst_<Vec3>& positions);
+
 /** Generate a PolygonalMesh from this TriangleMesh; useful mostly for debugging
 because you can create a DecorativeMesh from this and then look at it. **/
 PolygonalMesh createPolygonalMesh() const;
@@ -69,6 +69,7 @@ class HalfSpaceConvexImplicit;
 class SphereSphere;
 class SphereTriangleMesh;
 class TriangleMeshTriangleMesh;
+class TriangleMeshTriangleMeshAABB;
 class ConvexImplicitPair;
 class GeneralImplicitPair;
 
@@ -354,6 +355,8 @@ bool trackContact
     Contact&               currentStatus) const override;
 
 private:
+friend class TriangleMeshTriangleMeshAABB;
+
 void findIntersectingFaces
    (const ContactGeometry::TriangleMesh&                mesh1, 
     const ContactGeometry::TriangleMesh&                mesh2,
@@ -378,6 +381,37 @@ void tagFaces(const ContactGeometry::TriangleMesh&   mesh,
 };
 
 
+
+//==============================================================================
+//          TRIANGLE MESH - TRIANGLE MESH CONTACT TRACKER USING AABBs
+//==============================================================================
+/** This ContactTracker finds the same contacts between two 
+ContactGeometry::TriangleMesh surfaces as TriangleMeshTriangleMesh does, but 
+finds the intersecting faces by traversing the meshes' axis-aligned bounding 
+box hierarchies (see ContactGeometry::TriangleMesh::findCandidateFacePairs())
+rather than their Oriented Bounding Box Trees. The boxes fit less tightly but 
+are much cheaper to test against one another. To use it, replace the default
+tracker:
+@code
+    tracker.adoptContactTracker
+       (new ContactTracker::TriangleMeshTriangleMeshAABB());
+@endcode **/
+class SimTK_SIMMATH_EXPORT ContactTracker::TriangleMeshTriangleMeshAABB
+:   public ContactTracker::TriangleMeshTriangleMesh {
+public:
+TriangleMeshTriangleMeshAABB() {}
+
+bool trackContact
+   (const Contact&         priorStatus,
+    const Transform& X_GS1, 
+    const ContactGeometry& surface1,    // mesh1
+    const Transform& X_GS2, 
+    const ContactGeometry& surface2,    // mesh2
+    Real                   cutoff,
+    Contact&               currentStatus) const override;
+};
+
+
 //==============================================================================
 //                 HALFSPACE-CONVEX IMPLICIT CONTACT TRACKER
 //==============================================================================
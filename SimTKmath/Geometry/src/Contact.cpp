@@ -64,8 +64,7 @@ Contact::Contact(const Contact& src) : impl(src.impl) {
 
 void Contact::clear() {
     if (impl) {
-        impl->m_referenceCount--;
-        if (impl->m_referenceCount == 0)
+        if (--impl->m_referenceCount == 0)
             delete impl;
         impl = 0;
     }
@@ -188,6 +187,23 @@ const Transform& EllipticalPointContact::getContactFrame() const
 Real EllipticalPointContact::getDepth() const
 {   return getImpl().depth; }
 
+void EllipticalPointContact::setWitnessPoints
+   (const Vec3& point1_S1, const Vec3& point2_S2, int numIterations) {
+    EllipticalPointContactImpl& impl = 
+        static_cast<EllipticalPointContactImpl&>(updImpl());
+    impl.witness1 = point1_S1;
+    impl.witness2 = point2_S2;
+    impl.numIterations = numIterations;
+}
+bool EllipticalPointContact::hasWitnessPoints() const
+{   return getImpl().numIterations >= 0; }
+const Vec3& EllipticalPointContact::getWitnessPoint1() const
+{   return getImpl().witness1; }
+const Vec3& EllipticalPointContact::getWitnessPoint2() const
+{   return getImpl().witness2; }
+int EllipticalPointContact::getNumIterations() const
+{   return getImpl().numIterations; }
+
 bool EllipticalPointContact::isInstance(const Contact& contact) {
     return (dynamic_cast<const EllipticalPointContactImpl*>
         (&contact.getImpl()) != 0);
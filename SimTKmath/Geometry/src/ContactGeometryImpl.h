@@ -33,6 +33,8 @@
 #include "simmath/internal/ContactGeometry.h"
 
 #include <limits>
+#include <mutex>
+#include <utility>
 
 namespace SimTK {
 
@@ -993,9 +995,105 @@ public:
     Vec3 findNearestPoint(const ContactGeometry::TriangleMesh::Impl& mesh, 
                           const Vec3& position, Real cutoff2, Real& distance2, 
                           int& face, Vec2& uv) const;
+    // Append to candidates (squared distance, face) every face whose distance
+    // to position is within cutoff2. Each face found lowers cutoff2 to its
+    // squared distance times (1+tol), so on return candidates holds every
+    // face within that tolerance of the nearest, plus perhaps some others.
+    void findNearbyFaces(const ContactGeometry::TriangleMesh::Impl& mesh, 
+                         const Vec3& position, Real tol, Real& cutoff2,
+                         Array_< std::pair<Real,int> >& candidates) const;
     bool intersectsRay(const ContactGeometry::TriangleMesh::Impl& mesh, 
                        const Vec3& origin, const UnitVec3& direction, 
                        Real& distance, int& face, Vec2& uv) const;
+    // Recompute the bounds of this node and its children after the mesh 
+    // vertices have moved, keeping the orientation of each box.
+    void refit(const ContactGeometry::TriangleMesh::Impl& mesh);
+};
+
+
+
+//==============================================================================
+//                          TRIANGLE MESH AABB TREE
+//==============================================================================
+// An axis-aligned bounding box hierarchy over the faces of a TriangleMesh, 
+// with up to four children per node. Each node stores the boxes of all its 
+// children packed as structure-of-arrays, so that a query box is tested 
+// against all four children in a single branch-free loop the compiler can 
+// vectorize. A child is either another node or a leaf holding a short run of 
+// faces from faceOrder. Nodes are stored in an array with every child placed 
+// after its parent, so after the mesh vertices move the bounds can be refit 
+// in a single backwards sweep without changing the tree topology. The owning
+// mesh builds the tree the first time it is needed, under buildLock, since
+// most meshes are never tested against another mesh.
+class TriangleMeshAABBTree {
+public:
+    enum {Width = 4, MaxLeafFaces = 4};
+
+    class Node {
+    public:
+        Real lo[3][Width], hi[3][Width]; // child boxes, indexed [axis][child]
+        int  child[Width];      // node index, or -1 if leaf or empty
+        int  firstFace[Width];  // start of a leaf's faces in faceOrder
+        int  numFaces[Width];   // 0 if internal or empty
+    };
+
+    TriangleMeshAABBTree() {}
+    // The lock is not copied; each tree has its own.
+    TriangleMeshAABBTree(const TriangleMeshAABBTree& src) {*this = src;}
+    TriangleMeshAABBTree& operator=(const TriangleMeshAABBTree& src) {
+        if (&src != this) {
+            nodes = src.nodes; faceOrder = src.faceOrder;
+            rootLo = src.rootLo; rootHi = src.rootHi;
+        }
+        return *this;
+    }
+
+    bool isBuilt() const {return !nodes.empty();}
+    std::mutex& getBuildLock() const {return buildLock;}
+
+    // Build the hierarchy topology and its bounds.
+    void build(const ContactGeometry::TriangleMesh::Impl& mesh);
+    // Recompute all the bounds bottom-up from the current vertex positions.
+    void refit(const ContactGeometry::TriangleMesh::Impl& mesh);
+
+    // Append to facePairs every pair (f, g) of a face f of this mesh and a 
+    // face g of the other mesh whose leaf boxes overlap. The other mesh's 
+    // boxes are carried into this mesh's frame M by X_MO, which makes them 
+    // somewhat looser but keeps every box axis-aligned in M.
+    void findOverlappingFaces(const TriangleMeshAABBTree& other, 
+                              const Transform& X_MO,
+                              Array_< std::pair<int,int> >& facePairs) const;
+
+    const Vec3& getLowerBound() const {return rootLo;}
+    const Vec3& getUpperBound() const {return rootHi;}
+    int getNumNodes() const {return (int)nodes.size();}
+    const Node& getNode(int n) const {return nodes[n];}
+    const Array_<int>& getFaceOrder() const {return faceOrder;}
+private:
+    // A reference to a subtree; slot<0 means the whole node, otherwise the
+    // leaf in that slot of the node.
+    struct Ref {
+        Ref(int node, int slot) : node(node), slot(slot) {}
+        int node, slot;
+    };
+
+    int buildNode(const Array_<Vec3>& centroids, int begin, int end);
+    int splitRange(const Array_<Vec3>& centroids, int begin, int end);
+    Ref childRef(int node, int slot) const 
+    {   const Node& n = nodes[node];
+        return n.child[slot] >= 0 ? Ref(n.child[slot], -1) : Ref(node, slot); }
+    bool isEmptySlot(const Node& n, int slot) const
+    {   return n.child[slot] < 0 && n.numFaces[slot] == 0; }
+    void findOverlaps(const TriangleMeshAABBTree& other, const Mat33& R_MO, 
+                      const Mat33& absR_MO, const Vec3& p_MO, 
+                      const Ref& ref, const Ref& otherRef, 
+                      const Vec3& otherLo_M, const Vec3& otherHi_M,
+                      Array_< std::pair<int,int> >& facePairs) const;
+
+    Array_<Node>        nodes;
+    Array_<int>         faceOrder;
+    Vec3                rootLo, rootHi;
+    mutable std::mutex  buildLock;
 };
 
 
@@ -1024,7 +1122,16 @@ public:
     Vec3 findNearestPoint(const Vec3& position, bool& inside, int& face, 
                           Vec2& uv) const;
     Vec3 findNearestPointToFace(const Vec3& position, int face, Vec2& uv) const;
+    // candidates is just workspace, passed in so a batch of queries can 
+    // reuse it.
+    Vec3 findNearestPointFromGuess(const Vec3& position, int guessFace, 
+                                   bool& inside, int& face, Vec2& uv,
+                                   Array_< std::pair<Real,int> >& candidates) 
+                                   const;
     void createPolygonalMesh(PolygonalMesh& mesh) const;
+    void setVertexPositions(const ArrayViewConst_<Vec3>& positions);
+    // Return the AABB tree, building it first if this is its first use.
+    const TriangleMeshAABBTree& getAABBTree() const;
 
     DecorativeGeometry createDecorativeGeometry() const override;
     Vec3 findNearestPoint(const Vec3& position, bool& inside, 
@@ -1053,8 +1160,11 @@ private:
                       Array_<int>& child2Indices, int axis);
     void findBoundingSphere(Vec3* point[], int p, int b, 
                             Vec3& center, Real& radius);
+    void calcVertexNormals();
+    void calcBoundingSphere();
     friend class ContactGeometry::TriangleMesh;
     friend class OBBTreeNodeImpl;
+    friend class TriangleMeshAABBTree;
 
     Array_<Edge>    edges;
     Array_<Face>    faces;
@@ -1062,6 +1172,7 @@ private:
     Vec3            boundingSphereCenter;
     Real            boundingSphereRadius;
     OBBTreeNodeImpl obb;
+    mutable TriangleMeshAABBTree aabb; // built lazily; see getAABBTree()
     bool            smooth;
 };
 
@@ -30,6 +30,7 @@
 
 #include "ContactGeometryImpl.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <map>
@@ -171,6 +172,31 @@ Vec3 ContactGeometry::TriangleMesh::findNearestPointToFace
     return getImpl().findNearestPointToFace(position, face, uv);
 }
 
+void ContactGeometry::TriangleMesh::findNearestPoints
+   (const ArrayViewConst_<Vec3>& positions, Array_<int>& faces,
+    Array_<Vec3>& nearestPoints, Array_<bool>& inside, 
+    Array_<UnitVec3>& normals) const {
+    const Impl& impl = getImpl();
+    const int n = positions.size();
+    SimTK_APIARGCHECK2_ALWAYS(faces.empty() || (int)faces.size() == n,
+        "ContactGeometry::TriangleMesh", "findNearestPoints",
+        "Got %d guessed faces for %d points.", (int)faces.size(), n);
+    if (faces.empty())
+        faces.resize(n, -1);
+    nearestPoints.resize(n);
+    inside.resize(n);
+    normals.resize(n);
+    Array_< std::pair<Real,int> > candidates;
+    for (int i = 0; i < n; ++i) {
+        bool isInside;
+        Vec2 uv;
+        nearestPoints[i] = impl.findNearestPointFromGuess
+           (positions[i], faces[i], isInside, faces[i], uv, candidates);
+        inside[i]  = isInside;
+        normals[i] = impl.findNormalAtPoint(faces[i], uv);
+    }
+}
+
 bool ContactGeometry::TriangleMesh::intersectsRay
    (const Vec3& origin, const UnitVec3& direction, Real& distance, 
     UnitVec3& normal) const {
@@ -188,6 +214,19 @@ ContactGeometry::TriangleMesh::getOBBTreeNode() const {
     return OBBTreeNode(getImpl().obb);
 }
 
+void ContactGeometry::TriangleMesh::findCandidateFacePairs
+   (const TriangleMesh& otherMesh, const Transform& X_MO,
+    Array_< std::pair<int,int> >& facePairs) const {
+    facePairs.clear();
+    getImpl().getAABBTree().findOverlappingFaces
+       (otherMesh.getImpl().getAABBTree(), X_MO, facePairs);
+}
+
+void ContactGeometry::TriangleMesh::
+setVertexPositions(const ArrayViewConst_<Vec3>& positions) {
+    updImpl().setVertexPositions(positions);
+}
+
 PolygonalMesh ContactGeometry::TriangleMesh::createPolygonalMesh() const {
     PolygonalMesh mesh;
     getImpl().createPolygonalMesh(mesh);
@@ -263,6 +302,59 @@ findNearestPoint(const Vec3& position, bool& inside, int& face, Vec2& uv) const
     return nearestPoint;
 }
 
+// The distance to the guessed face bounds the search: any subtree whose box is
+// farther away than that can't hold a nearer face. The guess must not affect
+// the answer, so rather than preferring whichever face was seen first, every 
+// face within a small tolerance of the nearest is collected and the choice 
+// among them is made canonically: the face seen most nearly head-on (as in 
+// OBBTreeNodeImpl) and then the lowest numbered one.
+Vec3 ContactGeometry::TriangleMesh::Impl::
+findNearestPointFromGuess(const Vec3& position, int guessFace, bool& inside, 
+                          int& face, Vec2& uv, 
+                          Array_< std::pair<Real,int> >& candidates) const 
+{
+    const Real tol = 100*Eps;
+    Real cutoff2 = MostPositiveReal;
+    if (guessFace >= 0 && guessFace < (int)faces.size()) {
+        Vec2 guessUV;
+        const Vec3 guessPoint = 
+            findNearestPointToFace(position, guessFace, guessUV);
+        cutoff2 = (guessPoint-position).normSqr()*(1+tol) + Real(1e-300);
+    }
+
+    candidates.clear();
+    obb.findNearbyFaces(*this, position, tol, cutoff2, candidates);
+    if (candidates.empty()) // the guess's box was missed by roundoff
+        return findNearestPointFromGuess(position, -1, inside, face, uv, 
+                                         candidates);
+
+    Real distance2 = MostPositiveReal;
+    for (unsigned i=0; i < candidates.size(); ++i)
+        distance2 = std::min(distance2, candidates[i].first);
+
+    Vec3 nearestPoint;
+    Real bestAlignment = -1;
+    face = -1;
+    for (unsigned i=0; i < candidates.size(); ++i) {
+        const int candidate = candidates[i].second;
+        if (candidates[i].first > distance2*(1+tol))
+            continue;
+        Vec2 candidateUV;
+        const Vec3 p = findNearestPointToFace(position, candidate, candidateUV);
+        const Real alignment = 
+            std::abs(~(p-position)*faces[candidate].normal);
+        if (   alignment > bestAlignment 
+            || (alignment == bestAlignment && candidate < face)) {
+            nearestPoint = p;
+            bestAlignment = alignment;
+            face = candidate;
+            uv = candidateUV;
+        }
+    }
+    inside = (~(position-nearestPoint)*faces[face].normal < 0);
+    return nearestPoint;
+}
+
 bool ContactGeometry::TriangleMesh::Impl::
 intersectsRay(const Vec3& origin, const UnitVec3& direction, Real& distance, 
               UnitVec3& normal) const {
@@ -289,6 +381,46 @@ getBoundingSphere(Vec3& center, Real& radius) const {
     radius = boundingSphereRadius;
 }
 
+void ContactGeometry::TriangleMesh::Impl::
+setVertexPositions(const ArrayViewConst_<Vec3>& positions) {
+    SimTK_APIARGCHECK2_ALWAYS(positions.size() == vertices.size(),
+        "ContactGeometry::TriangleMesh", "setVertexPositions",
+        "Got %d vertex positions but the mesh has %d vertices.",
+        (int)positions.size(), (int)vertices.size());
+    for (int i = 0; i < (int) vertices.size(); i++)
+        vertices[i].pos = positions[i];
+
+    // Face winding was fixed at construction, so the new normals still point
+    // outward as long as the mesh hasn't been turned inside out.
+    for (int i = 0; i < (int) faces.size(); i++) {
+        Face& f = faces[i];
+        Vec3 cross =   (vertices[f.vertices[1]].pos-vertices[f.vertices[0]].pos)
+                     % (vertices[f.vertices[2]].pos-vertices[f.vertices[0]].pos);
+        const Real norm = cross.norm();
+        SimTK_APIARGCHECK1_ALWAYS(norm > 0, 
+            "ContactGeometry::TriangleMesh", "setVertexPositions",
+            "Face %d is degenerate.", i);
+        f.normal = UnitVec3(cross/norm, true);
+        f.area = norm/2;
+    }
+    calcVertexNormals();
+
+    // Refit rather than rebuild the hierarchies. There is nothing to refit 
+    // if the AABB tree hasn't been needed yet.
+    obb.refit(*this);
+    if (aabb.isBuilt())
+        aabb.refit(*this);
+    calcBoundingSphere();
+}
+
+const TriangleMeshAABBTree& ContactGeometry::TriangleMesh::Impl::
+getAABBTree() const {
+    std::lock_guard<std::mutex> lock(aabb.getBuildLock());
+    if (!aabb.isBuilt())
+        aabb.build(*this);
+    return aabb;
+}
+
 void ContactGeometry::TriangleMesh::Impl::
 createPolygonalMesh(PolygonalMesh& mesh) const {
     for (unsigned vx=0; vx < vertices.size(); ++vx)
@@ -511,8 +643,21 @@ void ContactGeometry::TriangleMesh::Impl::init
             "ContactGeometry::TriangleMesh::Impl", "TriangleMesh::Impl",
             "Vertex %d is not part of any face.", i);
     
-    // Calculate a normal for each vertex.
+    calcVertexNormals();
+    
+    // Create the OBBTree. The AABB tree waits until it is first needed.
+    
+    Array_<int> allFaces(faces.size());
+    for (int i = 0; i < (int) allFaces.size(); i++)
+        allFaces[i] = i;
+    createObbTree(obb, allFaces);
     
+    calcBoundingSphere();
+}
+
+// Calculate a normal for each vertex as the angle-weighted average of the
+// normals of the faces that share it.
+void ContactGeometry::TriangleMesh::Impl::calcVertexNormals() {
     Vector_<Vec3> vertNorm(vertices.size(), Vec3(0));
     for (int i = 0; i < (int) faces.size(); i++) {
         const Face& f = faces[i];
@@ -528,15 +673,9 @@ void ContactGeometry::TriangleMesh::Impl::init
     }
     for (int i = 0; i < (int) vertices.size(); i++)
         vertices[i].normal = UnitVec3(vertNorm[i]);
-    
-    // Create the OBBTree.
-    
-    Array_<int> allFaces(faces.size());
-    for (int i = 0; i < (int) allFaces.size(); i++)
-        allFaces[i] = i;
-    createObbTree(obb, allFaces);
-    
-    // Find the bounding sphere.
+}
+
+void ContactGeometry::TriangleMesh::Impl::calcBoundingSphere() {
     Array_<const Vec3*> points(vertices.size());
     for (int i = 0; i < (int) vertices.size(); i++)
         points[i] = &vertices[i].pos;
@@ -823,7 +962,9 @@ Vec3 OBBTreeNodeImpl::findNearestPoint
                     child1point = child1->findNearestPoint(mesh, position, cutoff2, child1distance2, child1face, child1uv);
             }
         }
-        if (   child1distance2 <= child2distance2*(1+tol) 
+        // Both children may have been skipped if a cutoff was given.
+        if (   child1distance2 < MostPositiveReal
+            && child1distance2 <= child2distance2*(1+tol) 
             && child2distance2 <= child1distance2*(1+tol)) {
             // Decide based on angle which one to use.
             
@@ -866,6 +1007,43 @@ Vec3 OBBTreeNodeImpl::findNearestPoint
     return nearestPoint;
 }
 
+void OBBTreeNodeImpl::findNearbyFaces
+   (const ContactGeometry::TriangleMesh::Impl& mesh, 
+    const Vec3& position, Real tol, Real& cutoff2, 
+    Array_< std::pair<Real,int> >& candidates) const 
+{
+    if (child1 != NULL) {
+        // Check the nearer child first so the cutoff shrinks sooner.
+        const Real child1BoundsDist2 = 
+            (child1->bounds.findNearestPoint(position)-position).normSqr();
+        const Real child2BoundsDist2 = 
+            (child2->bounds.findNearestPoint(position)-position).normSqr();
+        const OBBTreeNodeImpl* nearer = child1;
+        const OBBTreeNodeImpl* farther = child2;
+        Real nearerDist2 = child1BoundsDist2, fartherDist2 = child2BoundsDist2;
+        if (child2BoundsDist2 < child1BoundsDist2) {
+            std::swap(nearer, farther);
+            std::swap(nearerDist2, fartherDist2);
+        }
+        if (nearerDist2 <= cutoff2)
+            nearer->findNearbyFaces(mesh, position, tol, cutoff2, candidates);
+        if (fartherDist2 <= cutoff2)
+            farther->findNearbyFaces(mesh, position, tol, cutoff2, candidates);
+        return;
+    }
+    // This is a leaf node, so check each triangle for its distance to the point.
+    for (int i = 0; i < (int) triangles.size(); i++) {
+        Vec2 triangleUV;
+        const Vec3 p = 
+            mesh.findNearestPointToFace(position, triangles[i], triangleUV);
+        const Real d2 = (p-position).normSqr();
+        if (d2 > cutoff2)
+            continue;
+        candidates.push_back(std::make_pair(d2, triangles[i]));
+        cutoff2 = std::min(cutoff2, d2*(1+tol));
+    }
+}
+
 bool OBBTreeNodeImpl::
 intersectsRay(const ContactGeometry::TriangleMesh::Impl& mesh,
               const Vec3& origin, const UnitVec3& direction, Real& distance, 
@@ -989,6 +1167,308 @@ intersectsRay(const ContactGeometry::TriangleMesh::Impl& mesh,
 
 
 
+// Grow the box [lo,hi], measured along the axes of R, to include point p.
+static void growBox(const Rotation& R, const Vec3& p, Vec3& lo, Vec3& hi) {
+    const Vec3 pR = ~R*p;
+    for (int j = 0; j < 3; j++) {
+        lo[j] = std::min(lo[j], pR[j]);
+        hi[j] = std::max(hi[j], pR[j]);
+    }
+}
+
+void OBBTreeNodeImpl::refit(const ContactGeometry::TriangleMesh::Impl& mesh) {
+    // Keep the axes chosen when the tree was built; only the extent along
+    // them changes.
+    const Rotation R = bounds.getTransform().R();
+    Vec3 lo(MostPositiveReal), hi(MostNegativeReal);
+    if (child1 != NULL) {
+        child1->refit(mesh);
+        child2->refit(mesh);
+        Vec3 corners[8];
+        child1->bounds.getCorners(corners);
+        for (int i = 0; i < 8; i++)
+            growBox(R, corners[i], lo, hi);
+        child2->bounds.getCorners(corners);
+        for (int i = 0; i < 8; i++)
+            growBox(R, corners[i], lo, hi);
+    }
+    else {
+        for (int i = 0; i < (int) triangles.size(); i++)
+            for (int j = 0; j < 3; j++)
+                growBox(R, mesh.vertices[mesh.faces[triangles[i]].vertices[j]].pos,
+                        lo, hi);
+    }
+
+    // Pad the box the same way OrientedBoundingBox does.
+    const Vec3 size = hi-lo;
+    Vec3 tol = Real(1e-5)*size;
+    for (int i = 0; i < 3; i++)
+        tol[i] = std::max(tol[i], Real(1e-10));
+    bounds = OrientedBoundingBox(Transform(R, R*(lo-tol)), size+2*tol);
+}
+
+
+
+//==============================================================================
+//                          TRIANGLE MESH AABB TREE
+//==============================================================================
+
+namespace {
+// Orders faces by one coordinate of their centroids.
+class CentroidLess {
+public:
+    CentroidLess(const Array_<Vec3>& centroids, int axis) 
+    :   centroids(centroids), axis(axis) {}
+    bool operator()(int f1, int f2) const 
+    {   return centroids[f1][axis] < centroids[f2][axis]; }
+private:
+    const Array_<Vec3>& centroids;
+    int                 axis;
+};
+}
+
+static bool boxesOverlap(const Vec3& lo1, const Vec3& hi1, 
+                         const Vec3& lo2, const Vec3& hi2) {
+    return lo1[0] <= hi2[0] && lo2[0] <= hi1[0]
+        && lo1[1] <= hi2[1] && lo2[1] <= hi1[1]
+        && lo1[2] <= hi2[2] && lo2[2] <= hi1[2];
+}
+
+// Test the box [lo,hi] against all the child boxes of a node at once. Bit k
+// of the result is set if the box overlaps child k. Empty children have 
+// inverted boxes and never overlap anything.
+static int findOverlappingChildren(const TriangleMeshAABBTree::Node& node,
+                                   const Vec3& lo, const Vec3& hi) {
+    const int Width = TriangleMeshAABBTree::Width;
+    int hit[Width];
+    for (int k = 0; k < Width; ++k)
+        hit[k] = int(node.lo[0][k] <= hi[0]) & int(lo[0] <= node.hi[0][k])
+               & int(node.lo[1][k] <= hi[1]) & int(lo[1] <= node.hi[1][k])
+               & int(node.lo[2][k] <= hi[2]) & int(lo[2] <= node.hi[2][k]);
+    int mask = 0;
+    for (int k = 0; k < Width; ++k)
+        mask |= hit[k] << k;
+    return mask;
+}
+
+// Carry the box [lo,hi] measured in frame O into frame M and return the
+// axis-aligned box in M that encloses it. absR_MO holds the absolute values
+// of the elements of R_MO.
+static void transformBox(const Mat33& R_MO, const Mat33& absR_MO, 
+                         const Vec3& p_MO, const Vec3& lo, const Vec3& hi,
+                         Vec3& lo_M, Vec3& hi_M) {
+    const Vec3 center = R_MO*((lo+hi)/2) + p_MO;
+    const Vec3 half = absR_MO*((hi-lo)/2);
+    lo_M = center-half;
+    hi_M = center+half;
+}
+
+void TriangleMeshAABBTree::
+build(const ContactGeometry::TriangleMesh::Impl& mesh) {
+    const int numFaces = mesh.faces.size();
+    Array_<Vec3> centroids(numFaces);
+    faceOrder.resize(numFaces);
+    for (int i = 0; i < numFaces; i++) {
+        centroids[i] = mesh.findCentroid(i);
+        faceOrder[i] = i;
+    }
+    nodes.clear();
+    buildNode(centroids, 0, numFaces);
+    refit(mesh);
+}
+
+// Create a node for faceOrder[begin,end) and, recursively, its children. The
+// node is appended before its children so every child follows its parent.
+int TriangleMeshAABBTree::
+buildNode(const Array_<Vec3>& centroids, int begin, int end) {
+    const int nodeIndex = nodes.size();
+    nodes.push_back(Node());
+
+    // Divide the faces into up to Width runs by repeatedly halving the 
+    // largest one; run k is faceOrder[start[k],start[k+1]).
+    int start[Width+1] = {begin, end};
+    int numRuns = 1;
+    while (numRuns < Width) {
+        int largest = 0;
+        for (int k = 1; k < numRuns; ++k)
+            if (start[k+1]-start[k] > start[largest+1]-start[largest])
+                largest = k;
+        if (start[largest+1]-start[largest] <= MaxLeafFaces)
+            break;
+        const int mid = splitRange(centroids, start[largest], start[largest+1]);
+        for (int k = numRuns; k > largest; --k)
+            start[k+1] = start[k];
+        start[largest+1] = mid;
+        ++numRuns;
+    }
+
+    for (int k = 0; k < Width; ++k) {
+        int child = -1, firstFace = 0, numFaces = 0;
+        if (k < numRuns) {
+            if (start[k+1]-start[k] <= MaxLeafFaces) {
+                firstFace = start[k];
+                numFaces = start[k+1]-start[k];
+            } else 
+                child = buildNode(centroids, start[k], start[k+1]);
+        }
+        // Don't hold a reference across the recursion; nodes may move.
+        Node& node = nodes[nodeIndex];
+        node.child[k] = child;
+        node.firstFace[k] = firstFace;
+        node.numFaces[k] = numFaces;
+    }
+    return nodeIndex;
+}
+
+// Partition faceOrder[begin,end) about the median centroid along the axis of
+// greatest centroid spread, and return the index of the split.
+int TriangleMeshAABBTree::
+splitRange(const Array_<Vec3>& centroids, int begin, int end) {
+    Vec3 lo(MostPositiveReal), hi(MostNegativeReal);
+    for (int i = begin; i < end; ++i) {
+        const Vec3& c = centroids[faceOrder[i]];
+        for (int j = 0; j < 3; ++j) {
+            lo[j] = std::min(lo[j], c[j]);
+            hi[j] = std::max(hi[j], c[j]);
+        }
+    }
+    const Vec3 spread = hi-lo;
+    const int axis = spread[0] > spread[1] ? (spread[0] > spread[2] ? 0 : 2)
+                                           : (spread[1] > spread[2] ? 1 : 2);
+    const int mid = begin + (end-begin)/2;
+    std::nth_element(faceOrder.begin()+begin, faceOrder.begin()+mid, 
+                     faceOrder.begin()+end, CentroidLess(centroids, axis));
+    return mid;
+}
+
+void TriangleMeshAABBTree::
+refit(const ContactGeometry::TriangleMesh::Impl& mesh) {
+    // Children always follow their parents, so sweeping backwards visits 
+    // every child before the node that holds it.
+    for (int n = (int)nodes.size()-1; n >= 0; --n) {
+        Node& node = nodes[n];
+        for (int k = 0; k < Width; ++k) {
+            Vec3 lo(MostPositiveReal), hi(MostNegativeReal);
+            if (node.child[k] >= 0) {
+                const Node& child = nodes[node.child[k]];
+                for (int i = 0; i < Width; ++i)
+                    for (int j = 0; j < 3; ++j) {
+                        lo[j] = std::min(lo[j], child.lo[j][i]);
+                        hi[j] = std::max(hi[j], child.hi[j][i]);
+                    }
+            } else {
+                const int end = node.firstFace[k] + node.numFaces[k];
+                for (int i = node.firstFace[k]; i < end; ++i) {
+                    const int* v = mesh.faces[faceOrder[i]].vertices;
+                    for (int m = 0; m < 3; ++m) {
+                        const Vec3& p = mesh.vertices[v[m]].pos;
+                        for (int j = 0; j < 3; ++j) {
+                            lo[j] = std::min(lo[j], p[j]);
+                            hi[j] = std::max(hi[j], p[j]);
+                        }
+                    }
+                }
+            }
+            for (int j = 0; j < 3; ++j) {
+                node.lo[j][k] = lo[j];
+                node.hi[j][k] = hi[j];
+            }
+        }
+    }
+
+    rootLo = Vec3(MostPositiveReal);
+    rootHi = Vec3(MostNegativeReal);
+    if (nodes.empty())
+        return;
+    for (int k = 0; k < Width; ++k)
+        for (int j = 0; j < 3; ++j) {
+            rootLo[j] = std::min(rootLo[j], nodes[0].lo[j][k]);
+            rootHi[j] = std::max(rootHi[j], nodes[0].hi[j][k]);
+        }
+}
+
+void TriangleMeshAABBTree::
+findOverlappingFaces(const TriangleMeshAABBTree& other, const Transform& X_MO,
+                     Array_< std::pair<int,int> >& facePairs) const {
+    if (nodes.empty() || other.nodes.empty() 
+        || other.rootLo[0] > other.rootHi[0])
+        return; // one of the meshes has no faces
+    const Mat33 R_MO = X_MO.R().asMat33();
+    Mat33 absR_MO;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            absR_MO(i,j) = std::abs(R_MO(i,j));
+    Vec3 lo_M, hi_M;
+    transformBox(R_MO, absR_MO, X_MO.p(), other.rootLo, other.rootHi, 
+                 lo_M, hi_M);
+    if (!boxesOverlap(rootLo, rootHi, lo_M, hi_M))
+        return;
+    findOverlaps(other, R_MO, absR_MO, X_MO.p(), Ref(0,-1), Ref(0,-1), 
+                 lo_M, hi_M, facePairs);
+}
+
+// The subtrees ref and otherRef are known to have overlapping boxes; 
+// otherLo_M and otherHi_M give otherRef's box in M. Descend whichever sides
+// are not leaves, both at once when possible.
+void TriangleMeshAABBTree::
+findOverlaps(const TriangleMeshAABBTree& other, const Mat33& R_MO, 
+             const Mat33& absR_MO, const Vec3& p_MO, 
+             const Ref& ref, const Ref& otherRef, 
+             const Vec3& otherLo_M, const Vec3& otherHi_M,
+             Array_< std::pair<int,int> >& facePairs) const {
+    const bool isLeaf = ref.slot >= 0, otherIsLeaf = otherRef.slot >= 0;
+    const Node& node = nodes[ref.node];
+    const Node& otherNode = other.nodes[otherRef.node];
+
+    if (isLeaf && otherIsLeaf) {
+        const int first = node.firstFace[ref.slot];
+        const int otherFirst = otherNode.firstFace[otherRef.slot];
+        for (int j = 0; j < otherNode.numFaces[otherRef.slot]; ++j)
+            for (int i = 0; i < node.numFaces[ref.slot]; ++i)
+                facePairs.push_back(std::pair<int,int>
+                   (faceOrder[first+i], other.faceOrder[otherFirst+j]));
+        return;
+    }
+
+    if (otherIsLeaf) {
+        const int mask = findOverlappingChildren(node, otherLo_M, otherHi_M);
+        for (int k = 0; k < Width; ++k)
+            if (mask & (1<<k))
+                findOverlaps(other, R_MO, absR_MO, p_MO, 
+                             childRef(ref.node, k), otherRef, 
+                             otherLo_M, otherHi_M, facePairs);
+        return;
+    }
+
+    for (int j = 0; j < Width; ++j) {
+        if (other.isEmptySlot(otherNode, j))
+            continue;
+        Vec3 lo_M, hi_M;
+        transformBox(R_MO, absR_MO, p_MO, 
+            Vec3(otherNode.lo[0][j], otherNode.lo[1][j], otherNode.lo[2][j]),
+            Vec3(otherNode.hi[0][j], otherNode.hi[1][j], otherNode.hi[2][j]),
+            lo_M, hi_M);
+        const Ref otherChild = other.childRef(otherRef.node, j);
+        if (isLeaf) {
+            const int k = ref.slot;
+            if (boxesOverlap(Vec3(node.lo[0][k], node.lo[1][k], node.lo[2][k]),
+                             Vec3(node.hi[0][k], node.hi[1][k], node.hi[2][k]),
+                             lo_M, hi_M))
+                findOverlaps(other, R_MO, absR_MO, p_MO, ref, otherChild,
+                             lo_M, hi_M, facePairs);
+            continue;
+        }
+        const int mask = findOverlappingChildren(node, lo_M, hi_M);
+        for (int k = 0; k < Width; ++k)
+            if (mask & (1<<k))
+                findOverlaps(other, R_MO, absR_MO, p_MO, 
+                             childRef(ref.node, k), otherChild, 
+                             lo_M, hi_M, facePairs);
+    }
+}
+
+
+
 //==============================================================================
 //            CONTACT GEOMETRY :: TRIANGLE MESH :: OBB TREE NODE
 //==============================================================================
@@ -27,6 +27,8 @@
 #include "simmath/internal/common.h"
 #include "simmath/internal/Contact.h"
 
+#include <atomic>
+
 namespace SimTK {
 
 
@@ -89,7 +91,9 @@ public:
 protected:
 friend class Contact;
 
-    mutable int         m_referenceCount;
+    // Contact handles are shared among State copies that may be realized
+    // on different threads, so the count must be updated atomically.
+    mutable std::atomic<int> m_referenceCount;
     Contact::Condition  m_condition;
     ContactId           m_id;
     ContactSurfaceIndex m_surf1,
@@ -184,7 +188,8 @@ public:
         const Transform& X_S1S2, const Transform& X_S1C, 
         const Vec2& k, Real depth)
     :   ContactImpl(surf1, surf2, X_S1S2), 
-        X_S1C(X_S1C), k(k), depth(depth) {}
+        X_S1C(X_S1C), k(k), depth(depth), 
+        witness1(NaN), witness2(NaN), numIterations(-1) {}
 
     ContactTypeId getTypeId() const override {return classTypeId();}
     static ContactTypeId classTypeId() {
@@ -197,6 +202,9 @@ friend class EllipticalPointContact;
     Transform   X_S1C;
     Vec2        k; // kmax, kmin
     Real        depth;
+    // Optional; left for the next step's tracker to start from.
+    Vec3        witness1, witness2; // in S1, S2 resp.
+    int         numIterations;      // -1 if no witness points
 };
 
 
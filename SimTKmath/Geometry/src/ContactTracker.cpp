@@ -1048,6 +1048,78 @@ bool ContactTracker::TriangleMeshTriangleMesh::trackContact
     return true; // success
 }
 
+// Same as TriangleMeshTriangleMesh::trackContact() except for how the
+// intersecting faces are found.
+bool ContactTracker::TriangleMeshTriangleMeshAABB::trackContact
+   (const Contact&         priorStatus,
+    const Transform&       X_GM1, 
+    const ContactGeometry& geoMesh1,
+    const Transform&       X_GM2, 
+    const ContactGeometry& geoMesh2,
+    Real                   cutoff,
+    Contact&               currentStatus) const
+{
+    SimTK_ASSERT_ALWAYS
+       (   ContactGeometry::TriangleMesh::isInstance(geoMesh1)
+        && ContactGeometry::TriangleMesh::isInstance(geoMesh2),
+       "ContactTracker::TriangleMeshTriangleMeshAABB::trackContact()");
+
+    // We can't handle a "proximity" test, only penetration. 
+    SimTK_ASSERT_ALWAYS(cutoff==0,
+       "ContactTracker::TriangleMeshTriangleMeshAABB::trackContact()");
+
+    const ContactGeometry::TriangleMesh& mesh1 = 
+        ContactGeometry::TriangleMesh::getAs(geoMesh1);
+    const ContactGeometry::TriangleMesh& mesh2 = 
+        ContactGeometry::TriangleMesh::getAs(geoMesh2);
+
+    // Transform giving mesh2 (M2) frame in the mesh1 (M1) frame.
+    const Transform X_M1M2 = ~X_GM1*X_GM2; 
+    std::set<int> insideFaces1, insideFaces2;
+
+    // Find the faces that are actually intersecting faces on the other
+    // surface, testing only the pairs whose AABBs overlap.
+    Array_< std::pair<int,int> > candidates;
+    mesh1.findCandidateFacePairs(mesh2, X_M1M2, candidates);
+    // Candidates come in runs sharing a mesh2 face, which we only need
+    // to move into M1 once per run.
+    int face2 = -1;
+    Geo::Triangle A;
+    for (unsigned i = 0; i < candidates.size(); i++) {
+        const int face1 = candidates[i].first;
+        if (candidates[i].second != face2) {
+            face2 = candidates[i].second;
+            A = Geo::Triangle
+              (X_M1M2*mesh2.getVertexPosition(mesh2.getFaceVertex(face2,0)),
+               X_M1M2*mesh2.getVertexPosition(mesh2.getFaceVertex(face2,1)),
+               X_M1M2*mesh2.getVertexPosition(mesh2.getFaceVertex(face2,2)));
+        }
+        const Geo::Triangle B
+           (mesh1.getVertexPosition(mesh1.getFaceVertex(face1, 0)),
+            mesh1.getVertexPosition(mesh1.getFaceVertex(face1, 1)),
+            mesh1.getVertexPosition(mesh1.getFaceVertex(face1, 2)));
+        if (A.overlapsTriangle(B)) {
+            insideFaces1.insert(face1);
+            insideFaces2.insert(face2);
+        }
+    }
+
+    if (insideFaces1.empty() && insideFaces2.empty()) {
+        currentStatus.clear(); // not touching
+        return true; // successful return
+    }
+    
+    // Fill in the buried faces.
+    findBuriedFaces(mesh1, mesh2, ~X_M1M2, insideFaces1);
+    findBuriedFaces(mesh2, mesh1,  X_M1M2, insideFaces2);
+
+    currentStatus = TriangleMeshContact(priorStatus.getSurface1(), 
+                                        priorStatus.getSurface2(), 
+                                        X_M1M2, 
+                                        insideFaces1, insideFaces2);
+    return true; // success
+}
+
 void ContactTracker::TriangleMeshTriangleMesh::
 findIntersectingFaces
    (const ContactGeometry::TriangleMesh&                mesh1, 
@@ -1283,31 +1355,51 @@ bool ContactTracker::ConvexImplicitPair::trackContact
     // We'll work in the shape A frame.
     const Transform X_AB = ~X_GA*X_GB; // 63 flops
     const Rotation& R_AB = X_AB.R();
+    const Real accuracyRequested = SignificantReal;
 
-    // 1. Get a rough guess at the contact points P and Q and contact normal.
     Vec3 pointP_A, pointQ_B; // on A and B, resp.
-    UnitVec3 norm_A;
-    int numMPRIters;
-    const bool mightBeContact = estimateConvexImplicitPairContactUsingMPR
-                                   (shapeA, shapeB, X_AB,
-                                    pointP_A, pointQ_B, norm_A, numMPRIters);
+    Real accuracyAchieved; int numNewtonIters;
+    bool converged = false;
+
+    // 1. If these surfaces were already in contact, the points found last 
+    //    time are fixed in their own surfaces' frames and should still be
+    //    very close, so try refining them directly. If that fails we start
+    //    over as for a new contact.
+    if (   EllipticalPointContact::isInstance(priorStatus)
+        && EllipticalPointContact::getAs(priorStatus).hasWitnessPoints())
+    {
+        const EllipticalPointContact& prior = 
+            EllipticalPointContact::getAs(priorStatus);
+        pointP_A = prior.getWitnessPoint1();
+        pointQ_B = prior.getWitnessPoint2();
+        converged = refineImplicitPair(shapeA, pointP_A, shapeB, pointQ_B,
+            X_AB, accuracyRequested, accuracyAchieved, numNewtonIters);
+    }
 
-    #ifdef MPR_DEBUG
-    std::cout << "MPR: " << (mightBeContact?"MAYBE":"NO") << std::endl;
-    std::cout << "  P=" << X_GA*pointP_A << " Q=" << X_GB*pointQ_B << std::endl;
-    std::cout << "  N=" << X_GA.R()*norm_A << std::endl;
-    #endif
+    if (!converged) {
+        // 1a. Get a rough guess at the contact points P and Q and contact 
+        //     normal.
+        UnitVec3 norm_A;
+        int numMPRIters;
+        const bool mightBeContact = estimateConvexImplicitPairContactUsingMPR
+                                       (shapeA, shapeB, X_AB,
+                                        pointP_A, pointQ_B, norm_A, numMPRIters);
 
-    if (!mightBeContact) {
-        currentStatus.clear(); // definitely not touching
-        return true; // successful return
-    }
+        #ifdef MPR_DEBUG
+        std::cout << "MPR: " << (mightBeContact?"MAYBE":"NO") << std::endl;
+        std::cout << "  P=" << X_GA*pointP_A << " Q=" << X_GB*pointQ_B << std::endl;
+        std::cout << "  N=" << X_GA.R()*norm_A << std::endl;
+        #endif
 
-    // 2. Refine the contact points to near machine precision.
-    const Real accuracyRequested = SignificantReal;
-    Real accuracyAchieved; int numNewtonIters;
-    bool converged = refineImplicitPair(shapeA, pointP_A, shapeB, pointQ_B,
-        X_AB, accuracyRequested, accuracyAchieved, numNewtonIters);
+        if (!mightBeContact) {
+            currentStatus.clear(); // definitely not touching
+            return true; // successful return
+        }
+
+        // 2. Refine the contact points to near machine precision.
+        converged = refineImplicitPair(shapeA, pointP_A, shapeB, pointQ_B,
+            X_AB, accuracyRequested, accuracyAchieved, numNewtonIters);
+    }
 
     const Vec3 pointQ_A = X_AB*pointQ_B;  // Q on B, measured & expressed in A
 
@@ -1323,8 +1415,8 @@ bool ContactTracker::ConvexImplicitPair::trackContact
     const Real depth = dot(pointP_A-pointQ_A, R_AP.z());
 
     #ifdef MPR_DEBUG
-    printf("MPR %2d iters, Newton %2d iters->accuracy=%g depth=%g\n",
-        numMPRIters, numNewtonIters, accuracyAchieved, depth);
+    printf("Newton %2d iters->accuracy=%g depth=%g\n",
+        numNewtonIters, accuracyAchieved, depth);
     #endif  
 
     if (depth <= 0) {
@@ -1350,10 +1442,14 @@ bool ContactTracker::ConvexImplicitPair::trackContact
                                         maxDirB_A, curvatureQ, 
                                         X_AC.updR(), curvatureC);
 
-    // 5. Return the elliptical point contact for force generation.
-    currentStatus = EllipticalPointContact(priorStatus.getSurface1(),
-                                           priorStatus.getSurface2(),
-                                           X_AB, X_AC, curvatureC, depth);
+    // 5. Return the elliptical point contact for force generation, keeping
+    //    the contact points to start from next time.
+    EllipticalPointContact contact(priorStatus.getSurface1(),
+                                   priorStatus.getSurface2(),
+                                   X_AB, X_AC, curvatureC, depth);
+    if (converged)
+        contact.setWitnessPoints(pointP_A, pointQ_B, numNewtonIters);
+    currentStatus = contact;
     return true; // success
 }
 
@@ -67,6 +67,31 @@ public:
      * will produce an exception.
      */
     void setUseCPodesProjection();
+    /**
+     * By default CPODES solves each Newton iteration with a dense direct linear solver, which requires forming and
+     * factoring an n by n matrix.  Invoking this method with true tells it to use the GMRES Krylov solver instead,
+     * which needs only Jacobian-vector products (formed from directional differences of the state derivatives) and
+     * so scales to systems with many state variables.  It is preconditioned using the exact kinematic coupling
+     * qdot = N(q)*u and, if the System has a mass matrix (see System::multiplyByMPlusDInv()), the mass matrix
+     * together with estimates of the diagonal damping and stiffness, solved in O(n) time.
+     * 
+     * This method must be invoked before the integrator is initialized.  Invoking it after initialization
+     * will produce an exception.
+     */
+    void setUseKrylovSolver(bool useKrylov);
+    /**
+     * When the Krylov solver is used (see setUseKrylovSolver()), it is preconditioned by default.  Invoking this
+     * method with false turns the preconditioner off, which is mainly useful for measuring how much it helps.
+     * 
+     * This method must be invoked before the integrator is initialized.  Invoking it after initialization
+     * will produce an exception.
+     */
+    void setUseKrylovPreconditioner(bool usePreconditioner);
+    /**
+     * Get the total number of Krylov (linear) iterations used to solve the Newton iterations since the last call
+     * to resetAllStatistics().  This is zero unless setUseKrylovSolver() has been called with true.
+     */
+    int getNumKrylovIterations() const;
     /**
      * Restrict the integrator to lower orders than it is otherwise capable of (up to 12 for Adams, 5 for BDF).  This method
      * may only be used to decrease the maximum order permitted, never to increase it.  Once you specify an order limit, calling it
@@ -0,0 +1,168 @@
+#ifndef SimTK_SIMMATH_ENSEMBLE_RUNNER_H_
+#define SimTK_SIMMATH_ENSEMBLE_RUNNER_H_
+
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simmath/internal/common.h"
+#include "simmath/Integrator.h"
+
+#include <functional>
+
+namespace SimTK {
+
+/**
+ * This class runs an ensemble of independent simulations of the same System
+ * concurrently, one for each of a set of initial States. For example:
+ *
+ * <pre>
+ * EnsembleRunner runner(system, [](const System& sys)
+ *     {return new RungeKuttaMersonIntegrator(sys);});
+ * runner.setFinalTime(5);
+ * Array_<State> finalStates;
+ * runner.run(initialStates, finalStates);
+ * </pre>
+ *
+ * Each ensemble member is advanced by a TimeStepper, with events handled
+ * exactly as they would be by a TimeStepper used alone. Members are handed
+ * out dynamically to a pool of threads: a thread that finishes a short
+ * simulation immediately starts on the next unclaimed member, so members
+ * that take very different amounts of time keep all threads busy. Each
+ * thread creates its own Integrator with the supplied factory the first time
+ * it needs one and reuses it for every member it simulates.
+ *
+ * The System is shared by all threads and is used only through const
+ * methods, which for Simbody's own subsystems and force elements are safe to
+ * call concurrently with different States. Any event handlers, force
+ * elements, or other components that you add to the System must likewise
+ * not modify themselves while realizing a State or handling an event. The
+ * System must not be modified while run() is in progress.
+ */
+class SimTK_SIMMATH_EXPORT EnsembleRunner {
+public:
+    /**
+     * A function that returns a new heap-allocated Integrator for the given
+     * System, with its accuracy and other options set as desired. It is
+     * called at most once per thread and the EnsembleRunner takes over
+     * ownership of the result.
+     */
+    typedef std::function<Integrator*(const System&)> IntegratorFactory;
+    /**
+     * A function that is given an ensemble member's index and its current
+     * State, and returns true if the simulation of that member should stop
+     * now rather than continue to the final time.
+     */
+    typedef std::function<bool(int member, const State&)> StopCondition;
+    /**
+     * A function that is given an ensemble member's index and a State
+     * reached by that member's simulation.
+     */
+    typedef std::function<void(int member, const State&)> Reporter;
+
+    /**
+     * Create an EnsembleRunner for simulating a System whose topology has
+     * already been realized, using Integrators obtained from a factory.
+     * The number of threads defaults to the number of processors.
+     */
+    EnsembleRunner(const System& system, const IntegratorFactory& factory);
+    ~EnsembleRunner();
+
+    /**
+     * Set the time at which every simulation ends unless it is stopped
+     * earlier by the stop condition or by an event handler. The default is
+     * Infinity, in which case a stop condition and a finite report interval
+     * must be supplied. This overrides any final time set on the
+     * Integrators by the factory.
+     */
+    void setFinalTime(Real tFinal);
+    /** Get the final time set with setFinalTime(). */
+    Real getFinalTime() const;
+    /**
+     * Set the interval at which each simulation returns from its
+     * TimeStepper so that the stop condition can be checked and the
+     * reporter called. The default is Infinity, meaning they are only
+     * consulted at the final time.
+     */
+    void setReportInterval(Real interval);
+    /** Get the interval set with setReportInterval(). */
+    Real getReportInterval() const;
+    /**
+     * Set a stop condition that is checked at every report interval. This
+     * replaces any previous stop condition; an empty function means never
+     * stop early.
+     */
+    void setStopCondition(const StopCondition& stopCondition);
+    /**
+     * Set a reporter to stream results back while the ensemble is running.
+     * It is called with the initial State of each member, at every report
+     * interval, and with the final State. Calls are serialized so the
+     * reporter need not be thread safe, and for any one member they are in
+     * order of increasing time, but calls for different members are
+     * interleaved in no particular order.
+     */
+    void setReporter(const Reporter& reporter);
+    /**
+     * Set the number of threads used to run the ensemble. Set it to one to
+     * run all the members serially in the calling thread.
+     */
+    void setNumberOfThreads(int numThreads);
+    /** Get the number of threads that will be used to run the ensemble. */
+    int getNumberOfThreads() const;
+
+    /**
+     * Simulate every member of the ensemble from its initial State until it
+     * reaches the final time, meets the stop condition, or is terminated by
+     * an event handler, and return the final States. On return
+     * finalStates[i] is the last State of the simulation that began at
+     * initialStates[i].
+     *
+     * If the simulation of any member throws an exception, the other members
+     * are still simulated and then the exception from the lowest-numbered
+     * failing member is rethrown here.
+     */
+    void run(const ArrayViewConst_<State>& initialStates,
+             Array_<State>& finalStates);
+
+    /**
+     * Get the Integrator::TerminationReason for a member after the most
+     * recent call to run(). Members that were stopped by the stop condition
+     * report Integrator::InvalidTerminationReason since their Integrator did
+     * not consider the simulation over.
+     */
+    Integrator::TerminationReason getTerminationReason(int member) const;
+    /** Get whether a member was stopped by the stop condition during the
+    most recent call to run(). **/
+    bool wasStoppedByCondition(int member) const;
+
+private:
+    class EnsembleRunnerRep* rep;
+    friend class EnsembleRunnerRep;
+
+    EnsembleRunner(const EnsembleRunner&) = delete;
+    EnsembleRunner& operator=(const EnsembleRunner&) = delete;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMMATH_ENSEMBLE_RUNNER_H_
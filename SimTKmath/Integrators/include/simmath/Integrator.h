@@ -400,6 +400,18 @@ public:
     /// matrix for efficiency. You can force strict use of a current iteration
     /// matrix recomputed at each iteration if you want.
     void setForceFullNewton(bool forceFullNewton);
+    /// (Advanced) Set whether event triggers should be localized by fitting
+    /// a polynomial to the trigger function values at a few points of the
+    /// integrator's interpolant, locating the zero crossings of all the 
+    /// triggered events at once, and then only verifying the result at the
+    /// final localization window. Each of those evaluations realizes the
+    /// interpolated state only through the highest Stage at which a triggered
+    /// event's trigger function is calculated. This can greatly reduce the
+    /// cost of localization when there are many position- or velocity-level 
+    /// event triggers. If verification fails, localization continues in the 
+    /// normal way from the narrowed interval. The default is "false". 
+    /// CPodesIntegrator has its own root finder and ignores this option.
+    void setLocalizeEventsByInterpolation(bool shouldUseInterpolant);
 
     /// OBSOLETE: use getSuccessfulStepStatusString().
     static String successfulStepStatusString(SuccessfulStepStatus stat)
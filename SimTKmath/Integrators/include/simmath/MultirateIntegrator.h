@@ -0,0 +1,91 @@
+#ifndef SimTK_SIMMATH_MULTIRATE_INTEGRATOR_H_
+#define SimTK_SIMMATH_MULTIRATE_INTEGRATOR_H_
+
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simmath/internal/common.h"
+#include "simmath/Integrator.h"
+
+namespace SimTK {
+class MultirateIntegratorRep;
+
+/**
+ * This is a multirate explicit integrator for systems in which a small set of
+ * auxiliary state variables z (for example muscle activations or actuator
+ * states) change much faster than the rest of the state. The designated fast
+ * z's are advanced with several cheaper substeps inside each step taken by
+ * the slow variables, so that the fast dynamics no longer limit the step 
+ * size of the whole system.
+ *
+ * The slow variables (q, u and any z's that have not been designated fast)
+ * are advanced with the same error-controlled third order Runge-Kutta method
+ * used by RungeKutta3Integrator. The fast z's are advanced first over the 
+ * whole step, with the slow variables extrapolated from their values and 
+ * derivatives at the start of this step and the previous one. Each substep 
+ * uses the same Runge-Kutta method on the fast z's alone. Only its first 
+ * evaluation, at the end of the substep, has to realize the system 
+ * kinematics; the remaining ones change only the fast z's and correct for
+ * the slow variables' motion with the slope that evaluation provides. The
+ * slow step then uses the fast values the substeps produced at its stage 
+ * times. Each substep is error controlled separately to meet the requested
+ * accuracy; the slow step size is controlled as usual.
+ *
+ * This is an explicit method. If the fast states are stiff rather than just
+ * fast (for example a first order lag with a very short time constant), an
+ * implicit integrator such as CPodesIntegrator or RosenbrockIntegrator will
+ * usually be faster still.
+ *
+ * With no fast states designated this integrator behaves exactly like
+ * RungeKutta3Integrator. Fast state designations take effect the next time
+ * the integrator is initialized. Only z's may be fast since q's and u's are 
+ * coupled through the system kinematics.
+ */
+class SimTK_SIMMATH_EXPORT MultirateIntegrator : public Integrator {
+public:
+    explicit MultirateIntegrator(const System& sys);
+
+    /** Designate all the z's allocated by the given Subsystem as fast. */
+    void addFastSubsystem(SubsystemIndex subsys);
+    /** Designate a single z, by its index among all the System's z's, as 
+    fast. **/
+    void addFastZ(SystemZIndex z);
+
+    /** Specify the Stage by which all the fast z derivatives have been 
+    calculated; this must be Stage::Dynamics or Stage::Acceleration. z
+    derivatives are normally available at Dynamics stage, but some (such as
+    those of a Measure::Integrate) are not calculated until Acceleration 
+    stage, so that is the default. If you know the fast derivatives are ready
+    at Dynamics stage, setting it here lets the substeps skip the Acceleration
+    stage, which is usually the most expensive part of a realization. **/
+    void setFastDerivativeStage(Stage stage);
+
+    /** Return the total number of substeps that have been taken by the fast
+    z's, including those taken during steps that were later rejected. **/
+    int getNumSubsteps() const;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMMATH_MULTIRATE_INTEGRATOR_H_
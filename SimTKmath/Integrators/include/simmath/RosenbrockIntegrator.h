@@ -0,0 +1,65 @@
+#ifndef SimTK_SIMMATH_ROSENBROCK_INTEGRATOR_H_
+#define SimTK_SIMMATH_ROSENBROCK_INTEGRATOR_H_
+
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simmath/internal/common.h"
+#include "simmath/Integrator.h"
+
+namespace SimTK {
+class RosenbrockIntegratorRep;
+
+/**
+ * This is a linearly-implicit Rosenbrock-W integrator intended for stiff
+ * systems, such as models with stiff compliant contact or bushings, where an
+ * explicit Runge-Kutta method is forced to take very small steps for
+ * stability rather than accuracy. It uses the four stage ROS34PW2 method of
+ * J. Rang and L. Angermann, "New Rosenbrock W-methods of order 3 for partial
+ * differential algebraic equations of index 1", BIT Numerical Mathematics
+ * 45:761-787, 2005. That method is third order, L-stable, and has an
+ * embedded second order error estimate used for step size control.
+ *
+ * Each step requires the solution of four linear systems with the same
+ * matrix I/(h*gamma) - J, where J is an approximation to the Jacobian of the
+ * state derivatives. Because this is a W-method its order does not depend on
+ * J being exact, so J is calculated by finite differences only occasionally
+ * and reused across steps; it is recomputed when a step from the same
+ * starting point has to be retried. No nonlinear iteration is performed.
+ * Dense output for reporting and event localization is the usual Hermite
+ * cubic interpolation shared by the other error-controlled integrators.
+ *
+ * The cost of forming and factoring the dense iteration matrix grows with
+ * the cube of the number of state variables, so this integrator is best
+ * suited to small and moderate sized stiff systems; for large systems
+ * consider CPodesIntegrator.
+ */
+class SimTK_SIMMATH_EXPORT RosenbrockIntegrator : public Integrator {
+public:
+    explicit RosenbrockIntegrator(const System& sys);
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMMATH_ROSENBROCK_INTEGRATOR_H_
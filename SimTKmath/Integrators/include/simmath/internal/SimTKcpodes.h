@@ -70,6 +70,13 @@ public:
                               const char* function, char* msg) const;
 
     //TODO: Jacobian functions
+
+    // For an explicit ODE using a Krylov linear solver, solve P*z=r where P
+    // approximates the Newton iteration matrix I-gamma*df/dy at (t,y). 
+    // lr is 1 when called for left preconditioning and 2 for right.
+    virtual int  explicitPrecSolve(Real t, const Vector& y, const Vector& fy,
+                                   const Vector& r, Vector& z, Real gamma,
+                                   Real delta, int lr) const;
 };
 
 
@@ -111,6 +118,12 @@ static void errorHandler_static(const CPodesSystem& sys,
                                 const char* function, char* msg)
   { sys.errorHandler(error_code,module,function,msg); }
 
+static int explicitPrecSolve_static(const CPodesSystem& sys, 
+                                    Real t, const Vector& y, const Vector& fy,
+                                    const Vector& r, Vector& z, Real gamma,
+                                    Real delta, int lr)
+  { return sys.explicitPrecSolve(t,y,fy,r,z,gamma,delta,lr); }
+
 /**
  * This is a straightforward translation of the Sundials CPODES C 
  * interface into C++. The class CPodes represents a single instance
@@ -169,6 +182,13 @@ public:
         ProjectWithQRPivot  // for handling redundancy
     };
 
+    enum KrylovPreconditioning {
+        NoPreconditioning=0,
+        LeftPreconditioning,
+        RightPreconditioning,
+        BothSidesPreconditioning
+    };
+
     enum StepMode {
         UnspecifiedStepMode=0,
         Normal,
@@ -342,6 +362,19 @@ public:
     int lapackBand(int N, int mupper, int mlower);
     int lapackDenseProj(int Nc, int Ny, ProjectionFactorizationType);
 
+    // Use the scaled preconditioned GMRES Krylov linear solver, with at most
+    // maxl Krylov vectors (0 means the default of 5). Jacobian-vector 
+    // products are formed from directional differences of f.
+    int spgmr(KrylovPreconditioning pretype, int maxl);
+
+    // This tells CPodes to make use of the user's explicitPrecSolve() 
+    // method from CPodesSystem. Call this after choosing the Krylov solver.
+    int spilsSetPrecSolveFn();
+
+    int spilsGetNumLinIters(int* nliters);
+    int spilsGetNumPrecSolves(int* npsolves);
+    int spilsGetNumJtimesEvals(int* njvevals);
+
 private:
     // This is how we get the client-side virtual functions to
     // be callable from library-side code while maintaining binary
@@ -366,6 +399,11 @@ private:
     typedef void (*ErrorHandlerFunc)(const CPodesSystem&, 
                                      int error_code, const char* module, 
                                      const char* function, char* msg);
+    typedef int (*ExplicitPrecSolveFunc)(const CPodesSystem&, 
+                                         Real t, const Vector& y, 
+                                         const Vector& fy, const Vector& r,
+                                         Vector& z, Real gamma, Real delta,
+                                         int lr);
 
     // Note that these routines do not tell CPodes to use the supplied
     // functions. They merely provide the client-side addresses of functions
@@ -383,6 +421,7 @@ private:
     void registerRootFunc(RootFunc);
     void registerWeightFunc(WeightFunc);
     void registerErrorHandlerFunc(ErrorHandlerFunc);
+    void registerExplicitPrecSolveFunc(ExplicitPrecSolveFunc);
 
 
     // This is the library-side part of the CPodes constructor. This must
@@ -401,6 +440,7 @@ private:
         registerRootFunc(root_static);
         registerWeightFunc(weight_static);
         registerErrorHandlerFunc(errorHandler_static);
+        registerExplicitPrecSolveFunc(explicitPrecSolve_static);
     }
 
     // FOR INTERNAL USE ONLY
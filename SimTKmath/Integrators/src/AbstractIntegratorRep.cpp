@@ -655,6 +655,15 @@ bool AbstractIntegratorRep::takeOneStep(Real tMax, Real tReport)
     // think the first event is triggering.
 
     Vector eLow = e0, eHigh = e1;
+
+    // If requested, narrow the interval in a single pass using the 
+    // interpolant; usually that leaves nothing for the loop below to do.
+    if (userLocalizeEventsByInterpolation == 1)
+        localizeEventsByInterpolation(MinWindow, tLow, eLow, tHigh, eHigh,
+                                      eventCandidates, eventTimeEstimates,
+                                      eventCandidateTransitions,
+                                      earliestTimeEst, narrowestWindow);
+
     Real bias = 1; // neutral
 
     // There is an event in (tLow,tHigh], with the eariest occurrence
@@ -666,7 +675,9 @@ bool AbstractIntegratorRep::takeOneStep(Real tMax, Real tReport)
     // the last two iterations. -1 => (tLow,tMid], 1 => (tMid,tHigh], 0 => not
     // valid yet.
     int sideTwoItersAgo=0, sidePrevIter=0;
-    do {
+    while (   (tHigh-tLow) > narrowestWindow 
+           || (tLow < tReport && tReport < tHigh)) 
+    {
         if (sideTwoItersAgo != 0 && sidePrevIter != 0) {
             if (sideTwoItersAgo != sidePrevIter)
                 bias = 1; // this is good; alternating intervals
@@ -731,8 +742,7 @@ bool AbstractIntegratorRep::takeOneStep(Real tMax, Real tReport)
         // These will still be the original transitions, but only the ones
         // which are still candidates are retained.
         eventCandidateTransitions = newEventCandidateTransitions;
-
-    } while ((tHigh-tLow) > narrowestWindow);
+    }
 
     Array_<EventId> ids;
     findEventIds(eventCandidates, ids);
@@ -757,6 +767,182 @@ bool AbstractIntegratorRep::takeOneStep(Real tMax, Real tReport)
 
 
 
+//==============================================================================
+//                    LOCALIZE EVENTS BY INTERPOLATION
+//==============================================================================
+// Evaluate at time t the Lagrange polynomial through the four nodes 
+// (tNode[i], eNode[i][e]).
+static Real evalCubicThroughNodes(const Real tNode[4], const Vector eNode[4],
+                                  SystemEventTriggerIndex e, Real t) {
+    Real p = 0;
+    for (int i=0; i < 4; ++i) {
+        Real li = 1;
+        for (int j=0; j < 4; ++j)
+            if (j != i) li *= (t - tNode[j]) / (tNode[i] - tNode[j]);
+        p += li * eNode[i][e];
+    }
+    return p;
+}
+
+// On entry (tLow,tHigh] is the whole step interval, eLow and eHigh are the
+// event trigger values at its ends, and the candidate arrays, earliestTimeEst
+// and narrowestWindow are as returned by findEventCandidates() for that
+// interval. We sample the triggers at two interior points of the interpolant,
+// which together with the end points determine a cubic for each trigger 
+// function, find the earliest subinterval containing a candidate, and then
+// locate the earliest root of the cubics in that subinterval without any
+// further realizations. Finally we evaluate the triggers at the ends of a 
+// window around that root to make sure the earliest event really is there.
+// On return the arguments describe the narrowest interval we were able to
+// verify, which is always a valid starting point for the normal localization
+// loop, and will usually already be narrow enough.
+//
+// Trigger function values are only calculated through the highest stage of
+// any of the candidates; the other entries of the trigger vectors are left
+// unchanged and must not be looked at.
+void AbstractIntegratorRep::localizeEventsByInterpolation
+   (Real minWindow, Real& tLow, Vector& eLow, Real& tHigh, Vector& eHigh,
+    Array_<SystemEventTriggerIndex>& candidates, Array_<Real>& timeEstimates,
+    Array_<Event::Trigger>& transitions, Real& earliestTimeEst, 
+    Real& narrowestWindow)
+{
+    const State& advanced = getAdvancedState();
+    const int nEvents = eLow.size();
+
+    // Find the highest stage at which any of the candidates is calculated.
+    Stage g = Stage::Topology;
+    for (unsigned i=0; i < candidates.size(); ++i)
+        for (Stage j = Stage::Acceleration; j > g; --j)
+            if (candidates[i] >= advanced.getEventTriggerStartByStage(j)) {
+                g = j;
+                break;
+            }
+
+    // Evaluate at two interior points; nodes 0 and 3 are the end points.
+    const Real h = tHigh - tLow;
+    Real   tNode[4] = {tLow, tLow + h/3, tLow + 2*h/3, tHigh};
+    Vector eNode[4] = {eLow, eHigh, eHigh, eHigh};
+    evaluateInterpolatedEventTriggers(tNode[1], g, eNode[1]);
+    evaluateInterpolatedEventTriggers(tNode[2], g, eNode[2]);
+
+    // Try each subinterval (tLow,tHigh] in turn, in time order, and narrow
+    // to the first one in which any of the current candidates is seen.
+    Array_<SystemEventTriggerIndex> newCandidates;
+    Array_<Real>                    newTimeEstimates;
+    Array_<Event::Trigger>          newTransitions;
+    const auto tryInterval = [&](Real t0, const Vector& e0, 
+                                 Real t1, const Vector& e1) -> bool {
+        findEventCandidates(nEvents, &candidates, &transitions,
+                            t0, e0, t1, e1, 1., minWindow,
+                            newCandidates, newTimeEstimates, newTransitions,
+                            earliestTimeEst, narrowestWindow);
+        if (newCandidates.empty())
+            return false;
+        tLow = t0; eLow = e0; tHigh = t1; eHigh = e1;
+        candidates = newCandidates;
+        timeEstimates = newTimeEstimates;
+        transitions = newTransitions;
+        return true;
+    };
+
+    int k = 0;
+    while (k < 3 && !tryInterval(tNode[k], eNode[k], tNode[k+1], eNode[k+1]))
+        ++k;
+    if (k == 3) {
+        // Only possible if a trigger touched zero at an interior point. The 
+        // loop will have to sort this out; note that the failed tries have 
+        // clobbered earliestTimeEst and narrowestWindow.
+        tryInterval(tNode[0], eNode[0], tNode[3], eNode[3]);
+        return;
+    }
+    if (tHigh - tLow <= narrowestWindow)
+        return;
+
+    // Find the earliest root of the cubic through the four nodes for any of
+    // the candidates in the subinterval, using the Illinois variant of 
+    // regula falsi. Values that are exactly zero at a node aren't worth any
+    // effort here; the secant estimate from above will do for those.
+    const Real tol = narrowestWindow/4;
+    Real tRoot = Infinity;
+    for (unsigned i=0; i < candidates.size(); ++i) {
+        const SystemEventTriggerIndex e = candidates[i];
+        Real ta = tLow, fa = eLow[e], tb = tHigh, fb = eHigh[e];
+        if (fa == 0 || fb == 0) {
+            tRoot = std::min(tRoot, timeEstimates[i]);
+            continue;
+        }
+        int side = 0;
+        for (int iter=0; iter < 50 && tb-ta > tol; ++iter) {
+            const Real tr = (fa*tb - fb*ta) / (fa - fb);
+            const Real fr = evalCubicThroughNodes(tNode, eNode, e, tr);
+            if (fr == 0) {
+                ta = tb = tr;
+                break;
+            }
+            if (sign(fr) == sign(fa)) {
+                ta = tr; fa = fr;
+                if (side == -1) fb /= 2;
+                side = -1;
+            } else {
+                tb = tr; fb = fr;
+                if (side == 1) fa /= 2;
+                side = 1;
+            }
+        }
+        tRoot = std::min(tRoot, (ta+tb)/2);
+    }
+
+    // Verify using a window a little narrower than required, centered on 
+    // the root. We need to see that nothing triggers before the window, and 
+    // then that something does trigger inside it.
+    const Real tA = tLow, tB = tHigh;
+    const Vector eA = eLow, eB = eHigh;
+    const Real halfWindow = Real(0.49)*narrowestWindow;
+    const Real tWinLow  = std::max(tA, tRoot - halfWindow);
+    const Real tWinHigh = std::min(tB, tRoot + halfWindow);
+    Vector eWinLow = eA, eWinHigh = eB;
+    if (tWinLow > tA) {
+        evaluateInterpolatedEventTriggers(tWinLow, g, eWinLow);
+        if (tryInterval(tA, eA, tWinLow, eWinLow))
+            return;
+    }
+    if (tWinHigh < tB) {
+        evaluateInterpolatedEventTriggers(tWinHigh, g, eWinHigh);
+        if (tryInterval(tWinLow, eWinLow, tWinHigh, eWinHigh)
+            || tryInterval(tWinHigh, eWinHigh, tB, eB))
+            return;
+    } else if (tryInterval(tWinLow, eWinLow, tB, eB))
+        return;
+
+    // Nothing verified; go back to the subinterval we started with.
+    tryInterval(tA, eA, tB, eB);
+}
+
+// Create an interpolated state at time t and realize it through Stage g, then
+// copy the event trigger values for stages through g into e, which must 
+// already have the right length.
+void AbstractIntegratorRep::evaluateInterpolatedEventTriggers
+   (Real t, Stage g, Vector& e) 
+{
+    createInterpolatedState(t);
+    const State& interp = getInterpolatedState();
+    // Failure to evaluate at the interpolated state is a disaster of some
+    // kind, not something we expect to be able to recover from, so this 
+    // will throw an exception if it fails.
+    if (g == Stage::Acceleration)
+        realizeStateDerivatives(interp);
+    else
+        getSystem().realize(interp, g);
+
+    for (Stage j = Stage::Topology; j <= g; ++j) {
+        const int n = interp.getNEventTriggersByStage(j);
+        if (n) e(interp.getEventTriggerStartByStage(j), n) = 
+                   interp.getEventTriggersByStage(j);
+    }
+}
+
+
+
 //==============================================================================
 //                              STATUS & MISC
 //==============================================================================
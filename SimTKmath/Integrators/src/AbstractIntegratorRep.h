@@ -160,6 +160,12 @@ protected:
     int statsConvergentIterations, statsDivergentIterations;
 private:
     bool takeOneStep(Real tMax, Real tReport);
+    void localizeEventsByInterpolation
+       (Real minWindow, Real& tLow, Vector& eLow, Real& tHigh, Vector& eHigh,
+        Array_<SystemEventTriggerIndex>& candidates, Array_<Real>& timeEstimates,
+        Array_<Event::Trigger>& transitions, Real& earliestTimeEst, 
+        Real& narrowestWindow);
+    void evaluateInterpolatedEventTriggers(Real t, Stage g, Vector& e);
     bool initialized, hasErrorControl;
     Real currentStepSize, lastStepSize, actualInitialStepSizeTaken;
     int minOrder, maxOrder;
@@ -31,6 +31,7 @@
 #include "cpodes/cpodes.h"
 #include "cpodes/cpodes_dense.h"
 #include "cpodes/cpodes_lapack_exports.h"
+#include "cpodes/cpodes_spgmr.h"
 
 #include <limits>
 
@@ -66,6 +67,7 @@ public:
     CPodes::RootFunc            rootFunc;
     CPodes::WeightFunc          weightFunc;
     CPodes::ErrorHandlerFunc    errorHandlerFunc;
+    CPodes::ExplicitPrecSolveFunc explicitPrecSolveFunc;
 
     void zeroFunctionPointers() {
         explicitODEFunc  = 0;
@@ -76,6 +78,7 @@ public:
         rootFunc         = 0;
         weightFunc       = 0;
         errorHandlerFunc = 0;
+        explicitPrecSolveFunc = 0;
     }
 
     void setMyHandle(CPodes& cp) {myHandle = &cp;}
@@ -183,6 +186,20 @@ static void errorHandlerWrapper(int error_code,
     return rep.errorHandlerFunc(rep.getCPodesSystem(), error_code,module,function,msg);
 }
 
+static int explicitPrecSolveWrapper(realtype t, N_Vector nv_y, N_Vector nv_fy,
+                                    N_Vector nv_r, N_Vector nv_z,
+                                    realtype gamma, realtype delta, int lr,
+                                    void* P_data, N_Vector)
+{
+    const Vector& y    = N_Vector_SimTK::getVector(nv_y);
+    const Vector& fy   = N_Vector_SimTK::getVector(nv_fy);
+    const Vector& r    = N_Vector_SimTK::getVector(nv_r);
+    Vector&       z    = N_Vector_SimTK::updVector(nv_z);
+    const CPodesRep& rep = *reinterpret_cast<const CPodesRep*>(P_data);
+    return rep.explicitPrecSolveFunc(rep.getCPodesSystem(), 
+                                     t, y, fy, r, z, gamma, delta, lr);
+}
+
 ////////////////////////////////////////
 // CLASS SimTK::CPodes IMPLEMENTATION //
 ////////////////////////////////////////
@@ -248,6 +265,16 @@ static int mapProjectionFactorizationType(CPodes::ProjectionFactorizationType ft
     }
 }
 
+static int mapKrylovPreconditioning(CPodes::KrylovPreconditioning pre) {
+    switch(pre) {
+    case CPodes::NoPreconditioning:         return PREC_NONE;
+    case CPodes::LeftPreconditioning:       return PREC_LEFT;
+    case CPodes::RightPreconditioning:      return PREC_RIGHT;
+    case CPodes::BothSidesPreconditioning:  return PREC_BOTH;
+    default: return std::numeric_limits<int>::min();
+    }
+}
+
 static int mapStepMode(CPodes::StepMode mode) {
     switch(mode) {
     case CPodes::Normal:       return CP_NORMAL;
@@ -681,6 +708,34 @@ int CPodes::lapackDenseProj(int Nc, int Ny, ProjectionFactorizationType fact_typ
         mapProjectionFactorizationType(fact_type));
 }
 
+int CPodes::spgmr(KrylovPreconditioning pretype, int maxl) {
+    return CPSpgmr(updRep().cpode_mem, mapKrylovPreconditioning(pretype), 
+                   maxl);
+}
+int CPodes::spilsSetPrecSolveFn() {
+    return CPSpilsSetPreconditioner(updRep().cpode_mem, 0, 
+                                    (void*)explicitPrecSolveWrapper,
+                                    (void*)rep);
+}
+int CPodes::spilsGetNumLinIters(int* nliters) {
+    long lnliters;
+    int stat = CPSpilsGetNumLinIters(updRep().cpode_mem,&lnliters);
+    *nliters = (int)lnliters;
+    return stat;
+}
+int CPodes::spilsGetNumPrecSolves(int* npsolves) {
+    long lnpsolves;
+    int stat = CPSpilsGetNumPrecSolves(updRep().cpode_mem,&lnpsolves);
+    *npsolves = (int)lnpsolves;
+    return stat;
+}
+int CPodes::spilsGetNumJtimesEvals(int* njvevals) {
+    long lnjvevals;
+    int stat = CPSpilsGetNumJtimesEvals(updRep().cpode_mem,&lnjvevals);
+    *njvevals = (int)lnjvevals;
+    return stat;
+}
+
 
 
 // Client-side function registration
@@ -708,6 +763,9 @@ void CPodes::registerWeightFunc(CPodes::WeightFunc f) {
 void CPodes::registerErrorHandlerFunc(CPodes::ErrorHandlerFunc f) {
     updRep().errorHandlerFunc = f;
 }
+void CPodes::registerExplicitPrecSolveFunc(CPodes::ExplicitPrecSolveFunc f) {
+    updRep().explicitPrecSolveFunc = f;
+}
 
 /////////////////////////////////
 // CPodesSystem IMPLEMENTATION //
@@ -753,6 +811,14 @@ int CPodesSystem::weight(const Vector&, Vector&) const {
     return std::numeric_limits<int>::min();
 }
 
+int CPodesSystem::explicitPrecSolve(Real, const Vector&, const Vector&, 
+                                    const Vector&, Vector&, Real, Real, 
+                                    int) const {
+    SimTK_THROW2(Exception::UnimplementedVirtualMethod, "CPodesSystem", 
+                 "explicitPrecSolve"); 
+    return std::numeric_limits<int>::min();
+}
+
 void CPodesSystem::errorHandler(int, const char*, const char*, char*) const {
     SimTK_THROW2(Exception::UnimplementedVirtualMethod, "CPodesSystem", "errorHandler"); 
 }
@@ -46,6 +46,22 @@ void CPodesIntegrator::setUseCPodesProjection() {
     cprep.setUseCPodesProjection();
 }
 
+void CPodesIntegrator::setUseKrylovSolver(bool useKrylov) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setUseKrylovSolver(useKrylov);
+}
+
+void CPodesIntegrator::setUseKrylovPreconditioner(bool usePreconditioner) {
+    CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
+    cprep.setUseKrylovPreconditioner(usePreconditioner);
+}
+
+int CPodesIntegrator::getNumKrylovIterations() const {
+    const CPodesIntegratorRep& cprep = 
+        dynamic_cast<const CPodesIntegratorRep&>(*rep);
+    return cprep.getNumKrylovIterations();
+}
+
 void CPodesIntegrator::setOrderLimit(int order) {
     CPodesIntegratorRep& cprep = dynamic_cast<CPodesIntegratorRep&>(*rep);
     cprep.setOrderLimit(order);
@@ -124,6 +140,13 @@ public:
         gout = integ.getAdvancedState().getEventTriggers();
         return CPodes::Success;
     }
+
+    // Solve P*z = r where P approximates I - gamma*df/dy at (t,y).
+    int explicitPrecSolve(Real t, const Vector& y, const Vector& fy,
+                          const Vector& r, Vector& z, Real gamma, Real delta,
+                          int lr) const override {
+        return integ.solveNewtonPreconditioner(t, y, r, z, gamma);
+    }
 private:
     CPodesIntegratorRep& integ;
     const System& system;
@@ -137,6 +160,10 @@ void CPodesIntegratorRep::init
     cps = new CPodesSystemImpl(*this, getSystem());
     initialized = false;
     useCpodesProjection = false;
+    useKrylovSolver = false;
+    useKrylovPreconditioner = true;
+    precHasMassMatrix = true;
+    precStepsAtEstimate = precConvFailuresAtEstimate = 0;
 }
 
 CPodesIntegratorRep::CPodesIntegratorRep
@@ -189,7 +216,18 @@ void CPodesIntegratorRep::methodInitialize(const State& state) {
         printf("init() returned %d\n", retval);
         SimTK_THROW1(Integrator::InitializationFailed, "init() failed");
     }
-    cpodes->lapackDense(ny);
+    krylovSolverInitPending = true;
+    if (useKrylovSolver) {
+        if (useKrylovPreconditioner) {
+            cpodes->spgmr(CPodes::LeftPreconditioning, 0);
+            cpodes->spilsSetPrecSolveFn();
+            precState = state;
+            precHasMassMatrix = true; // until we find out otherwise
+            precDamping.resize(0); precStiffness.resize(0);
+        } else
+            cpodes->spgmr(CPodes::NoPreconditioning, 0);
+    } else
+        cpodes->lapackDense(ny);
     cpodes->setNonlinConvCoef(Real(0.01)); // TODO (default is 0.1)
     if (useCpodesProjection) {
         const int nqerr = state.getNQErr(), nuerr = state.getNUErr();
@@ -235,6 +273,11 @@ void CPodesIntegratorRep::methodReinitialize
         cpodes->reInit(*cps, state.getTime(), 
                        Vector(state.getY()), Vector(state.getYDot()), 
                        CPodes::ScalarScalar, relTol, &absTol);
+        krylovSolverInitPending = true;
+        if (useKrylovSolver) {
+            precState = state;
+            precDamping.resize(0); precStiffness.resize(0);
+        }
     }
 }
 
@@ -383,11 +426,16 @@ stepTo(Real reportTime, Real scheduledEventTime) {
             Vector yout(getAdvancedState().getY().size());
             Vector ypout(getAdvancedState().getY().size()); // ignored
             int oldSteps=0, oldTestFailures=0, oldNonlinIterations=0, 
-                oldNonlinConvFailures=0;
+                oldNonlinConvFailures=0, oldLinIterations=0;
             cpodes->getNumSteps(&oldSteps);
             cpodes->getNumErrTestFails(&oldTestFailures);
             cpodes->getNumNonlinSolvIters(&oldNonlinIterations);
             cpodes->getNumNonlinSolvConvFails(&oldNonlinConvFailures);
+            // The Krylov solver zeroes its counter when it is initialized
+            // during the first step after (re)initialization of CPodes.
+            if (useKrylovSolver && !krylovSolverInitPending)
+                cpodes->spilsGetNumLinIters(&oldLinIterations);
+            krylovSolverInitPending = false;
 
             //---------------------step------------------------
             res = cpodes->step(tMax, &tret, yout, ypout, mode);
@@ -408,15 +456,18 @@ stepTo(Real reportTime, Real scheduledEventTime) {
             }
 
             int newSteps=0, newTestFailures=0, newNonlinIterations=0, 
-                newNonlinConvFailures=0;
+                newNonlinConvFailures=0, newLinIterations=0;
             cpodes->getNumSteps(&newSteps);
             cpodes->getNumErrTestFails(&newTestFailures);
             cpodes->getNumNonlinSolvIters(&newNonlinIterations);
             cpodes->getNumNonlinSolvConvFails(&newNonlinConvFailures);
+            if (useKrylovSolver)
+                cpodes->spilsGetNumLinIters(&newLinIterations);
             statsStepsTaken += newSteps-oldSteps;
             statsErrorTestFailures += newTestFailures-oldTestFailures;
             // Project stats were already updated in project() above.
             statsIterations += newNonlinIterations-oldNonlinIterations;
+            statsKrylovIterations += newLinIterations-oldLinIterations;
             statsConvergenceTestFailures += newNonlinConvFailures-oldNonlinConvFailures;
  
             // This takes care of prescribed motion.
@@ -609,11 +660,17 @@ int CPodesIntegratorRep::getNumIterations() const {
     return statsIterations;
 }
 
+int CPodesIntegratorRep::getNumKrylovIterations() const {
+    assert(initialized);
+    return statsKrylovIterations;
+}
+
 void CPodesIntegratorRep::resetMethodStatistics() {
     statsStepsTaken = 0;
     statsErrorTestFailures = 0;
     statsConvergenceTestFailures = 0;
     statsIterations = 0;
+    statsKrylovIterations = 0;
 }
 
 const char* CPodesIntegratorRep::getMethodName() const {
@@ -639,6 +696,164 @@ void CPodesIntegratorRep::setUseCPodesProjection() {
     useCpodesProjection = true;
 }
 
+void CPodesIntegratorRep::setUseKrylovSolver(bool useKrylov) {
+    SimTK_APIARGCHECK_ALWAYS(!initialized, "CPodesIntegrator", 
+        "setUseKrylovSolver",
+        "This method may not be invoked after the integrator has been initialized.");
+    useKrylovSolver = useKrylov;
+}
+
+void CPodesIntegratorRep::setUseKrylovPreconditioner(bool usePreconditioner) {
+    SimTK_APIARGCHECK_ALWAYS(!initialized, "CPodesIntegrator", 
+        "setUseKrylovPreconditioner",
+        "This method may not be invoked after the integrator has been initialized.");
+    useKrylovPreconditioner = usePreconditioner;
+}
+
+// Set the advanced State to y displaced by dq and du, realize the state 
+// derivatives there, and put y back. Displacing only u leaves the earlier
+// stages realized. udot is the part of ydot we need.
+bool CPodesIntegratorRep::realizeDisplacedDerivatives
+   (const Vector& y, const Vector& dq, const Vector& du, Vector& udot)
+{
+    const System& system = getSystem();
+    State& advanced = updAdvancedState();
+    const int nq = advanced.getNQ(), nu = advanced.getNU();
+    const bool moveQ = dq.size() != 0;
+    if (moveQ) advanced.updQ() = y(0,nq) + dq;
+    advanced.updU() = y(nq,nu) + du;
+
+    bool success = true;
+    try {
+        system.realize(advanced, Stage::Time);
+        system.prescribeQ(advanced); // set q_p
+        system.realize(advanced, Stage::Position);
+        system.prescribeU(advanced); // set u_p
+        realizeStateDerivatives(advanced);
+        udot = advanced.getUDot();
+    }
+    catch(...) { success = false; }
+
+    if (moveQ) advanced.updQ() = y(0,nq);
+    advanced.updU() = y(nq,nu);
+    return success;
+}
+
+// Estimate the diagonals of the generalized force derivatives df/du (the
+// damping) and df/dq*N (the stiffness) at (t,y), keeping only the parts 
+// that resist motion, so that both are nonnegative. Forces are recovered
+// from accelerations with the mass matrix. The u's are perturbed in
+// NumColors groups of every NumColors'th u, which separates the u's of
+// neighboring bodies in a chain; what a u picks up from others in its group
+// only makes the preconditioner less accurate.
+bool CPodesIntegratorRep::estimateDiagonalForceDerivatives
+   (Real t, const Vector& y)
+{
+    const int NumColors = 12;
+    const System& system = getSystem();
+    const int nq = precState.getNQ(), nu = precState.getNU();
+    try {
+        setAdvancedStateAndRealizeDerivatives(t,y);
+    }
+    catch(...) { return false; }
+    const Vector y0 = getAdvancedState().getY(); // includes prescribed q's
+    const Vector udot0 = getAdvancedState().getUDot();
+
+    Vector ewt(y0.size());
+    cpodes->getErrWeights(ewt);
+    const Real srur = std::sqrt(Eps);
+
+    precDamping.resize(nu); precStiffness.resize(nu);
+    const Vector noQ;
+    Vector du(nu), dq(nq), udot(nu), dudot(nu), df(nu);
+    for (int c=0; c < std::min(nu, NumColors); ++c) {
+        du = 0;
+        for (int j=c; j < nu; j += NumColors)
+            du[j] = srur*std::max(std::abs(y0[nq+j]), 1/ewt[nq+j]);
+
+        if (!realizeDisplacedDerivatives(y0, noQ, du, udot)) return false;
+        dudot = udot - udot0;
+        system.multiplyByM(precState, dudot, df);
+        for (int j=c; j < nu; j += NumColors)
+            precDamping[j] = std::max(Real(0), -df[j]/du[j]);
+
+        system.multiplyByN(precState, du, dq);
+        if (!realizeDisplacedDerivatives(y0, dq, 0*du, udot)) return false;
+        dudot = udot - udot0;
+        system.multiplyByM(precState, dudot, df);
+        for (int j=c; j < nu; j += NumColors)
+            precStiffness[j] = std::max(Real(0), -df[j]/du[j]);
+    }
+    return true;
+}
+
+// Solve P*z = r where P approximates I - gamma*J. We know dqdot/du = N(q)
+// exactly. If the System has a mass matrix M, we write the u rows of J as
+// M^-1 times force derivatives Fq and Fu and approximate those by the 
+// diagonal estimates above, Fu ~ -C and Fq*N ~ -K. Eliminating z_q gives
+//     (M + D) z_u = M r_u - gamma*K*pinv(N)*r_q,   D = gamma*C + gamma^2*K
+// which the System solves in O(n) with its articulated body algorithm:
+//     z_u = r_u - (M + D)^-1 (D r_u + gamma*K*pinv(N)*r_q)
+//     z_q = r_q + gamma*N*z_u
+// and z_z = r_z. Without a mass matrix this reduces to z_u = r_u. We keep a
+// separate State realized through Position at the current q's so that the 
+// Krylov solver's trial evaluations of f don't disturb it. The estimates
+// are renewed every 20 steps and after a Newton convergence failure.
+int CPodesIntegratorRep::solveNewtonPreconditioner
+   (Real t, const Vector& y, const Vector& r, Vector& z, Real gamma)
+{
+    const int MaxStepsPerEstimate = 20;
+    const System& system = getSystem();
+    const int nq = precState.getNQ(), nu = precState.getNU();
+    bool sameQ = true;
+    for (int i=0; sameQ && i < nq; ++i)
+        sameQ = (precState.getQ()[i] == y[i]);
+    if (!sameQ) {
+        precState.updQ() = y(0,nq);
+        try {
+            system.realize(precState, Stage::Position);
+        }
+        catch(...) { return CPodes::RecoverableError; } // assume recoverable
+    }
+
+    z = r;
+    if (precHasMassMatrix && nu > 0) {
+        int steps = 0, convFailures = 0;
+        cpodes->getNumSteps(&steps);
+        cpodes->getNumNonlinSolvConvFails(&convFailures);
+        if (precDamping.size() != nu 
+            || steps - precStepsAtEstimate >= MaxStepsPerEstimate
+            || convFailures != precConvFailuresAtEstimate) 
+        {
+            const Vector zeroU(nu, Real(0));
+            Vector Mu(nu);
+            precHasMassMatrix = system.multiplyByM(precState, zeroU, Mu);
+            if (precHasMassMatrix 
+                && !estimateDiagonalForceDerivatives(t, y))
+                return CPodes::RecoverableError;
+            precStepsAtEstimate = steps;
+            precConvFailuresAtEstimate = convFailures;
+        }
+    }
+    if (precHasMassMatrix && nu > 0) {
+        const Vector& C = precDamping;
+        const Vector& K = precStiffness;
+        Vector d(nu), rhs(nu), NPInvRq(nu), w(nu);
+        system.multiplyByNPInv(precState, r(0,nq), NPInvRq);
+        for (int j=0; j < nu; ++j) {
+            d[j] = gamma*C[j] + gamma*gamma*K[j];
+            rhs[j] = d[j]*r[nq+j] + gamma*K[j]*NPInvRq[j];
+        }
+        system.multiplyByMPlusDInv(precState, d, rhs, w);
+        z(nq,nu) -= w;
+    }
+
+    Vector Nz(nq);
+    system.multiplyByN(precState, z(nq,nu), Nz);
+    z(0,nq) += gamma*Nz;
+    return CPodes::Success;
+}
+
 void CPodesIntegratorRep::setOrderLimit(int order) {
     cpodes->setMaxOrd(order);
 }
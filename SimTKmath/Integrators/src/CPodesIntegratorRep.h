@@ -63,19 +63,36 @@ public:
     int getMethodMaxOrder() const override;
     bool methodHasErrorControl() const override;
     void setUseCPodesProjection();
+    void setUseKrylovSolver(bool useKrylov);
+    void setUseKrylovPreconditioner(bool usePreconditioner);
+    int getNumKrylovIterations() const;
     void setOrderLimit(int order);
+    int solveNewtonPreconditioner(Real t, const Vector& y, const Vector& r, 
+                                  Vector& z, Real gamma);
     class CPodesSystemImpl;
     friend class CPodesSystemImpl;
 private:
     CPodes* cpodes;
     CPodesSystemImpl* cps;
     bool initialized, useCpodesProjection;
+    bool useKrylovSolver, useKrylovPreconditioner, krylovSolverInitPending;
     int statsStepsTaken, statsErrorTestFailures, statsConvergenceTestFailures;
-    int statsIterations;
+    int statsIterations, statsKrylovIterations;
     int pendingReturnCode;
     Real previousStartTime, previousTimeReturned;
     Vector savedY;
     CPodes::LinearMultistepMethod method;
+    // For the Krylov solver's preconditioner; realized through Position at
+    // the q's where N and M were last needed. If the System has a mass 
+    // matrix we also keep estimates of the generalized damping and stiffness
+    // on the diagonal, in force units; they are empty until first needed.
+    State precState;
+    bool precHasMassMatrix;
+    Vector precDamping, precStiffness;
+    int precStepsAtEstimate, precConvFailuresAtEstimate;
+    bool estimateDiagonalForceDerivatives(Real t, const Vector& y);
+    bool realizeDisplacedDerivatives(const Vector& y, const Vector& dq,
+                                     const Vector& du, Vector& udot);
     void init(CPodes::LinearMultistepMethod method, CPodes::NonlinearSystemIterationType iterationType);
 };
 
@@ -0,0 +1,232 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** @file
+ * This is the private (library side) implementation of the Simmath
+ * EnsembleRunner class.
+ */
+
+#include "SimTKcommon.h"
+#include "simmath/EnsembleRunner.h"
+#include "simmath/TimeStepper.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SimTK {
+
+    ////////////////////////////////
+    // CLASS ENSEMBLE RUNNER REP  //
+    ////////////////////////////////
+
+class EnsembleRunnerRep : public ParallelExecutor::Task {
+public:
+    EnsembleRunnerRep(const System& system,
+                      const EnsembleRunner::IntegratorFactory& factory)
+    :   system(system), factory(factory), finalTime(Infinity),
+        reportInterval(Infinity), initialStates(nullptr),
+        finalStates(nullptr), nextMember(0)
+    {   setNumberOfThreads(ParallelExecutor::getNumProcessors()); }
+
+    void setNumberOfThreads(int numThreads) {
+        SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, "EnsembleRunner",
+            "setNumberOfThreads",
+            "Number of threads must be positive but was %d.", numThreads);
+        if (numThreads == 1) executor.reset();
+        else executor.reset(new ParallelExecutor(numThreads));
+        integrators.resize(numThreads);
+    }
+
+    int getNumberOfThreads() const
+    {   return executor ? executor->getMaxThreads() : 1; }
+
+    void run(const ArrayViewConst_<State>& initial, Array_<State>& final) {
+        SimTK_APIARGCHECK_ALWAYS(finalTime < Infinity 
+                                 || (stopCondition && reportInterval < Infinity),
+            "EnsembleRunner", "run", "A finite final time, or a stop "
+            "condition and finite report interval, must be supplied.");
+
+        const int nMembers = (int)initial.size();
+        final.resize(nMembers);
+        terminationReasons.assign(nMembers,
+                                  Integrator::InvalidTerminationReason);
+        stoppedByCondition.assign(nMembers, false);
+        errors.assign(nMembers, std::exception_ptr());
+        initialStates = &initial;
+        finalStates = &final;
+        nextMember = 0;
+
+        const int nWorkers = std::min(getNumberOfThreads(), nMembers);
+        if (nWorkers < 2) execute(0);
+        else executor->execute(*this, nWorkers);
+
+        initialStates = nullptr;
+        finalStates = nullptr;
+        for (const std::exception_ptr& error : errors)
+            if (error) std::rethrow_exception(error);
+    }
+
+    // Each worker claims the next unsimulated member until there are none
+    // left, using its own Integrator throughout.
+    void execute(int worker) override {
+        const int nMembers = (int)initialStates->size();
+        int member;
+        while ((member = nextMember++) < nMembers) {
+            try {
+                if (!integrators[worker])
+                    integrators[worker].reset(factory(system));
+                simulate(member, *integrators[worker]);
+            } catch (...) {
+                errors[member] = std::current_exception();
+            }
+        }
+    }
+
+    void simulate(int member, Integrator& integ) {
+        if (finalTime < Infinity)
+            integ.setFinalTime(finalTime);
+        TimeStepper ts(system, integ);
+        ts.initialize((*initialStates)[member]);
+        report(member, ts.getState());
+
+        while (!integ.isSimulationOver() && ts.getTime() < finalTime) {
+            ts.stepTo(std::min(finalTime, ts.getTime() + reportInterval));
+            report(member, ts.getState());
+            if (stopCondition && stopCondition(member, ts.getState())) {
+                stoppedByCondition[member] = true;
+                break;
+            }
+        }
+
+        // The Integrator may not consider the simulation over yet if it
+        // landed exactly on the final time.
+        if (integ.isSimulationOver())
+            terminationReasons[member] = integ.getTerminationReason();
+        else if (ts.getTime() >= finalTime)
+            terminationReasons[member] = Integrator::ReachedFinalTime;
+        (*finalStates)[member] = ts.getState();
+    }
+
+    void report(int member, const State& state) {
+        if (!reporter) return;
+        std::lock_guard<std::mutex> guard(reporterLock);
+        reporter(member, state);
+    }
+
+private:
+    friend class EnsembleRunner;
+
+    const System&                           system;
+    EnsembleRunner::IntegratorFactory       factory;
+    EnsembleRunner::StopCondition           stopCondition;
+    EnsembleRunner::Reporter                reporter;
+    Real                                    finalTime;
+    Real                                    reportInterval;
+
+    // One Integrator per worker, created when first needed and kept for
+    // later runs.
+    std::unique_ptr<ParallelExecutor>       executor;
+    std::vector<std::unique_ptr<Integrator>> integrators;
+
+    // These are valid only during run().
+    const ArrayViewConst_<State>*           initialStates;
+    Array_<State>*                          finalStates;
+    std::atomic<int>                        nextMember;
+    std::mutex                              reporterLock;
+    Array_<std::exception_ptr>              errors;
+
+    // Results of the most recent run().
+    Array_<Integrator::TerminationReason>   terminationReasons;
+    Array_<bool>                            stoppedByCondition;
+};
+
+    ///////////////////////////////////////
+    // IMPLEMENTATION OF ENSEMBLE RUNNER //
+    ///////////////////////////////////////
+
+EnsembleRunner::EnsembleRunner(const System& system,
+                               const IntegratorFactory& factory) {
+    SimTK_APIARGCHECK_ALWAYS(system.systemTopologyHasBeenRealized(),
+        "EnsembleRunner", "EnsembleRunner",
+        "The System's topology must be realized first.");
+    SimTK_APIARGCHECK_ALWAYS(bool(factory), "EnsembleRunner",
+        "EnsembleRunner", "An Integrator factory must be supplied.");
+    rep = new EnsembleRunnerRep(system, factory);
+}
+
+EnsembleRunner::~EnsembleRunner() {
+    delete rep;
+    rep = 0;
+}
+
+void EnsembleRunner::setFinalTime(Real tFinal) {
+    SimTK_APIARGCHECK1_ALWAYS(!isNaN(tFinal), "EnsembleRunner",
+        "setFinalTime", "Final time was %g.", tFinal);
+    rep->finalTime = tFinal;
+}
+
+Real EnsembleRunner::getFinalTime() const {return rep->finalTime;}
+
+void EnsembleRunner::setReportInterval(Real interval) {
+    SimTK_APIARGCHECK1_ALWAYS(interval > 0, "EnsembleRunner",
+        "setReportInterval",
+        "Report interval must be positive but was %g.", interval);
+    rep->reportInterval = interval;
+}
+
+Real EnsembleRunner::getReportInterval() const {return rep->reportInterval;}
+
+void EnsembleRunner::setStopCondition(const StopCondition& stopCondition)
+{   rep->stopCondition = stopCondition; }
+
+void EnsembleRunner::setReporter(const Reporter& reporter)
+{   rep->reporter = reporter; }
+
+void EnsembleRunner::setNumberOfThreads(int numThreads)
+{   rep->setNumberOfThreads(numThreads); }
+
+int EnsembleRunner::getNumberOfThreads() const
+{   return rep->getNumberOfThreads(); }
+
+void EnsembleRunner::run(const ArrayViewConst_<State>& initialStates,
+                         Array_<State>& finalStates)
+{   rep->run(initialStates, finalStates); }
+
+Integrator::TerminationReason EnsembleRunner::
+getTerminationReason(int member) const {
+    SimTK_INDEXCHECK_ALWAYS(member, (int)rep->terminationReasons.size(),
+        "EnsembleRunner::getTerminationReason()");
+    return rep->terminationReasons[member];
+}
+
+bool EnsembleRunner::wasStoppedByCondition(int member) const {
+    SimTK_INDEXCHECK_ALWAYS(member, (int)rep->stoppedByCondition.size(),
+        "EnsembleRunner::wasStoppedByCondition()");
+    return rep->stoppedByCondition[member];
+}
+
+} // namespace SimTK
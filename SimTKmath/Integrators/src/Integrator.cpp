@@ -294,6 +294,9 @@ void Integrator::setAllowInterpolation(bool shouldInterpolate) {
 void Integrator::setProjectInterpolatedStates(bool shouldProject) {
     updRep().userProjectInterpolatedStates = shouldProject ? 1 : 0;
 }
+void Integrator::setLocalizeEventsByInterpolation(bool shouldUseInterpolant) {
+    updRep().userLocalizeEventsByInterpolation = shouldUseInterpolant ? 1 : 0;
+}
 
 bool Integrator::methodHasErrorControl() const {
     return getRep().methodHasErrorControl();
@@ -711,6 +711,7 @@ protected:
     int  userAllowInterpolation;        //      "
     int  userProjectInterpolatedStates; //      "
     int  userForceFullNewton;           //      "
+    int  userLocalizeEventsByInterpolation; // "
 
     // Mark all user-supplied options "not supplied by user".
     void initializeUserStuff() {
@@ -722,7 +723,8 @@ protected:
         // booleans
         userUseInfinityNorm = userReturnEveryInternalStep = 
             userProjectEveryStep = userAllowInterpolation = 
-            userProjectInterpolatedStates = userForceFullNewton = -1;
+            userProjectInterpolatedStates = userForceFullNewton = 
+            userLocalizeEventsByInterpolation = -1;
 
         accuracyInUse = NaN;
         consTol  = NaN;
@@ -0,0 +1,339 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** @file
+ * This is the private (library side) implementation of the 
+ * MultirateIntegrator and MultirateIntegratorRep classes.
+ */
+
+#include "SimTKcommon.h"
+#include "simmath/Integrator.h"
+#include "simmath/MultirateIntegrator.h"
+
+#include "IntegratorRep.h"
+#include "MultirateIntegratorRep.h"
+
+#include <exception>
+#include <limits>
+
+using namespace SimTK;
+
+//------------------------------------------------------------------------------
+//                          MULTIRATE INTEGRATOR
+//------------------------------------------------------------------------------
+
+MultirateIntegrator::MultirateIntegrator(const System& sys) 
+{
+    rep = new MultirateIntegratorRep(this, sys);
+}
+
+void MultirateIntegrator::addFastSubsystem(SubsystemIndex subsys) {
+    MultirateIntegratorRep& mrep = dynamic_cast<MultirateIntegratorRep&>(*rep);
+    mrep.addFastSubsystem(subsys);
+}
+
+void MultirateIntegrator::addFastZ(SystemZIndex z) {
+    MultirateIntegratorRep& mrep = dynamic_cast<MultirateIntegratorRep&>(*rep);
+    mrep.addFastZ(z);
+}
+
+void MultirateIntegrator::setFastDerivativeStage(Stage stage) {
+    MultirateIntegratorRep& mrep = dynamic_cast<MultirateIntegratorRep&>(*rep);
+    mrep.setFastDerivativeStage(stage);
+}
+
+int MultirateIntegrator::getNumSubsteps() const {
+    const MultirateIntegratorRep& mrep = 
+        dynamic_cast<const MultirateIntegratorRep&>(*rep);
+    return mrep.getNumSubsteps();
+}
+
+//------------------------------------------------------------------------------
+//                         MULTIRATE INTEGRATOR REP
+//------------------------------------------------------------------------------
+
+MultirateIntegratorRep::MultirateIntegratorRep
+   (Integrator* handle, const System& sys) 
+:   AbstractIntegratorRep(handle, sys, 3, 3, "Multirate",  true),
+    fastDerivativeStage(Stage::Acceleration), hFast(Infinity), 
+    statsSubsteps(0), tStart(NaN), tPrevStart(NaN) {
+}
+
+void MultirateIntegratorRep::addFastSubsystem(SubsystemIndex subsys) {
+    fastSubsystems.push_back(subsys);
+}
+
+void MultirateIntegratorRep::addFastZ(SystemZIndex z) {
+    userFastZ.push_back(z);
+}
+
+void MultirateIntegratorRep::setFastDerivativeStage(Stage stage) {
+    SimTK_APIARGCHECK1_ALWAYS
+       (Stage::Dynamics <= stage && stage <= Stage::Acceleration,
+        "MultirateIntegrator", "setFastDerivativeStage",
+        "Stage %s is not allowed; it must be Dynamics or Acceleration.",
+        stage.getName().c_str());
+    fastDerivativeStage = stage;
+}
+
+// Translate the user's designations into a list of fast z's now that we know
+// how many z's each Subsystem has.
+void MultirateIntegratorRep::methodInitialize(const State& state) {
+    const int nz = state.getNZ();
+    Array_<bool> isFast(nz, false);
+    for (unsigned i=0; i < fastSubsystems.size(); ++i) {
+        const SubsystemIndex subsys = fastSubsystems[i];
+        SimTK_ERRCHK2_ALWAYS(0 <= subsys && subsys < state.getNumSubsystems(),
+            "MultirateIntegrator::initialize()",
+            "Fast Subsystem index %d is out of range; there are %d "
+            "Subsystems.", (int)subsys, state.getNumSubsystems());
+        const int zStart = state.getZStart(subsys);
+        for (int k=0; k < state.getNZ(subsys); ++k)
+            isFast[zStart+k] = true;
+    }
+    for (unsigned i=0; i < userFastZ.size(); ++i) {
+        const SystemZIndex z = userFastZ[i];
+        SimTK_ERRCHK2_ALWAYS(0 <= z && z < nz,
+            "MultirateIntegrator::initialize()",
+            "Fast z index %d is out of range; there are %d z's.", (int)z, nz);
+        isFast[z] = true;
+    }
+    fastZ.clear();
+    for (int k=0; k < nz; ++k)
+        if (isFast[k]) fastZ.push_back(k);
+
+    hFast = Infinity; // start with the fewest substeps and adapt
+    statsSubsteps = 0;
+    tStart = tPrevStart = NaN;
+    AbstractIntegratorRep::methodInitialize(state);
+}
+
+// An event handler may have changed the state discontinuously so we can't 
+// extrapolate from derivatives calculated before the event.
+void MultirateIntegratorRep::methodReinitialize
+   (Stage stage, bool shouldTerminate) {
+    if (stage < Stage::Report)
+        tStart = tPrevStart = NaN;
+}
+
+// Realize Acceleration stage unless we've been told the fast z derivatives
+// are available earlier.
+void MultirateIntegratorRep::realizeFastDerivatives(State& s) const {
+    if (fastDerivativeStage == Stage::Acceleration) {
+        realizeStateDerivatives(s);
+        return;
+    }
+    if (s.getSystemStage() < fastDerivativeStage) {
+        ++statsRealizations; ++statsRealizationFailures;
+        getSystem().realize(s, fastDerivativeStage);
+        --statsRealizationFailures;
+    }
+}
+
+// Each substep applies the Runge-Kutta 3(2) method of RungeKutta3Integrator
+// to the fast z's only. Realizing the system after changing only z's doesn't
+// repeat any kinematics (and may not need Acceleration stage), so we want to
+// change time and the slow states just once per substep. Let F_t(z) be the
+// fast z derivatives with time and the slow states at time t. At the start of
+// a substep from t the system holds the slow states for t, so k1=F_t(z) is 
+// cheap. Then we move to t+hf with z unchanged, which gives the rate 
+// d=(F_t+hf(z)-k1)/hf at which the slow states are changing the fast 
+// derivatives. The remaining stages are cheap evaluations of F_t+hf, 
+// corrected linearly back to the stage time. A rejected substep is retried
+// from the same k1, so costs only its last three evaluations. The substeps
+// are error controlled individually, and end exactly at the slow stage 
+// times t0+h/2 and t0+h.
+bool MultirateIntegratorRep::advanceFastStates(Real t0, Real h) {
+    const Vector& y0 = getPreviousY();
+    const Vector& f0 = getPreviousYDot();
+    const Vector& zScale = getPreviousZScale();
+    const int nf = (int)fastZ.size();
+    const int zOffset = y0.size() - getAdvancedState().getNZ();
+    const Real accuracy = getAccuracyInUse();
+    const Real tMid = t0 + h/2, t1 = t0 + h;
+    State& advanced = updAdvancedState();
+
+    // Slow states are extrapolated with a quadratic if we know the 
+    // derivative at the start of the previous step, otherwise linearly.
+    Vector& ydotdot = ytmp[1];
+    if (isFinite(tPrevStart) && tPrevStart < t0)
+        ydotdot = (f0 - fPrevStart) / (t0 - tPrevStart);
+    else ydotdot = Vector(y0.size(), Real(0));
+
+    Vector zf(nf), k1(nf), k2(nf), d(nf), z1(nf), err(nf);
+    for (int i=0; i < nf; ++i) {
+        zf[i] = y0[zOffset + fastZ[i]];
+        k1[i] = f0[zOffset + fastZ[i]]; // fast part of f0 is F_t0(z0)
+    }
+    zFastErr.resize(nf); zFastErr = 0;
+
+    Vector& y = ytmp[2];
+    Real t = t0;
+    Real hf = std::min(hFast, h/2);
+    int nSubsteps = 0;
+    while (t < t1) {
+        if (++nSubsteps > MaxSubsteps)
+            return false;
+
+        // Don't step past the next slow stage time, and don't leave a 
+        // sliver in front of it.
+        const Real tStop = t < tMid ? tMid : t1;
+        const bool isLimited = (t + Real(1.1)*hf >= tStop);
+        if (isLimited) hf = tStop - t;
+        const Real tNext = isLimited ? tStop : t + hf;
+
+        const Real tau = tNext - t0;
+        y = y0 + tau*f0 + (tau*tau/2)*ydotdot;
+        for (int i=0; i < nf; ++i)
+            y[zOffset + fastZ[i]] = zf[i];
+        setAdvancedState(tNext, y);
+        getSystem().realize(advanced, Stage::Time);
+        getSystem().prescribeQ(advanced);
+        getSystem().realize(advanced, Stage::Position);
+        getSystem().prescribeU(advanced);
+        realizeFastDerivatives(advanced);
+
+        for (int i=0; i < nf; ++i) {
+            d[i] = (advanced.getZDot()[fastZ[i]] - k1[i]) / hf;
+            advanced.updZ()[fastZ[i]] = zf[i] + (hf/2)*k1[i];
+        }
+        realizeFastDerivatives(advanced);
+
+        for (int i=0; i < nf; ++i) {
+            k2[i] = advanced.getZDot()[fastZ[i]] - (hf/2)*d[i];
+            advanced.updZ()[fastZ[i]] = zf[i] + hf*(2*k2[i]-k1[i]);
+        }
+        realizeFastDerivatives(advanced);
+
+        Real errNorm = 0;
+        for (int i=0; i < nf; ++i) {
+            const Real k3 = advanced.getZDot()[fastZ[i]];
+            z1[i]  = zf[i] + (hf/6)*(k1[i] + 4*k2[i] + k3);
+            err[i] = std::abs(z1[i] - (zf[i] + hf*k2[i]));
+            errNorm = std::max(errNorm, err[i]*zScale[fastZ[i]]);
+        }
+        ++statsSubsteps;
+
+        if (!isFinite(errNorm) || errNorm > accuracy) {
+            hf *= isFinite(errNorm) 
+                ? std::max(Real(0.1), Real(0.9)*std::cbrt(accuracy/errNorm))
+                : Real(0.1);
+            if (hf <= SignificantReal*std::max(Real(1), std::abs(t)))
+                return false;
+            continue; // k1 is still good
+        }
+
+        // Accept the substep and get k1 for the next one.
+        t = tNext; zf = z1;
+        for (int i=0; i < nf; ++i)
+            zFastErr[i] = std::max(zFastErr[i], err[i]);
+        if (t == tMid) zFastMid = zf;
+        // A substep shortened to hit a stage time says little about how 
+        // big the next one could be, so it can only make hFast grow.
+        const Real hNew = hf * (errNorm == 0 ? Real(5)
+            : std::min(Real(5), Real(0.9)*std::cbrt(accuracy/errNorm)));
+        hFast = isLimited ? std::max(hFast, hNew) : hNew;
+        hf = hFast;
+        if (t < t1) {
+            for (int i=0; i < nf; ++i)
+                advanced.updZ()[fastZ[i]] = zf[i];
+            realizeFastDerivatives(advanced);
+            for (int i=0; i < nf; ++i)
+                k1[i] = advanced.getZDot()[fastZ[i]];
+        }
+    }
+    zFastEnd = zf;
+    return true;
+}
+
+// The slow states use the Runge-Kutta 3(2) method of RungeKutta3Integrator;
+// see that integrator for a discussion. Its stages are at t0, t0+h/2 and t1,
+// where the fast substeps have left their results. We call the initial state
+// (t0,y0) and want (t0+h,y1). We are given the initial derivative 
+// f0=f(t0,y0), which most likely is left over from an evaluation at the end
+// of the last step.
+bool MultirateIntegratorRep::attemptODEStep
+   (Real t1, Vector& y1err, int& errOrder, int& numIterations)
+{
+    const Real t0 = getPreviousTime();
+    assert(t1 > t0);
+
+    statsStepsAttempted++;
+    errOrder = 3;
+    const Vector& y0 = getPreviousY();
+    const Vector& f0 = getPreviousYDot();
+    if (ytmp[0].size() != y0.size())
+        for (int i=0; i<NTemps; ++i)
+            ytmp[i].resize(y0.size());
+    const int zOffset = y0.size() - getAdvancedState().getNZ();
+    const int nf = (int)fastZ.size();
+
+    const Real h = t1-t0;
+
+    // Remember the starting derivatives of the last two steps (but not of
+    // retries) for extrapolating the slow states.
+    if (t0 != tStart) {
+        tPrevStart = tStart; fPrevStart = fStart;
+        tStart = t0;         fStart = f0;
+    }
+
+    // Advance the fast states first. If they can't be advanced accurately
+    // with a reasonable number of substeps, reject the step.
+    if (nf && !advanceFastStates(t0, h))
+        return false;
+
+    Vector& f1 = ytmp[0]; // rename temps
+    Vector& f2 = ytmp[1];
+    Vector& y  = ytmp[2];
+
+    y = y0 + (h/2)*f0;
+    for (int i=0; i < nf; ++i)
+        y[zOffset + fastZ[i]] = zFastMid[i];
+    setAdvancedStateAndRealizeDerivatives(t0+h/2, y);
+    f1 = getAdvancedState().getYDot();
+
+    y = y0 + h*(2*f1-f0);
+    for (int i=0; i < nf; ++i)
+        y[zOffset + fastZ[i]] = zFastEnd[i];
+    setAdvancedStateAndRealizeDerivatives(t1, y);
+    f2 = getAdvancedState().getYDot();
+
+    // Final value. The slow states are 3rd order accurate; the fast ones
+    // come from the substeps. Evaluate through kinematics only; it is a 
+    // waste of a stage to evaluate derivatives here since the caller will 
+    // muck with this before the end of the step.
+    y = y0 + (h/6)*(f0 + 4*f1 + f2);
+    for (int i=0; i < nf; ++i)
+        y[zOffset + fastZ[i]] = zFastEnd[i];
+    setAdvancedStateAndRealizeKinematics(t1, y);
+
+    // The slow error estimate is the difference from the embedded 2nd order 
+    // explicit midpoint method; the fast one is the worst substep error.
+    const Vector& y1 = getAdvancedState().getY();
+    for (int i=0; i<y1.size(); ++i)
+        y1err[i] = std::abs(y1[i]-(y0[i] + h*f1[i]));
+    for (int i=0; i < nf; ++i)
+        y1err[zOffset + fastZ[i]] = zFastErr[i];
+
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef SimTK_SIMMATH_MULTIRATE_INTEGRATOR_REP_H_
+#define SimTK_SIMMATH_MULTIRATE_INTEGRATOR_REP_H_
+
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "AbstractIntegratorRep.h"
+
+namespace SimTK {
+
+/**
+ * This is the private (library side) implementation of the 
+ * MultirateIntegratorRep class which is a concrete class
+ * implementing the abstract IntegratorRep.
+ */
+
+class MultirateIntegratorRep : public AbstractIntegratorRep {
+public:
+    MultirateIntegratorRep(Integrator* handle, const System& sys);
+    void addFastSubsystem(SubsystemIndex subsys);
+    void addFastZ(SystemZIndex z);
+    void setFastDerivativeStage(Stage stage);
+    int getNumSubsteps() const {return statsSubsteps;}
+protected:
+    void methodInitialize(const State&) override;
+    void methodReinitialize(Stage stage, bool shouldTerminate) override;
+    bool attemptODEStep
+       (Real t1, Vector& yErrEst, int& errOrder, int& numIterations) override;
+private:
+    // Advance the fast z's from t0 to t0+h in error-controlled substeps,
+    // leaving their values at t0+h/2 and t0+h in zFastMid and zFastEnd, and
+    // the largest error of any substep in zFastErr. Returns false if that
+    // can't be done in a reasonable number of substeps.
+    bool advanceFastStates(Real t0, Real h);
+    // Realize the advanced state far enough to get the fast z derivatives.
+    void realizeFastDerivatives(State& s) const;
+
+    static const int MaxSubsteps = 1000;
+
+    // As designated by the user.
+    Array_<SubsystemIndex>  fastSubsystems;
+    Array_<SystemZIndex>    userFastZ;
+    Stage                   fastDerivativeStage;
+
+    // Resolved at initialization: indices into z of the fast states.
+    Array_<int>             fastZ;
+    Real                    hFast;  // substep size to try next
+    int                     statsSubsteps;
+
+    // Derivatives at the start of this step and the previous one, used to 
+    // extrapolate the slow states during the fast substeps.
+    Real                    tStart, tPrevStart;
+    Vector                  fStart, fPrevStart;
+
+    static const int NTemps = 3;
+    Vector                  ytmp[NTemps];
+    Vector                  zFastMid, zFastEnd, zFastErr;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMMATH_MULTIRATE_INTEGRATOR_REP_H_
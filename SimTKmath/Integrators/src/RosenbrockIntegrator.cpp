@@ -0,0 +1,233 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/** @file
+ * This is the private (library side) implementation of the 
+ * RosenbrockIntegrator and RosenbrockIntegratorRep classes.
+ */
+
+#include "SimTKcommon.h"
+#include "simmath/Integrator.h"
+#include "simmath/RosenbrockIntegrator.h"
+
+#include "IntegratorRep.h"
+#include "RosenbrockIntegratorRep.h"
+
+#include <exception>
+#include <limits>
+
+using namespace SimTK;
+
+//------------------------------------------------------------------------------
+//                          ROSENBROCK INTEGRATOR
+//------------------------------------------------------------------------------
+
+RosenbrockIntegrator::RosenbrockIntegrator(const System& sys) 
+{
+    rep = new RosenbrockIntegratorRep(this, sys);
+}
+
+//------------------------------------------------------------------------------
+//                        ROSENBROCK INTEGRATOR REP
+//------------------------------------------------------------------------------
+
+// This is the ROS34PW2 method of Rang & Angermann (BIT 45:761-787, 2005),
+// given in the usual Rosenbrock form
+//
+//   (I - h gamma J) k_i = h f(t0 + alpha_i h, y0 + sum_j alpha_ij k_j)
+//                         + h J sum_j gamma_ij k_j
+//   y1 = y0 + sum_i b_i k_i,   y1hat = y0 + sum_i bhat_i k_i
+//
+// where J need only approximate df/dy (a "W-method"); order 3 is retained 
+// for any J. No df/dt term is needed for the same reason. To avoid the
+// multiplication by J we use the transformed variables U_i = sum_j Gamma_ij 
+// k_j (Hairer & Wanner, Solving ODEs II, 2nd ed., section IV.7) for which
+//
+//   (I/(h gamma) - J) U_i = f(t0 + alpha_i h, y0 + sum_j a_ij U_j)
+//                           + sum_j (c_ij/h) U_j
+//   y1 = y0 + sum_i m_i U_i
+//
+// with a = A Gamma^-1, C = diag(1/gamma) - Gamma^-1, m = b Gamma^-1. Here
+// Gamma is lower triangular with gamma on its diagonal. We compute the 
+// transformed coefficients once from the published tables.
+RosenbrockIntegratorRep::RosenbrockIntegratorRep
+   (Integrator* handle, const System& sys) 
+:   AbstractIntegratorRep(handle, sys, 3, 3, "Rosenbrock",  true),
+    tJacobian(NaN), hFactored(NaN), tLastAttempt(NaN), stepsSinceJacobian(0)
+{
+    gamma = 0.43586652150845900;
+    const Real A[NStages][NStages] = {
+        {0,                     0,                     0, 0},
+        {0.87173304301691801,   0,                     0, 0},
+        {0.84457060015369423,  -0.11299064236484185,   0, 0},
+        {0,                     0,                     1, 0}};
+    const Real G[NStages][NStages] = {
+        {gamma,                 0,                     0,     0},
+        {-0.87173304301691801,  gamma,                 0,     0},
+        {-0.90338057013044082,  0.054180672388095326,  gamma, 0},
+        {0.24212380706095346,  -1.2232505839045147, 
+                                0.54526025533510214,          gamma}};
+    const Real b[NStages] = {0.24212380706095346, -1.2232505839045147,
+                             1.5452602553351020,   0.43586652150845900};
+    const Real bhat[NStages] = {0.37810903145819369, -0.096042292212423178,
+                                0.5,                  0.21793326075422950};
+
+    // Invert the lower triangular Gamma by forward substitution.
+    Real Ginv[NStages][NStages];
+    for (int j=0; j < NStages; ++j)
+        for (int i=0; i < NStages; ++i) {
+            if (i < j) {Ginv[i][j] = 0; continue;}
+            Real sum = (i==j ? Real(1) : Real(0));
+            for (int k=j; k < i; ++k) sum -= G[i][k]*Ginv[k][j];
+            Ginv[i][j] = sum/G[i][i];
+        }
+
+    for (int i=0; i < NStages; ++i) {
+        alpha[i] = 0;
+        for (int j=0; j < NStages; ++j) {
+            alpha[i] += A[i][j];
+            a[i][j] = 0;
+            for (int k=0; k < NStages; ++k) a[i][j] += A[i][k]*Ginv[k][j];
+            c[i][j] = (i==j ? 1/gamma : Real(0)) - Ginv[i][j];
+        }
+        m[i] = mErr[i] = 0;
+        for (int k=0; k < NStages; ++k) {
+            m[i]    += b[k]*Ginv[k][i];
+            mErr[i] += (b[k]-bhat[k])*Ginv[k][i];
+        }
+    }
+}
+
+void RosenbrockIntegratorRep::methodInitialize(const State& state) {
+    jacobian.clear();
+    tJacobian = hFactored = tLastAttempt = NaN;
+    stepsSinceJacobian = 0;
+    AbstractIntegratorRep::methodInitialize(state);
+}
+
+// An event handler may have changed the system in ways that invalidate the
+// Jacobian, so start over with a new one.
+void RosenbrockIntegratorRep::methodReinitialize
+   (Stage stage, bool shouldTerminate) {
+    if (stage < Stage::Report) {
+        jacobian.clear();
+        tJacobian = hFactored = NaN;
+    }
+}
+
+// Approximate J=df/dy at (t0,y0) one column at a time by forward differences,
+// using an increment proportional to sqrt(eps*|y_j|) as in Hairer & Wanner's 
+// RADAU5. Throws if any evaluation fails.
+void RosenbrockIntegratorRep::calcJacobian
+   (Real t0, const Vector& y0, const Vector& f0)
+{
+    const int ny = y0.size();
+    jacobian.resize(ny, ny);
+    ytmp = y0;
+    for (int j=0; j < ny; ++j) {
+        const Real yj = y0[j];
+        ytmp[j] = yj + std::sqrt(Eps*std::max(Real(1e-5), std::abs(yj)));
+        const Real inc = ytmp[j] - yj; // exactly representable
+        setAdvancedStateAndRealizeDerivatives(t0, ytmp);
+        jacobian(j) = (getAdvancedState().getYDot() - f0) / inc;
+        ytmp[j] = yj;
+    }
+    tJacobian = t0;
+    stepsSinceJacobian = 0;
+}
+
+// We call the initial state (t0,y0) and want (t0+h,y1). We are given the 
+// initial derivative f0=f(t0,y0), which is the first stage evaluation.
+bool RosenbrockIntegratorRep::attemptODEStep
+   (Real t1, Vector& y1err, int& errOrder, int& numIterations)
+{
+    const Real t0 = getPreviousTime();
+    assert(t1 > t0);
+
+    statsStepsAttempted++;
+    errOrder = 3;
+    numIterations = 1; // linearly implicit; no iteration
+    const Vector& y0 = getPreviousY();
+    const Vector& f0 = getPreviousYDot();
+    const int ny = y0.size();
+    const Real h = t1-t0;
+
+    // Reuse the Jacobian from earlier steps unless it is too old, or this is
+    // a retry and the Jacobian wasn't calculated at the start of this step. 
+    const bool isRetry = (t0 == tLastAttempt);
+    if (!isRetry) ++stepsSinceJacobian;
+    tLastAttempt = t0;
+    if (jacobian.nrow() != ny || stepsSinceJacobian >= MaxStepsPerJacobian
+        || (isRetry && tJacobian != t0)) {
+        hFactored = NaN;
+        calcJacobian(t0, y0, f0);
+    }
+
+    if (h != hFactored) {
+        Matrix W = -jacobian;
+        W.updDiag() += 1/(h*gamma);
+        iterationMatrix.factor(W);
+        if (iterationMatrix.isSingular()) {
+            hFactored = NaN;
+            return false;
+        }
+        hFactored = h;
+    }
+
+    for (int i=0; i < NStages; ++i)
+        if (U[i].size() != ny) U[i].resize(ny);
+
+    for (int i=0; i < NStages; ++i) {
+        if (i == 0)
+            rhs = f0;
+        else {
+            ytmp = y0;
+            for (int j=0; j < i; ++j) 
+                if (a[i][j] != 0) ytmp += a[i][j]*U[j];
+            setAdvancedStateAndRealizeDerivatives(t0 + alpha[i]*h, ytmp);
+            rhs = getAdvancedState().getYDot();
+        }
+        for (int j=0; j < i; ++j)
+            rhs += (c[i][j]/h)*U[j];
+        iterationMatrix.solve(rhs, U[i]);
+    }
+
+    // Final value. This is the 3rd order accurate result. Evaluate through 
+    // kinematics only since the caller will muck with this before the end of
+    // the step.
+    ytmp = y0;
+    for (int i=0; i < NStages; ++i)
+        ytmp += m[i]*U[i];
+    setAdvancedStateAndRealizeKinematics(t1, ytmp);
+
+    // The difference from the embedded 2nd order result is the error 
+    // estimate.
+    for (int k=0; k < ny; ++k) {
+        Real err = 0;
+        for (int i=0; i < NStages; ++i)
+            err += mErr[i]*U[i][k];
+        y1err[k] = std::abs(err);
+    }
+
+    return true;
+}
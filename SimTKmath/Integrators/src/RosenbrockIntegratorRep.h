@@ -0,0 +1,70 @@
+#ifndef SimTK_SIMMATH_ROSENBROCK_INTEGRATOR_REP_H_
+#define SimTK_SIMMATH_ROSENBROCK_INTEGRATOR_REP_H_
+
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "simmath/LinearAlgebra.h"
+#include "AbstractIntegratorRep.h"
+
+namespace SimTK {
+
+/**
+ * This is the private (library side) implementation of the 
+ * RosenbrockIntegratorRep class which is a concrete class
+ * implementing the abstract IntegratorRep.
+ */
+
+class RosenbrockIntegratorRep : public AbstractIntegratorRep {
+public:
+    RosenbrockIntegratorRep(Integrator* handle, const System& sys);
+protected:
+    void methodInitialize(const State&) override;
+    void methodReinitialize(Stage stage, bool shouldTerminate) override;
+    bool attemptODEStep
+       (Real t1, Vector& yErrEst, int& errOrder, int& numIterations) override;
+private:
+    // Finite difference approximation to df/dy at the start of the step.
+    void calcJacobian(Real t0, const Vector& y0, const Vector& f0);
+
+    static const int NStages = 4;
+    // Coefficients of the method, transformed so that the stage equations
+    // don't need a multiplication by the Jacobian (see the .cpp file).
+    Real gamma, alpha[NStages], a[NStages][NStages], c[NStages][NStages];
+    Real m[NStages], mErr[NStages];
+
+    // The Jacobian is reused across steps; the iteration matrix is
+    // refactored only when it or the step size changes.
+    static const int MaxStepsPerJacobian = 20;
+    Matrix      jacobian;
+    FactorLU    iterationMatrix;
+    Real        tJacobian, hFactored, tLastAttempt;
+    int         stepsSinceJacobian;
+
+    Vector      U[NStages];
+    Vector      ytmp, rhs;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMMATH_ROSENBROCK_INTEGRATOR_REP_H_
@@ -53,11 +53,14 @@
 #include "simmath/MultibodyGraphMaker.h"
 #include "simmath/Integrator.h"
 #include "simmath/TimeStepper.h"
+#include "simmath/EnsembleRunner.h"
 #include "simmath/CPodesIntegrator.h"
 #include "simmath/RungeKuttaMersonIntegrator.h"
 #include "simmath/RungeKuttaFeldbergIntegrator.h"
 #include "simmath/RungeKutta3Integrator.h"
 #include "simmath/RungeKutta2Integrator.h"
+#include "simmath/RosenbrockIntegrator.h"
+#include "simmath/MultirateIntegrator.h"
 #include "simmath/ExplicitEulerIntegrator.h"
 #include "simmath/VerletIntegrator.h"
 #include "simmath/SemiExplicitEulerIntegrator.h"
@@ -66,6 +66,23 @@ int main () {
         catch (...) {
         }
         
+        // Solve the Newton iterations with the preconditioned Krylov solver
+        // instead of factoring a dense matrix.
+
+        CPodesIntegrator krylovInteg(sys, CPodes::BDF);
+        krylovInteg.setUseKrylovSolver(true);
+        testIntegrator(krylovInteg, sys);
+        ASSERT(krylovInteg.getNumKrylovIterations() > 0);
+
+        // The preconditioner should save Krylov iterations.
+
+        CPodesIntegrator unprecInteg(sys, CPodes::BDF);
+        unprecInteg.setUseKrylovSolver(true);
+        unprecInteg.setUseKrylovPreconditioner(false);
+        testIntegrator(unprecInteg, sys);
+        ASSERT(krylovInteg.getNumKrylovIterations() 
+               < unprecInteg.getNumKrylovIterations());
+        
         // Try having CPODES do the projection instead of the System.
         
         CPodesIntegrator projInteg(sys, CPodes::BDF);
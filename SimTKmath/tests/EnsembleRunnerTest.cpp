@@ -0,0 +1,134 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKmath.h"
+
+#include "PendulumSystem.h"
+
+using namespace SimTK;
+
+// Create initial States for the pendulum starting at different angles.
+static Array_<State> makeInitialStates(const PendulumSystem& sys, int n) {
+    Array_<State> states(n, sys.getDefaultState());
+    for (int i=0; i < n; ++i) {
+        const Real angle = -Pi/2 + (i+1)*Pi/(n+1);
+        states[i].updQ() = Vector(Vec2(std::sin(angle), -std::cos(angle)));
+        states[i].updU() = 0;
+    }
+    return states;
+}
+
+static Integrator* makeIntegrator(const System& sys) {
+    Integrator* integ = new RungeKuttaMersonIntegrator(sys);
+    integ->setAccuracy(1e-6);
+    return integ;
+}
+
+void testEnsembleMatchesSerial() {
+    PendulumSystem sys;
+    sys.realizeTopology();
+    const int NMembers = 13;
+    const Array_<State> initial = makeInitialStates(sys, NMembers);
+
+    EnsembleRunner runner(sys, makeIntegrator);
+    runner.setFinalTime(2);
+    SimTK_TEST_MUST_THROW(runner.setReportInterval(0));
+    runner.setReportInterval(0.25);
+
+    // Count the reports for each member and make sure they are in order.
+    Array_<int>  nReports(NMembers, 0);
+    Array_<Real> lastTime(NMembers, -1);
+    bool inOrder = true;
+    runner.setReporter([&](int member, const State& state) {
+        inOrder = inOrder && state.getTime() > lastTime[member];
+        lastTime[member] = state.getTime();
+        ++nReports[member];
+    });
+
+    runner.setNumberOfThreads(1);
+    SimTK_TEST(runner.getNumberOfThreads() == 1);
+    Array_<State> serial;
+    runner.run(initial, serial);
+
+    lastTime.assign(NMembers, -1);
+    runner.setNumberOfThreads(4);
+    SimTK_TEST(runner.getNumberOfThreads() == 4);
+    Array_<State> parallel;
+    runner.run(initial, parallel);
+
+    SimTK_TEST(inOrder);
+    SimTK_TEST(serial.size() == NMembers && parallel.size() == NMembers);
+    for (int i=0; i < NMembers; ++i) {
+        SimTK_TEST(nReports[i] == 2*9); // initial state plus 8 intervals
+        SimTK_TEST(parallel[i].getTime() == 2);
+        SimTK_TEST(runner.getTerminationReason(i)
+                   == Integrator::ReachedFinalTime);
+        SimTK_TEST(!runner.wasStoppedByCondition(i));
+        // Each member is simulated the same way regardless of thread.
+        SimTK_TEST_EQ(parallel[i].getY(), serial[i].getY());
+    }
+    // Different starting angles should have given different answers.
+    SimTK_TEST_NOTEQ(parallel[0].getQ(), parallel[NMembers-1].getQ());
+}
+
+void testEnsembleStopConditionAndErrors() {
+    PendulumSystem sys;
+    sys.realizeTopology();
+    const int NMembers = 8;
+    Array_<State> initial = makeInitialStates(sys, NMembers);
+
+    EnsembleRunner runner(sys, makeIntegrator);
+    runner.setNumberOfThreads(3);
+
+    // Neither a final time nor a stop condition.
+    Array_<State> final;
+    SimTK_TEST_MUST_THROW(runner.run(initial, final));
+
+    // Stop the odd-numbered members at t=1 and the others at t=1.5.
+    runner.setReportInterval(0.5);
+    runner.setStopCondition([](int member, const State& state) {
+        return state.getTime() >= (member % 2 ? 1 : 1.5);
+    });
+    runner.run(initial, final);
+    for (int i=0; i < NMembers; ++i) {
+        SimTK_TEST(final[i].getTime() == (i % 2 ? 1 : 1.5));
+        SimTK_TEST(runner.wasStoppedByCondition(i));
+        SimTK_TEST(runner.getTerminationReason(i)
+                   == Integrator::InvalidTerminationReason);
+    }
+
+    // A bad initial State causes an exception but the other members are
+    // still simulated.
+    initial[5] = State();
+    runner.setFinalTime(0.5);
+    SimTK_TEST_MUST_THROW(runner.run(initial, final));
+    for (int i=0; i < NMembers; ++i)
+        if (i != 5) SimTK_TEST(final[i].getTime() == 0.5);
+}
+
+int main() {
+    SimTK_START_TEST("EnsembleRunnerTest");
+        SimTK_SUBTEST(testEnsembleMatchesSerial);
+        SimTK_SUBTEST(testEnsembleStopConditionAndErrors);
+    SimTK_END_TEST();
+}
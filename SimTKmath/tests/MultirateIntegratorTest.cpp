@@ -0,0 +1,133 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "IntegratorTestFramework.h"
+#include "simmath/MultirateIntegrator.h"
+#include "simmath/RungeKutta3Integrator.h"
+#include "simmath/RungeKuttaMersonIntegrator.h"
+
+// This is the rate of a fast first order lag z' = (x-z)/tau that follows the
+// pendulum's x coordinate, where z is the only z in the System.
+template <class T>
+class FastLagRate : public Measure_<T> {
+public:
+    SimTK_MEASURE_HANDLE_PREAMBLE(FastLagRate, Measure_<T>);
+    SimTK_MEASURE_HANDLE_POSTSCRIPT(FastLagRate, Measure_<T>);
+};
+
+template <class T>
+class FastLagRate<T>::Implementation : public Measure_<T>::Implementation {
+public:
+    Implementation* cloneVirtual() const override
+    {   return new Implementation(*this); }
+    int getNumTimeDerivativesVirtual() const override 
+    {   return 0; }
+    // z is a Dynamics stage variable.
+    Stage getDependsOnStageVirtual(int order) const override 
+    {   return Stage::Dynamics; }
+    void calcCachedValueVirtual(const State& s, int derivOrder, 
+                                T& value) const override
+    {   const Real tau = 1e-3;
+        value = (this->getSubsystem().getQ(s)[0] - s.getZ()[0]) / tau; }
+};
+
+// Integrate the pendulum with the lag attached and return the final state.
+static State runWithFastLag(Integrator& integ, PendulumSystem& sys) {
+    const Real qi[] = {1,0}; // (x,y)=(1,0)
+    const Real ui[] = {0,0}; // v=0
+    sys.setDefaultMass(10);
+    sys.setDefaultTimeAndState(0, Vector(2, qi), Vector(2, ui));
+    integ.setConstraintTolerance(1e-4);
+
+    TimeStepper ts(sys, integ);
+    ts.initialize(sys.getDefaultState());
+    ts.stepTo(3);
+    return integ.getState();
+}
+
+void testFastLag() {
+    PendulumSystem sys;
+    Measure::Constant one(sys, 1);
+    FastLagRate<Real> lagRate(sys);
+    Measure::Integrate lag(sys, lagRate, one);
+    sys.realizeTopology();
+
+    RungeKuttaMersonIntegrator refInteg(sys);
+    refInteg.setAccuracy(1e-9);
+    const State ref = runWithFastLag(refInteg, sys);
+
+    RungeKutta3Integrator rk3Integ(sys);
+    rk3Integ.setAccuracy(1e-4);
+    runWithFastLag(rk3Integ, sys);
+
+    MultirateIntegrator integ(sys);
+    integ.addFastSubsystem(lag.getSubsystem().getMySubsystemIndex());
+    integ.setAccuracy(1e-4);
+    const State fast = runWithFastLag(integ, sys);
+
+    // The fast z should have been substepped within much larger steps,
+    // without losing accuracy.
+    ASSERT(integ.getNumSubsteps() > 4*integ.getNumStepsTaken());
+    ASSERT(integ.getNumStepsTaken() < rk3Integ.getNumStepsTaken()/3);
+    for (int i=0; i < ref.getNY(); ++i)
+        ASSERT(std::abs(fast.getY()[i] - ref.getY()[i]) < 1e-2);
+}
+
+int main () {
+  try {
+    PendulumSystem sys;
+    sys.addEventHandler(new ZeroVelocityHandler(sys));
+    sys.addEventHandler(PeriodicHandler::handler = new PeriodicHandler());
+    sys.addEventHandler(new ZeroPositionHandler(sys));
+    sys.addEventReporter(PeriodicReporter::reporter = new PeriodicReporter(sys));
+    sys.addEventReporter(new OnceOnlyEventReporter());
+    sys.addEventReporter(new DiscontinuousReporter());
+    sys.realizeTopology();
+
+    // Test with various intervals for the event handler and event reporter, 
+    // ones that are either large or small compared to the expected internal 
+    // step size of the integrator. There are no fast states here.
+
+    for (int i = 0; i < 4; ++i) {
+        PeriodicHandler::handler->setEventInterval
+           (i == 0 || i == 1 ? 0.01 : 2.0);
+        PeriodicReporter::reporter->setEventInterval
+           (i == 0 || i == 2 ? 0.015 : 1.5);
+        
+        // Test the integrator in both normal and single step modes.
+        
+        MultirateIntegrator integ(sys);
+        testIntegrator(integ, sys);
+        integ.setReturnEveryInternalStep(true);
+        testIntegrator(integ, sys);
+    }
+
+    testFastLag();
+    cout << "Done" << endl;
+    return 0;
+  }
+  catch (std::exception& e) {
+    std::printf("FAILED: %s\n", e.what());
+    return 1;
+  }
+}
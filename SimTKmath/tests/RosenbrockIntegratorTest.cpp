@@ -0,0 +1,124 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "IntegratorTestFramework.h"
+#include "simmath/RosenbrockIntegrator.h"
+
+/*
+ * This system is the stiff Prothero-Robinson equation
+ *      z' = lambda*(z - cos t) - sin t
+ * whose solution is z = cos t + (z(0)-1) exp(lambda t). With lambda very
+ * negative the transient dies almost immediately, after which an explicit
+ * method is still limited to steps of about 3/|lambda| for stability while
+ * the smooth solution would allow steps thousands of times larger.
+ */
+class StiffSystemGuts : public System::Guts {
+    friend class StiffSystem;
+    SubsystemIndex subsysIndex;
+    Real lambda;
+public:
+    StiffSystemGuts* cloneImpl() const override 
+    {   return new StiffSystemGuts(*this); }
+
+    int realizeTopologyImpl(State& s) const override {
+        s.allocateZ(subsysIndex, Vector(1, Real(0)));
+        return System::Guts::realizeTopologyImpl(s);
+    }
+    int realizeAccelerationImpl(const State& s) const override {
+        const Real t = s.getTime(), z = s.getZ(subsysIndex)[0];
+        s.updZDot(subsysIndex)[0] = lambda*(z - std::cos(t)) - std::sin(t);
+        return System::Guts::realizeAccelerationImpl(s);
+    }
+};
+
+class StiffSystem : public System {
+public:
+    explicit StiffSystem(Real lambda) {
+        StiffSystemGuts* guts = new StiffSystemGuts();
+        guts->lambda = lambda;
+        adoptSystemGuts(guts);
+        DefaultSystemSubsystem defsub(*this);
+        guts->subsysIndex = defsub.getMySubsystemIndex();
+    }
+};
+
+// A stiff system should be integrated accurately in a number of steps set
+// by the smooth solution rather than by the stiff eigenvalue.
+void testStiffSystem() {
+    const Real Lambda = -1e6, FinalTime = 10;
+    StiffSystem sys(Lambda);
+    sys.realizeTopology();
+
+    RosenbrockIntegrator integ(sys);
+    integ.setAccuracy(1e-4);
+    TimeStepper ts(sys, integ);
+    ts.initialize(sys.getDefaultState());
+    for (int i=1; i <= 10; ++i) {
+        ts.stepTo(i*FinalTime/10);
+        const State& s = integ.getState();
+        ASSERT(std::abs(s.getZ()[0] - std::cos(s.getTime())) < 1e-5);
+    }
+    ASSERT(integ.getTime() == FinalTime);
+
+    // An explicit method would need over 3 million steps here.
+    ASSERT(integ.getNumStepsTaken() < 150);
+    ASSERT(integ.getNumStepsAttempted() < 200);
+}
+
+int main () {
+  try {
+    PendulumSystem sys;
+    sys.addEventHandler(new ZeroVelocityHandler(sys));
+    sys.addEventHandler(PeriodicHandler::handler = new PeriodicHandler());
+    sys.addEventHandler(new ZeroPositionHandler(sys));
+    sys.addEventReporter(PeriodicReporter::reporter = new PeriodicReporter(sys));
+    sys.addEventReporter(new OnceOnlyEventReporter());
+    sys.addEventReporter(new DiscontinuousReporter());
+    sys.realizeTopology();
+
+    // Test with various intervals for the event handler and event reporter, 
+    // ones that are either large or small compared to the expected internal 
+    // step size of the integrator.
+
+    for (int i = 0; i < 4; ++i) {
+        PeriodicHandler::handler->setEventInterval
+           (i == 0 || i == 1 ? 0.01 : 2.0);
+        PeriodicReporter::reporter->setEventInterval
+           (i == 0 || i == 2 ? 0.015 : 1.5);
+        
+        // Test the integrator in both normal and single step modes.
+        
+        RosenbrockIntegrator integ(sys);
+        testIntegrator(integ, sys);
+        integ.setReturnEveryInternalStep(true);
+        testIntegrator(integ, sys);
+    }
+    testStiffSystem();
+    cout << "Done" << endl;
+    return 0;
+  }
+  catch (std::exception& e) {
+    std::printf("FAILED: %s\n", e.what());
+    return 1;
+  }
+}
@@ -48,6 +48,14 @@ int main () {
         testIntegrator(integ, sys);
         integ.setReturnEveryInternalStep(true);
         testIntegrator(integ, sys);
+
+        // Repeat with events localized using the interpolant.
+
+        RungeKuttaMersonIntegrator integ2(sys);
+        integ2.setLocalizeEventsByInterpolation(true);
+        testIntegrator(integ2, sys);
+        integ2.setReturnEveryInternalStep(true);
+        testIntegrator(integ2, sys);
     }
     cout << "Done" << endl;
     return 0;
@@ -23,6 +23,8 @@
 
 #include "SimTKmath.h"
 #include <vector>
+#include <set>
+#include <utility>
 #include <exception>
 
 using namespace SimTK;
@@ -201,6 +203,154 @@ void testOBBTree() {
         SimTK_TEST(faceReferenceCount[i] == 1);
 }
 
+// Create a mesh consisting of a bunch of octahedra.
+ContactGeometry::TriangleMesh createOctahedra() {
+    vector<Vec3> vertices;
+    vector<int> faceIndices;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            for (int k = 0; k < 3; k++)
+                addOctohedron(vertices, faceIndices, 2.5*Vec3(i, j, k));
+    return ContactGeometry::TriangleMesh(vertices, faceIndices);
+}
+
+// Check that every pair of faces that really intersects is among the 
+// candidates found by the AABB tree, and that no pair is reported twice.
+void checkCandidateFacePairs(const ContactGeometry::TriangleMesh& mesh1, 
+                             const ContactGeometry::TriangleMesh& mesh2, 
+                             const Transform& X_12) {
+    Array_< pair<int,int> > candidates;
+    mesh1.findCandidateFacePairs(mesh2, X_12, candidates);
+    set< pair<int,int> > candidateSet(candidates.begin(), candidates.end());
+    SimTK_TEST(candidateSet.size() == candidates.size());
+    int numIntersecting = 0;
+    for (int f2 = 0; f2 < mesh2.getNumFaces(); f2++) {
+        const Geo::Triangle A
+           (X_12*mesh2.getVertexPosition(mesh2.getFaceVertex(f2, 0)),
+            X_12*mesh2.getVertexPosition(mesh2.getFaceVertex(f2, 1)),
+            X_12*mesh2.getVertexPosition(mesh2.getFaceVertex(f2, 2)));
+        for (int f1 = 0; f1 < mesh1.getNumFaces(); f1++) {
+            const Geo::Triangle B
+               (mesh1.getVertexPosition(mesh1.getFaceVertex(f1, 0)),
+                mesh1.getVertexPosition(mesh1.getFaceVertex(f1, 1)),
+                mesh1.getVertexPosition(mesh1.getFaceVertex(f1, 2)));
+            if (A.overlapsTriangle(B)) {
+                ++numIntersecting;
+                SimTK_TEST(candidateSet.count(pair<int,int>(f1, f2)) == 1);
+            }
+        }
+    }
+    // The hierarchy should actually prune something.
+    SimTK_TEST(numIntersecting > 0);
+    SimTK_TEST((int)candidates.size() 
+               < mesh1.getNumFaces()*mesh2.getNumFaces()/4);
+}
+
+void testAABBTree() {
+    ContactGeometry::TriangleMesh mesh = createOctahedra();
+    const Transform X_12(Rotation(0.3, UnitVec3(1, 2, 3)), Vec3(0.7, 0.4, 0.2));
+    checkCandidateFacePairs(mesh, mesh, X_12);
+    
+    // Far apart meshes produce no candidates at all.
+    Array_< pair<int,int> > candidates;
+    mesh.findCandidateFacePairs(mesh, Transform(Vec3(20, 0, 0)), candidates);
+    SimTK_TEST(candidates.empty());
+}
+
+// The AABB mesh-mesh tracker must find exactly the contacts the default
+// OBB one does.
+void testTriangleMeshTriangleMeshAABB() {
+    ContactGeometry::TriangleMesh mesh = createOctahedra();
+    ContactTracker::TriangleMeshTriangleMesh obbTracker;
+    ContactTracker::TriangleMeshTriangleMeshAABB aabbTracker;
+    const UntrackedContact prior((ContactSurfaceIndex(0)), 
+                                 ContactSurfaceIndex(1));
+    const Transform X_G1(Rotation(0.1, UnitVec3(0, 1, 1)), Vec3(1, 2, 3));
+    const Transform X_12[] = 
+       {Transform(Rotation(0.3, UnitVec3(1, 2, 3)), Vec3(0.7, 0.4, 0.2)),
+        Transform(Rotation(-0.2, UnitVec3(3, 1, 1)), Vec3(0.5, 0.3, 0.6)),
+        Transform(Vec3(20, 0, 0))};
+    for (int i = 0; i < 3; i++) {
+        Contact obbContact, aabbContact;
+        SimTK_TEST(obbTracker.trackContact(prior, X_G1, mesh, X_G1*X_12[i], 
+                                           mesh, 0, obbContact));
+        SimTK_TEST(aabbTracker.trackContact(prior, X_G1, mesh, X_G1*X_12[i],
+                                            mesh, 0, aabbContact));
+        SimTK_TEST(  TriangleMeshContact::isInstance(obbContact) 
+                  == TriangleMeshContact::isInstance(aabbContact));
+        SimTK_TEST(TriangleMeshContact::isInstance(obbContact) == (i < 2));
+        if (!TriangleMeshContact::isInstance(obbContact))
+            continue;
+        const TriangleMeshContact& obb = 
+            TriangleMeshContact::getAs(obbContact);
+        const TriangleMeshContact& aabb = 
+            TriangleMeshContact::getAs(aabbContact);
+        SimTK_TEST(obb.getSurface1Faces() == aabb.getSurface1Faces());
+        SimTK_TEST(obb.getSurface2Faces() == aabb.getSurface2Faces());
+    }
+}
+
+void testSetVertexPositions() {
+    ContactGeometry::TriangleMesh mesh = createOctahedra();
+    ContactGeometry::TriangleMesh original = mesh;
+
+    // Use the AABB tree so it has to be refit below rather than built later.
+    Array_< pair<int,int> > candidates;
+    mesh.findCandidateFacePairs(mesh, Transform(), candidates);
+    SimTK_TEST(!candidates.empty());
+
+    // Scale, shear, and move the mesh.
+    const Mat33 deform(2, 0.5, 0,
+                       0, 1,   0,
+                       0, 0,   1.5);
+    const Vec3 offset(1, -2, 3);
+    Array_<Vec3> positions(mesh.getNumVertices());
+    for (int i = 0; i < mesh.getNumVertices(); i++)
+        positions[i] = deform*mesh.getVertexPosition(i) + offset;
+    mesh.setVertexPositions(positions);
+    SimTK_TEST_MUST_THROW(mesh.setVertexPositions(Array_<Vec3>(3)));
+    
+    // Face geometry follows the vertices.
+    for (int i = 0; i < mesh.getNumFaces(); i++) {
+        const Vec3 e1 = deform*(  original.getVertexPosition(original.getFaceVertex(i, 1))
+                                - original.getVertexPosition(original.getFaceVertex(i, 0)));
+        const Vec3 e2 = deform*(  original.getVertexPosition(original.getFaceVertex(i, 2))
+                                - original.getVertexPosition(original.getFaceVertex(i, 0)));
+        SimTK_TEST_EQ(mesh.getFaceArea(i), (e1%e2).norm()/2);
+        SimTK_TEST_EQ(mesh.getFaceNormal(i), (e1%e2).normalize());
+    }
+
+    // Both hierarchies still enclose the refit mesh, and queries using them
+    // agree with a freshly built mesh.
+    vector<int> faceReferenceCount(mesh.getNumFaces(), 0);
+    validateOBBTree(mesh, mesh.getOBBTreeNode(), mesh.getOBBTreeNode(), faceReferenceCount);
+    const Transform X_12(Rotation(-0.2, UnitVec3(3, 1, 1)), Vec3(0.5, 0.3, 0.6));
+    checkCandidateFacePairs(mesh, mesh, X_12);
+
+    Array_<int> faceIndices;
+    for (int i = 0; i < mesh.getNumFaces(); i++)
+        for (int j = 0; j < 3; j++)
+            faceIndices.push_back(mesh.getFaceVertex(i, j));
+    ContactGeometry::TriangleMesh rebuilt(positions, faceIndices);
+    Random::Uniform random(-2, 10);
+    for (int i = 0; i < 100; i++) {
+        Vec3 pos(random.getValue(), random.getValue(), random.getValue());
+        bool inside, rebuiltInside;
+        UnitVec3 normal, rebuiltNormal;
+        Vec3 nearest = mesh.findNearestPoint(pos, inside, normal);
+        Vec3 rebuiltNearest = rebuilt.findNearestPoint(pos, rebuiltInside, rebuiltNormal);
+        SimTK_TEST((nearest-pos).norm() 
+                   <= (rebuiltNearest-pos).norm()*(1+1e-10));
+        SimTK_TEST((rebuiltNearest-pos).norm() 
+                   <= (nearest-pos).norm()*(1+1e-10));
+    }
+    Vec3 center;
+    Real radius;
+    mesh.getBoundingSphere(center, radius);
+    for (int i = 0; i < mesh.getNumVertices(); i++)
+        SimTK_TEST((center-mesh.getVertexPosition(i)).norm() <= radius);
+}
+
 void testRayIntersection() {
     // Create an octrohedral mesh.
     
@@ -277,6 +427,72 @@ void testFindNearestPoint() {
     }
 }
 
+void testFindNearestPoints() {
+    ContactGeometry::TriangleMesh mesh = createOctahedra();
+    Random::Uniform random(-2, 7);
+    random.setSeed(3);
+    Array_<Vec3> positions(200);
+    for (int i = 0; i < (int)positions.size(); i++)
+        positions[i] = Vec3(random.getValue(), random.getValue(), random.getValue());
+
+    // No guesses, good guesses, and random guesses must all find the same
+    // points as the one-at-a-time search.
+    Array_<int> faces;
+    Array_<Vec3> nearest;
+    Array_<bool> inside;
+    Array_<UnitVec3> normals;
+    for (int pass = 0; pass < 3; pass++) {
+        if (pass == 2)
+            for (int i = 0; i < (int)faces.size(); i++)
+                faces[i] = random.getIntValue() % mesh.getNumFaces();
+        mesh.findNearestPoints(positions, faces, nearest, inside, normals);
+        SimTK_TEST(faces.size() == positions.size());
+        for (int i = 0; i < (int)positions.size(); i++) {
+            bool expectedInside;
+            int expectedFace;
+            Vec2 uv;
+            const Vec3 expected = mesh.findNearestPoint(positions[i], 
+                                        expectedInside, expectedFace, uv);
+            SimTK_TEST_EQ((nearest[i]-positions[i]).norm(), 
+                          (expected-positions[i]).norm());
+            SimTK_TEST(inside[i] == expectedInside);
+            SimTK_TEST_EQ(normals[i], mesh.getFaceNormal(faces[i]));
+        }
+    }
+    Array_<int> wrongSize(3, -1);
+    SimTK_TEST_MUST_THROW(
+        mesh.findNearestPoints(positions, wrongSize, nearest, inside, normals));
+}
+
+// Points just inside or outside a vertex of a sphere mesh are equally near 
+// several faces, to within roundoff. Whatever face is guessed, the same face 
+// and the very same point must be reported.
+void testFindNearestPointsTies() {
+    ContactGeometry::TriangleMesh mesh(PolygonalMesh::createSphereMesh(1, 3));
+    Array_<Vec3> positions;
+    for (int i = 0; i < mesh.getNumVertices(); i += 12)
+        for (int j = 0; j < 27; j++) {
+            const Vec3 offset = 1e-14*Vec3(j%3-1, (j/3)%3-1, j/9-1);
+            positions.push_back(0.8*mesh.getVertexPosition(i) + offset);
+            positions.push_back(1.3*mesh.getVertexPosition(i) + offset);
+        }
+    Array_<int> firstFaces;
+    Array_<Vec3> firstNearest;
+    Array_<bool> inside;
+    Array_<UnitVec3> normals;
+    mesh.findNearestPoints(positions, firstFaces, firstNearest, inside, 
+                           normals);
+    for (int guess = 0; guess < mesh.getNumFaces(); guess++) {
+        Array_<int> faces(positions.size(), guess);
+        Array_<Vec3> nearest;
+        mesh.findNearestPoints(positions, faces, nearest, inside, normals);
+        for (int i = 0; i < (int)positions.size(); i++) {
+            SimTK_TEST(faces[i] == firstFaces[i]);
+            SimTK_TEST(nearest[i] == firstNearest[i]);
+        }
+    }
+}
+
 void testBoundingSphere() {
     Random::Uniform random(0, 10);
     for (int i = 0; i < 100; i++) {
@@ -312,9 +528,14 @@ int main() {
         SimTK_SUBTEST(testTriangleMesh);
         SimTK_SUBTEST(testIncorrectMeshes);
         SimTK_SUBTEST(testOBBTree);
+        SimTK_SUBTEST(testAABBTree);
+        SimTK_SUBTEST(testTriangleMeshTriangleMeshAABB);
+        SimTK_SUBTEST(testSetVertexPositions);
         SimTK_SUBTEST(testRayIntersection);
         SimTK_SUBTEST(testSmoothMesh);
         SimTK_SUBTEST(testFindNearestPoint);
+        SimTK_SUBTEST(testFindNearestPoints);
+        SimTK_SUBTEST(testFindNearestPointsTies);
         SimTK_SUBTEST(testBoundingSphere);
     SimTK_END_TEST();
 }
@@ -85,6 +85,21 @@ has not been set.
 @see getDissipatedEnergy(),setDissipatedEnergy(),setTrackDissipatedEnergy() **/
 bool getTrackDissipatedEnergy() const;
 
+/** Allow the contact forces to be calculated using up to \a numThreads 
+threads. This pays off when there are many contacts whose forces are 
+expensive, such as elastic foundation contacts between meshes. The forces 
+produced, and their order, are identical to those calculated serially, and 
+they are still combined into body forces serially so the results are 
+bitwise reproducible. The default is 1, meaning contact forces are calculated
+serially. Any ContactForceGenerator you add must then be safe to call from 
+several threads at once; the built-in ones are. This does not affect the 
+ContactTrackerSubsystem; see ContactTrackerSubsystem::setNumberOfThreads().
+@see getNumberOfThreads() **/
+void setNumberOfThreads(int numThreads);
+/** Return the maximum number of threads used to calculate contact forces.
+This is 1 unless you have called setNumberOfThreads(). **/
+int getNumberOfThreads() const;
+
 /** Determine how many of the active Contacts are currently generating
 contact forces. You can call this at Velocity stage or later; the contact
 forces will be realized first if necessary before we report how many there 
@@ -818,6 +833,8 @@ void processOneMesh
     const Transform&                        X_MO, 
     const SpatialVec&                       V_MO,
     const ContactGeometry&                  other,
+    ContactSurfaceIndex                     meshSurf,
+    ContactSurfaceIndex                     otherSurf,
     Real                                    meshDeformationFraction, // 0..1
     Real                                    areaScaleFactor, // >= 0
     Real k, Real c, Real us, Real ud, Real uv,
@@ -176,6 +176,19 @@ will be thrown if we have to calculate the contacts here but fail to do so;
 to avoid that you can realize them explicitly first (not common). 
 @see realizePredictedContacts()  **/
 const ContactSnapshot& getPredictedContacts(const State& state) const;
+
+/** Allow the narrow phase, in which each ContactTracker examines a pair of
+surfaces that passed the broad phase, to use up to \a numThreads threads. This
+pays off when there are many expensive pairs such as meshes. The resulting 
+contacts, including their ContactIds, are identical to those found serially.
+The default is 1, meaning the narrow phase is done serially. Any 
+ContactTracker you register must then be safe to call from several threads
+at once; the built-in ones are.
+@see getNumberOfThreads() **/
+void setNumberOfThreads(int numThreads);
+/** Return the maximum number of threads that the narrow phase may use. This
+is 1 unless you have called setNumberOfThreads(). **/
+int getNumberOfThreads() const;
 /**@}**/
 
 
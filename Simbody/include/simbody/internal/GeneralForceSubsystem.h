@@ -90,10 +90,10 @@ public:
     calculate computationally expensive forces (that have the
     shouldBeParallelIfPossible() method overridden). By default, the
     number of threads is the number of total processors (including hyperthreads)
-    on the machine.
+    on the machine. \a numThreads must be positive.
     
     @note This method should NOT be called while realizing Stage::Dynamics.**/
-    void setNumberOfThreads(unsigned numThreads);
+    void setNumberOfThreads(int numThreads);
     
     /** Returns the number of threads that the GeneralForceSubsystem can
     use to calculate computationally expensive forces (that have the
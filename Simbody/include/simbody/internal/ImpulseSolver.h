@@ -114,6 +114,7 @@ public:
     struct BoundedRT;
     struct ConstraintLtdFrictionRT;
     struct StateLtdFrictionRT;
+    struct BlockDiagonalMatrix;
 
     // How to treat a unilateral contact (input to solver).
     enum ContactType {TypeNA=-1, Observing=0, Known=1, Participating=2};
@@ -131,28 +132,53 @@ public:
                   int maxIters) 
     :   m_maxRollingTangVel(roll2slipTransitionSpeed),
         m_convergenceTol(convergenceTol),
-        m_maxIters(maxIters)
+        m_maxIters(maxIters),
+        m_numThreads(1)
     {
         clearStats();
     }
 
-    virtual ~ImpulseSolver() {}
+    virtual ~ImpulseSolver();
+
+    /** Return a new solver of the same concrete type with the same settings.
+    This is used to give each thread its own solver when blocks are solved in
+    parallel; see setNumberOfThreads(). The default returns null, meaning the
+    concrete solver can't be copied, in which case blocks are always solved
+    one at a time. **/
+    virtual ImpulseSolver* clone() const {return nullptr;}
+
+    /** Set the number of threads solveByBlocks() and 
+    solveBilateralByBlocks() may use to solve independent blocks concurrently.
+    Each extra thread uses its own clone() of this solver; the clones are
+    remade whenever a setting changes, so the results are the same as when
+    solving the blocks serially. The default of 1 means
+    solve serially. **/
+    void setNumberOfThreads(int nThreads) {
+        SimTK_APIARGCHECK1_ALWAYS(nThreads>0, "ImpulseSolver",
+            "setNumberOfThreads", "Illegal number of threads %d.", nThreads);
+        m_numThreads = nThreads;
+        m_workers.reset();
+    }
+    int getNumberOfThreads() const {return m_numThreads;}
 
     void setMaxRollingSpeed(Real roll2slipTransitionSpeed) {
         assert(roll2slipTransitionSpeed >= 0);
         m_maxRollingTangVel = roll2slipTransitionSpeed; 
+        m_workers.reset(); // clones have the old setting
     }
     Real getMaxRollingSpeed() const {return m_maxRollingTangVel;}
 
     void setConvergenceTol(Real tol) {
         assert(tol >= 0);
         m_convergenceTol = tol;
+        m_workers.reset(); // clones have the old setting
     }
     Real getConvergenceTol() const {return m_convergenceTol;}
 
     void setMaxIterations(int maxIts) {
         assert(maxIts > 0);
         m_maxIters = maxIts;
+        m_workers.reset(); // clones have the old setting
     }
     int getMaxIterations() const {return m_maxIters;}
 
@@ -173,6 +199,32 @@ public:
         m_nSolves[phase] = m_nIters[phase] = m_nFail[phase] = 0;
     }
 
+    /** Return the number of calls to solve() for this phase since the stats
+    were last cleared. **/
+    long long getNumSolves(int phase) const
+    {   checkPhase(phase, "getNumSolves"); return m_nSolves[phase]; }
+    /** Return the total number of iterations taken by solve() for this phase
+    since the stats were last cleared. What counts as an iteration depends on
+    the concrete solver. **/
+    long long getNumIterations(int phase) const
+    {   checkPhase(phase, "getNumIterations"); return m_nIters[phase]; }
+    /** Return the number of calls to solve() for this phase that failed to
+    converge since the stats were last cleared. **/
+    long long getNumFailures(int phase) const
+    {   checkPhase(phase, "getNumFailures"); return m_nFail[phase]; }
+
+    /** Supply a starting guess for the unknown impulse pi to be used by the
+    next call to solve(), typically the impulse found for the same constraints
+    at the previous time step. The guess is consumed by that call and ignored
+    if it isn't the right size. Use NaN for any entry for which no guess is
+    available. Concrete solvers may also take a guessed normal impulse of 
+    exactly zero (not NaN) as a hint that the contact will separate, but they
+    must still return a valid solution if the guess turns out to be 
+    wrong. **/
+    void setInitialGuess(const Vector& piGuess) {m_piGuess = piGuess;}
+    /** Forget any initial guess supplied with setInitialGuess(). **/
+    void clearInitialGuess() {m_piGuess.clear();}
+
     /** Solve. **/
     virtual bool solve
        (int                                 phase,
@@ -222,6 +274,46 @@ public:
         Vector&                             pi     // m, unknown result
         ) const = 0;
 
+    /** Solve the same problem as solve(), but with A given as independent
+    diagonal blocks, as produced by 
+    SimbodyMatterSubsystem::calcProjectedMInvBlocks(). Since the blocks don't
+    interact, each block's equations and inequalities form a separate problem
+    and the full m X m matrix is never needed. The default implementation 
+    gathers each block's subproblem, including the constraint runtimes whose
+    multipliers lie in that block, and solves it with the dense solve() 
+    method; stats are thus counted per block. Any initial guess supplied with
+    setInitialGuess() is divided up among the blocks. Blocks are solved in 
+    parallel if more than one thread was requested with 
+    setNumberOfThreads(). Returns true only if every block converged. **/
+    virtual bool solveByBlocks
+       (int                                 phase,
+        const Array_<MultiplierIndex>&      participating, // p<=m of these 
+        const BlockDiagonalMatrix&          A,     // m X m, symmetric
+        const Vector&                       D,     // m, diag>=0 added to A
+        const Array_<MultiplierIndex>&      expanding, // nx<=m of these 
+        Vector&                             piExpand, // m
+        Vector&                             verrStart,   // m, RHS (in/out)
+        Vector&                             verrApplied, // m
+        Vector&                             pi,       // m, known+unknown
+        Array_<UncondRT>&                   unconditional,
+        Array_<UniContactRT>&               uniContact, // with friction
+        Array_<UniSpeedRT>&                 uniSpeed,
+        Array_<BoundedRT>&                  bounded,
+        Array_<ConstraintLtdFrictionRT>&    consLtdFriction,
+        Array_<StateLtdFrictionRT>&         stateLtdFriction
+        ) const;
+
+    /** Solve the same problem as solveBilateral(), but with A given as 
+    independent diagonal blocks. The default implementation solves each 
+    block's part with the dense solveBilateral() method. **/
+    virtual bool solveBilateralByBlocks
+       (const Array_<MultiplierIndex>&      participating, // p<=m of these 
+        const BlockDiagonalMatrix&          A,     // m X m, symmetric
+        const Vector&                       D,     // m, diag>=0 added to A
+        const Vector&                       rhs,   // m, RHS
+        Vector&                             pi     // m, unknown result
+        ) const;
+
     // Printable names for the enum values for debugging.
     static const char* getContactTypeName(ContactType ct);
     static const char* getUniCondName(UniCond uc);
@@ -233,6 +325,15 @@ public:
                                 const Array_<UniContactRT>& uniContacts);
 
 protected:
+    // Move the initial guess if any into piGuess, leaving it unset for the
+    // next solve(). Returns true if there was a guess of length m.
+    bool takeInitialGuess(int m, Vector& piGuess) const {
+        const bool hasGuess = (m_piGuess.size() == m);
+        if (hasGuess) piGuess = m_piGuess;
+        m_piGuess.clear();
+        return hasGuess;
+    }
+
     Real m_maxRollingTangVel; // Sliding above this speed if solver cares.
     Real m_convergenceTol;    // Meaning depends on concrete solver.
     int  m_maxIters;          // Meaning depends on concrete solver.
@@ -243,6 +344,25 @@ protected:
     mutable long long m_nBilateralSolves;
     mutable long long m_nBilateralIters;
     mutable long long m_nBilateralFail;
+
+    mutable Vector m_piGuess; // for the next solve() only; see above
+
+private:
+    void checkPhase(int phase, const char* methodName) const {
+        SimTK_ERRCHK3(0<=phase&&phase<MaxNumPhases,
+            "ImpulseSolver::getStats()",
+            "%s(): phase must be 0..%d but was %d\n", methodName,
+            MaxNumPhases-1, phase);
+    }
+
+    // The per-thread solvers used to solve blocks in parallel, created when
+    // first needed; defined in ImpulseSolver.cpp. (A shared_ptr can be 
+    // destroyed where BlockWorkers is incomplete; copies don't share it.)
+    class BlockWorkers;
+    BlockWorkers& updBlockWorkers() const;
+
+    int m_numThreads;
+    mutable ResetOnCopy< std::shared_ptr<BlockWorkers> > m_workers;
 };
 
 struct ImpulseSolver::UncondRT {
@@ -363,6 +483,30 @@ struct ImpulseSolver::StateLtdFrictionRT {
     Array_<Real>            m_Fimpulse; // same size as m_Fk
 };
 
+// A symmetric m X m constraint-space matrix such as A=G M\ ~G whose only 
+// nonzero entries lie in independent dense blocks. After a symmetric 
+// permutation this is block diagonal; entries coupling multipliers from 
+// different blocks are zero and aren't stored.
+struct ImpulseSolver::BlockDiagonalMatrix {
+    BlockDiagonalMatrix() {}
+
+    // Total number of rows (and columns) m.
+    int size() const {
+        int m = 0;
+        for (unsigned b=0; b < m_mults.size(); ++b)
+            m += (int)m_mults[b].size();
+        return m;
+    }
+
+    void clear() {m_mults.clear(); m_blocks.clear();}
+
+    // Which multipliers are in each block, in increasing order. Every 
+    // multiplier 0..m-1 appears in exactly one block.
+    Array_< Array_<MultiplierIndex> >   m_mults;
+    // m_blocks[b] is the dense symmetric block for multipliers m_mults[b].
+    Array_<Matrix>                      m_blocks;
+};
+
 } // namespace SimTK
 
 #endif // SimTK_SIMBODY_IMPULSE_SOLVER_H_
@@ -60,6 +60,9 @@ public:
                       100), // default PGS max number iterations
         m_SOR(1.2) {}
 
+    PGSImpulseSolver* clone() const override 
+    {   return new PGSImpulseSolver(*this); }
+
     /** Solve with conditional constraints. In the common underdetermined
     case (redundant contact) we will return the first solution encountered but
     it is unlikely to be the best possible solution. **/
@@ -41,6 +41,9 @@ public:
         m_cosMaxSlidingDirChange(std::cos(Pi/6)) // 30 degrees
     {}
 
+    PLUSImpulseSolver* clone() const override 
+    {   return new PLUSImpulseSolver(*this); }
+
     /** Solve with conditional constraints. **/
     bool solve
        (int                                 phase,
@@ -151,6 +151,101 @@ public:
     ImpulseSolverType getImpulseSolverType() const 
     {   return m_solverType; }
 
+    /** Enable warm starting of the ImpulseSolver. When this is on, we remember
+    the force found for each proximal unilateral contact at the end of a step 
+    and use it as the ImpulseSolver's starting guess for that contact during 
+    the next step, matching contacts by their UnilateralContactIndex since 
+    their multipliers may be reassigned from step to step. Contacts that 
+    separated are guessed to remain separated. For resting or slowly changing
+    contact this substantially reduces the solver's work; the results agree 
+    with those obtained without warm starting to within the solver's 
+    convergence tolerance when the solution is unique. This is off by 
+    default. **/
+    void setUseWarmStart(bool useWarmStart) {m_useWarmStart = useWarmStart;}
+    bool getUseWarmStart() const {return m_useWarmStart;}
+
+    /** Calculate the constraint compliance matrix A=G M\ ~G as a set of
+    independent dense blocks rather than as a full m X m matrix, and have the
+    ImpulseSolver work on each block separately. Constraints can interact 
+    through A only if they act on bodies in a common base-body subtree, so 
+    contacts on separate objects, or separate piles of objects, don't need 
+    the zero entries that couple them. With many scattered contacts this
+    substantially reduces both memory and the cost of forming A; see 
+    SimbodyMatterSubsystem::calcProjectedMInvBlocks(). The results are the
+    same to within the solver's convergence tolerance. This is off by 
+    default. **/
+    void setUseBlockCompliance(bool useBlocks) 
+    {   m_useBlockCompliance = useBlocks; }
+    bool getUseBlockCompliance() const {return m_useBlockCompliance;}
+
+    /** Set the number of threads the ImpulseSolver may use to solve the
+    blocks of the constraint compliance matrix concurrently when 
+    setUseBlockCompliance() is on. Each block is an "island" of bodies that
+    are coupled through their joints and active constraints, such as a 
+    separate pile of objects, and its impulse problem doesn't depend on any
+    other island's. The results don't depend on the number of threads. The
+    default of 1 means solve the islands one at a time. **/
+    void setNumberOfThreads(int nThreads) {
+        SimTK_APIARGCHECK1_ALWAYS(nThreads>0, "SemiExplicitEulerTimeStepper",
+            "setNumberOfThreads", "Illegal number of threads %d.", nThreads);
+        m_numThreads = nThreads;
+        if (m_solver) m_solver->setNumberOfThreads(nThreads);
+    }
+    int getNumberOfThreads() const {return m_numThreads;}
+
+    /** Put islands to sleep once they have been at rest for a while. An 
+    island is a set of base-body subtrees (a base body is one whose parent is 
+    Ground) joined through active constraints; a pile of objects resting on
+    the ground is one island. When every generalized speed u of an island has
+    stayed below the sleep velocity (see setSleepVelocity()) for the sleep 
+    time (see setSleepTime()), we set its u's to zero and stop advancing it: 
+    its contacts are disabled so they cost nothing, and its q's and u's are 
+    left unchanged by subsequent steps. A sleeping island is woken as soon as
+    an awake body comes into contact with it, and then continues normally.
+    Forces acting on sleeping bodies are ignored; call wakeAllIslands() if 
+    you change them. This is off by default. **/
+    void setUseSleeping(bool useSleeping) {
+        m_useSleeping = useSleeping;
+        if (!useSleeping) wakeAllIslands();
+    }
+    bool getUseSleeping() const {return m_useSleeping;}
+
+    /** Set the speed below which a generalized speed u counts as resting for
+    the purpose of putting its island to sleep. In practice we will use the
+    \e larger of this value and twice the velocity constraint tolerance 
+    currently in effect. The default is zero, meaning use that tolerance. **/
+    void setSleepVelocity(Real vSleep) {
+        SimTK_ERRCHK1_ALWAYS(vSleep>=0,
+        "SemiExplicitEulerTimeStepper::setSleepVelocity()",
+        "The sleep velocity must be nonnegative but was %g.", vSleep);
+        m_sleepVelocity = vSleep;
+    }
+    Real getSleepVelocity() const {return m_sleepVelocity;}
+    /** Return the value actually being used as the sleep velocity. **/
+    Real getSleepVelocityInUse() const 
+    {   return std::max(m_sleepVelocity, 2*m_consTol); }
+
+    /** Set how long an island must have been resting before it is put to 
+    sleep. The default is half a second. **/
+    void setSleepTime(Real tSleep) {
+        SimTK_ERRCHK1_ALWAYS(tSleep>=0,
+        "SemiExplicitEulerTimeStepper::setSleepTime()",
+        "The sleep time must be nonnegative but was %g.", tSleep);
+        m_sleepTime = tSleep;
+    }
+    Real getSleepTime() const {return m_sleepTime;}
+
+    /** Return true if the given body is currently in a sleeping island. **/
+    bool isBodySleeping(MobilizedBodyIndex mbx) const {
+        return mbx < m_baseBodyOf.size() 
+            && m_sleepGroup[m_baseBodyOf[mbx]] >= 0;
+    }
+    /** Return the number of bodies currently asleep. **/
+    int getNumSleepingBodies() const;
+    /** Wake up every sleeping island. They will be allowed to fall asleep
+    again after resting for the sleep time. **/
+    void wakeAllIslands();
+
     /** Set the impact capture velocity to be used by default when a contact
     does not provide its own. This is the impact velocity below which the
     coefficient of restitution is to be treated as zero. This avoids a Zeno's
@@ -299,6 +394,23 @@ private:
     void calcCoefficientsOfRestitution(const State&, const Vector& verr,
                                        bool disableRestitution);
 
+    // Give the ImpulseSolver a starting guess for the compression phase
+    // impulse, using the contact forces saved at the end of the last step.
+    void supplyWarmStartGuess(Real h, int m);
+    // Save the contact forces (multipliers) found for this step.
+    void saveContactForcesForWarmStart(const Vector& lambda);
+
+    // Find the islands of bodies joined through the enabled constraints.
+    void findIslands(const State&);
+    // Wake any sleeping islands that are now in contact with an awake island.
+    // Returns true if any were woken; their contacts must then be enabled.
+    bool wakeTouchedIslands();
+    // Update the resting time of each awake island given the new u's and put
+    // to sleep any that have rested long enough, zeroing their u's.
+    void putRestingIslandsToSleep(State&, Real h);
+    // Zero the entries of a u-sized vector that belong to sleeping bodies.
+    void zeroSleepingMobilities(const State&, Vector& uVec) const;
+
     // Easy if there are no constraints active.
     void takeUnconstrainedStep(State& s, Real h);
 
@@ -381,6 +493,26 @@ private:
                               Vector&       impulse);
     bool anyPositionErrorsViolated(const State&, const Vector& perr) const;
 
+    // Call the ImpulseSolver's dense or block method depending on how we
+    // calculated A=G M\ ~G for this step.
+    bool solveImpulses
+       (int                                             phase,
+        const Array_<MultiplierIndex>&                  participating,
+        const Array_<MultiplierIndex>&                  expanding,
+        Vector&                                         piExpand,
+        Vector&                                         verrStart,
+        Vector&                                         verrApplied,
+        Vector&                                         pi,
+        Array_<ImpulseSolver::UncondRT>&                unconditional,
+        Array_<ImpulseSolver::UniContactRT>&            uniContact,
+        Array_<ImpulseSolver::UniSpeedRT>&              uniSpeed,
+        Array_<ImpulseSolver::BoundedRT>&               bounded,
+        Array_<ImpulseSolver::ConstraintLtdFrictionRT>& consLtdFriction,
+        Array_<ImpulseSolver::StateLtdFrictionRT>&      stateLtdFriction) const;
+    bool solveBilateralImpulses(const Array_<MultiplierIndex>&  participating,
+                                const Vector&                   rhs,
+                                Vector&                         pi) const;
+
     // This phase uses only holonomic constraints, and zero is a good initial
     // guess for the (hopefully small) position correction.
     bool doPositionCorrectionPhase(const State& state, 
@@ -397,6 +529,12 @@ private:
     int                         m_maxInducedImpactsPerStep;
     PositionProjectionMethod    m_projectionMethod;
     ImpulseSolverType           m_solverType;
+    bool                        m_useWarmStart;
+    bool                        m_useBlockCompliance;
+    int                         m_numThreads;
+    bool                        m_useSleeping;
+    Real                        m_sleepVelocity;
+    Real                        m_sleepTime;
 
 
     Real                        m_defaultCaptureVelocity;
@@ -409,15 +547,28 @@ private:
     // Persistent runtime data.
     State                       m_state;
     Vector                      m_emptyVector; // don't change this!
+    // Contact forces (normal, friction x, friction y) from the end of the last
+    // step for warm starting; NaN if not available.
+    Array_<Vec3,UnilateralContactIndex> m_prevUniContactForce;
+    // Sleeping islands. A sleeping island is identified by its lowest-
+    // numbered base body; -1 means awake. Resting time and sleep status are
+    // kept for base bodies only.
+    Array_<MobilizedBodyIndex,MobilizedBodyIndex> m_baseBodyOf;
+    Array_<Real,MobilizedBodyIndex>     m_restTime;
+    Array_<int,MobilizedBodyIndex>      m_sleepGroup;
+    Array_<int,UnilateralContactIndex>  m_contactSleepGroup; // held disabled
 
     // Step temporaries.
     Matrix                      m_GMInvGt; // G M\ ~G
+    ImpulseSolver::BlockDiagonalMatrix m_GMInvGtBlocks; // or in blocks
     Vector                      m_D; // soft diagonal
     Vector                      m_deltaU;
     Vector                      m_verr;
     Vector                      m_totalImpulse;
     Vector                      m_impulse;
     Vector                      m_genImpulse; // ~G*impulse
+    Array_< Array_<int> >       m_islandMults;  // multipliers of each island
+    Array_<int,MobilizedBodyIndex> m_islandOfBody; // -1 if no constraints
 
     Array_<UnilateralContactIndex>      m_proximalUniContacts, 
                                         m_distalUniContacts;
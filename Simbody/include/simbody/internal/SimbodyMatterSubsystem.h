@@ -205,6 +205,107 @@ void setShowDefaultGeometry(bool show);
 geometry that can be used to visualize this multibody system. **/
 bool getShowDefaultGeometry() const;
 
+/** Allow the tree sweeps used to calculate articulated body inertias, forward
+dynamics accelerations, and M^-1*f to use up to \a numThreads threads. These
+sweeps proceed level by level through the multibody tree (base-to-tip or 
+tip-to-base) and the mobilized bodies at any one level are independent, so 
+wide trees (many base bodies or many branches) can process each level in 
+parallel. Narrow levels are always done serially; see setMinBodiesPerThread().
+No more threads are used than there are processors unless you set 
+\a limitToProcessors false, which is mainly useful for testing the threaded 
+sweeps on a machine with a single processor. Results are identical to the 
+serial calculation. The default is 1, meaning all sweeps are serial, since 
+threading overhead dominates unless the levels are wide; measure with your own
+system (see the ParallelTreeSweeps adhoc program) before turning this on.
+@see getNumberOfThreads(), getNumberOfThreadsInUse(), setMinBodiesPerThread()
+**/
+void setNumberOfThreads(int numThreads, bool limitToProcessors=true);
+/** Return the number of threads most recently requested with 
+setNumberOfThreads(), or 1 if you haven't called it. Fewer are used if there
+are fewer processors; see getNumberOfThreadsInUse(). **/
+int getNumberOfThreads() const;
+/** Return the number of threads the tree sweeps will actually use, which is
+1 if they are all done serially. **/
+int getNumberOfThreadsInUse() const;
+/** Set the minimum number of mobilized bodies that must be assigned to each 
+thread when a tree level is processed in parallel. A level with fewer than
+twice this many bodies is processed serially. The default is 8; larger values
+reduce threading overhead for cheap mobilizers. This has no effect unless
+setNumberOfThreads() has been called with more than one thread. **/
+void setMinBodiesPerThread(int minBodies);
+/** Return the current setting of the minimum number of mobilized bodies 
+processed by each thread in parallel tree sweeps.
+@see setMinBodiesPerThread() **/
+int getMinBodiesPerThread() const;
+
+/** Enable or disable incremental position kinematics. Normally realizing 
+Stage::Position recalculates the kinematics of every mobilized body, even if 
+only a few q's have changed. When this is enabled, Simbody remembers which q's
+were used the last time position kinematics was realized in a given State, and 
+recalculates only the bodies whose own mobilizer q's have changed since then,
+along with all the bodies outboard of them. That can be much faster when only
+one or a few joints change at a time, as in inverse kinematics or sampling.
+Calculations that follow position kinematics (constraints, forces, and any
+other Position-stage computations) are still performed in full. Any change at
+Instance stage or earlier causes a full recalculation, as does anything else
+that invalidates position kinematics without changing q, such as 
+invalidatePositionKinematics().
+
+This assumes that each mobilizer's kinematics depends only on its own q's and
+on Instance-stage information, which is true for all the built-in mobilizers.
+Don't enable this if you have custom mobilizers that depend on anything else,
+such as time. This is a computational setting rather than part of the model, 
+and is off by default.
+@see getNumBodiesRecalculatedInPositionKinematics() **/
+void setUseIncrementalPositionKinematics(bool useIncremental);
+/** Return the current setting of the incremental position kinematics flag.
+@see setUseIncrementalPositionKinematics() **/
+bool getUseIncrementalPositionKinematics() const;
+
+/** Enable or disable the block-sparse constraint solver. When computing
+constrained accelerations (and in solveForConstraintImpulses()), Simbody 
+normally forms the full m X m matrix G M^-1 ~G for the m constraint equations 
+with m O(n) sweeps, then factors it in O(m^3) time. When this is enabled,
+Simbody instead finds groups of constraints that act on separate base-body
+subtrees (a base body is one that is attached directly to Ground). Such groups 
+cannot interact, so G M^-1 ~G is block diagonal. Only the diagonal blocks are 
+formed, using as many sweeps as there are equations in the largest group, and
+each block is factored separately. That can be much faster for systems made of
+many independent mechanisms, such as a collection of closed-loop linkages or 
+cable-driven subassemblies attached to Ground.
+
+The results are the same as with the dense solver up to roundoff, except that
+redundant constraints are detected per block, using the usual conditioning
+tolerance scaled by the block's dimension rather than by m. If all the 
+constraints are coupled there is a single block and this is the same 
+computation as the dense solver. This is a computational setting rather than
+part of the model, and is off by default. **/
+void setUseSparseConstraintSolver(bool useSparse);
+/** Return the current setting of the block-sparse constraint solver flag.
+@see setUseSparseConstraintSolver() **/
+bool getUseSparseConstraintSolver() const;
+
+/** Enable or disable modified Newton projection. Normally projectQ() 
+recalculates and factors the weighted position constraint matrix on every 
+iteration, and projectU() calculates and factors the velocity constraint matrix
+once per call. When this is enabled, each of them starts with the factored 
+matrix saved by the previous projection of the same State (for example, at the
+previous integrator step), and keeps using it as long as every iteration 
+reduces the constraint error norm by at least a factor of four. Otherwise it 
+forms a new matrix at the current configuration and continues. The constraint 
+Jacobians change little from step to step, so this can eliminate most of the
+factorizations in heavily constrained models. The saved matrices are discarded
+after any Instance-stage change, such as enabling or disabling a constraint.
+
+Projections that request ProjectOptions::ForceFullNewton (see 
+Integrator::setForceFullNewton()) never use a saved matrix. This is a 
+computational setting rather than part of the model, and is off by default.
+@see getNumProjectionFactorizations(), getNumProjectionFactorizationReuses() **/
+void setUseModifiedNewtonProjection(bool useModifiedNewton);
+/** Return the current setting of the modified Newton projection flag.
+@see setUseModifiedNewtonProjection() **/
+bool getUseModifiedNewtonProjection() const;
+
 /** The number of bodies includes all mobilized bodies \e including Ground,
 which is the first mobilized body, at MobilizedBodyIndex 0. (Note: if 
 special particle handling were implemented, the count here would \e not 
@@ -555,6 +656,16 @@ void multiplyBySystemJacobian( const State&         state,
                                const Vector&        u,
                                Vector_<SpatialVec>& Ju) const;
 
+/** Multiple right-hand side version of multiplyBySystemJacobian(). Each of the
+k columns of the nu X k matrix \a U is multiplied by J and the results are
+returned as the corresponding columns of the nb X k matrix of spatial vectors
+\a JU. This is equivalent to k calls to the single-vector method but sweeps 
+the multibody tree only once, so the per-body data is fetched once for all
+columns rather than once per column. **/
+void multiplyBySystemJacobianMultiple( const State&         state,
+                                       const Matrix&        U,
+                                       Matrix_<SpatialVec>& JU) const;
+
 /** Calculate the acceleration bias term for the %System Jacobian, that is, the
 part of the acceleration that is due only to velocities. This term is also
 known as the Coriolis acceleration, and it is returned here as a spatial
@@ -647,6 +758,16 @@ void multiplyBySystemJacobianTranspose( const State&                state,
                                         const Vector_<SpatialVec>&  F_G,
                                         Vector&                     f) const;
 
+/** Multiple right-hand side version of multiplyBySystemJacobianTranspose().
+Each of the k columns of the nb X k matrix of spatial forces \a F_G is 
+multiplied by ~J and the results are returned as the corresponding columns of
+the nu X k matrix \a f. The multibody tree is swept only once for all the
+columns. **/
+void multiplyBySystemJacobianTransposeMultiple
+   (const State&                state,
+    const Matrix_<SpatialVec>&  F_G,
+    Matrix&                     f) const;
+
 
 /** Explicitly calculate and return the nb x nu whole-system kinematic 
 Jacobian J_G, with each element a 2x3 spatial vector (SpatialVec). This matrix 
@@ -1261,6 +1382,15 @@ realization of composite-body or articulated-body inertias.
   \c Stage::Position **/
 void multiplyByM(const State& state, const Vector& a, Vector& Ma) const;
 
+/** Multiple right-hand side version of multiplyByM(). Each of the k columns 
+of the nu X k matrix \a A is multiplied by M and the results are returned as
+the corresponding columns of \a MA. This costs the same number of flops as k 
+separate calls but sweeps the multibody tree only once, fetching each body's
+data once for all the columns. \a A and \a MA may be the same Matrix.
+@par Required stage
+  \c Stage::Position **/
+void multiplyByMMultiple(const State& state, const Matrix& A, Matrix& MA) const;
+
 /** This operator calculates in O(n) time the product M^-1*v where M is the 
 system mass matrix and v is a supplied vector with one entry per u-space
 mobility. If v is a set of generalized forces f, the result is a generalized 
@@ -1344,6 +1474,19 @@ void multiplyByMInv(const State&    state,
                     const Vector&   v,
                     Vector&         MinvV) const;
 
+/** Multiple right-hand side version of multiplyByMInv(). Each of the k columns
+of the nu X k matrix \a V is multiplied by M^-1 and the results are returned as
+the corresponding columns of \a MinvV. The treatment of prescribed motion is 
+the same as for the single-vector method. The multibody tree is swept only 
+once (inward and then outward) for all k columns; this is what calcMInv() 
+uses internally. \a V and \a MinvV may be the same Matrix.
+@par Required stage
+  \c Stage::Position (articulated body inertias realized first if necessary)
+@see calcMInv() **/
+void multiplyByMInvMultiple(const State&    state,
+                            const Matrix&   V,
+                            Matrix&         MinvV) const;
+
 /** This operator explicitly calculates the n X n mass matrix M. Note that this
 is inherently an O(n^2) operation since the mass matrix has n^2 elements 
 (although only n(n+1)/2 are unique due to symmetry). <em>DO NOT USE THIS CALL 
@@ -1378,6 +1521,44 @@ with the calcM() method.
 @see multiplyByMInv(), calcM() **/
 void calcMInv(const State&, Matrix& MInv) const;
 
+/** Solve M*x=f for x using the sparse factorization M = ~L*D*L that Simbody
+can compute by exploiting the branch structure of the multibody tree (see 
+Featherstone's 2008 book, Rigid Body Dynamics Algorithms, section 6.5). Each
+row of L is nonzero only in columns belonging to mobilities of the ancestors 
+of that row's mobility, so if the deepest path from Ground to a tip body has
+d mobilities, the factorization takes O(n*d^2) time and each solve takes 
+O(n*d) time. This is the same as for multiplyByMInv() for a chain, and much
+faster than factoring the result of calcM() for a bushy tree.
+
+Unlike multiplyByMInv(), this works with the whole mass matrix M, regardless
+of prescribed motion. The factorization is realized on first use after a 
+change to q, and is then reused by subsequent calls to this method and 
+calcMInvSubmatrix(); see realizeMFactorization(). It is OK for \a f and \a x
+to be the same Vector.
+
+@par Required stage
+  \c Stage::Position (factorization realized first if necessary)
+@see realizeMFactorization(), calcMInvSubmatrix(), multiplyByMInv() **/
+void solveWithMFactorization(const State&   state,
+                             const Vector&  f,
+                             Vector&        x) const;
+
+/** Calculate the m X m submatrix of M^-1 whose rows and columns correspond to
+the mobilities listed in \a mobilities, without forming the rest of M^-1. 
+This uses the sparse factorization of M described in solveWithMFactorization()
+and takes O(m*d^2 + m^2*d) time, where d is the number of mobilities on the 
+deepest path from Ground. This is useful for example for getting the inverse
+mass matrix restricted to a few mobilities of interest in a large system. As
+with solveWithMFactorization(), M here is the whole mass matrix regardless of
+prescribed motion.
+
+@par Required stage
+  \c Stage::Position (factorization realized first if necessary)
+@see solveWithMFactorization(), calcMInv() **/
+void calcMInvSubmatrix(const State&          state,
+                       const Array_<UIndex>& mobilities,
+                       Matrix&               MInvSub) const;
+
 /** This operator calculates in O(m*n) time the m X m "projected inverse mass 
 matrix" or "constraint compliance matrix" W=G*M^-1*~G, where G (mXn) is the 
 acceleration-level constraint Jacobian mapped to generalized coordinates,
@@ -1428,6 +1609,36 @@ it in O(m*n) time with O(n) intermediate storage, which is a \e lot better.
 void calcProjectedMInv(const State&   s,
                        Matrix&        GMInvGt) const;
 
+/** Calculate the projected inverse mass matrix W=G*M^-1*~G as described for
+calcProjectedMInv(), but returning only the blocks that can be nonzero. M^-1 
+does not couple mobilities in different base-body subtrees (a base body is one
+whose parent is Ground), so two constraint equations can interact through W
+only if they act on a common subtree, directly or through other constraints.
+The constraint equations currently in use are partitioned into such 
+independent groups and W returned as one dense diagonal block per group; all
+other entries of W are zero.
+
+@param[in]      s
+    The State from which the matrix is calculated. Must already be realized
+    to Velocity stage.
+@param[out]     blockMultipliers
+    One entry per group, listing that group's multiplier indices in increasing
+    order. Each multiplier appears in exactly one group, and the groups are
+    ordered by their lowest multiplier index.
+@param[out]     blocks
+    The same number of entries as \a blockMultipliers, with blocks[b] the 
+    symmetric dense submatrix of W for the multipliers in blockMultipliers[b].
+
+Storage is the sum of the squares of the block sizes rather than m^2, and the 
+time is O(n) for each equation in the largest block rather than for each of
+the m equations, since one column from every block is obtained from the same
+O(n) sweep. With a single group this is the same as calcProjectedMInv().
+@see calcProjectedMInv() **/
+void calcProjectedMInvBlocks
+   (const State&                          s,
+    Array_< Array_<MultiplierIndex> >&    blockMultipliers,
+    Array_<Matrix>&                       blocks) const;
+
 /** Given a set of desired constraint-space speed changes, calculate the
 corresponding constraint-space impulses that would cause those changes. Here we 
 are solving the equation
@@ -2589,6 +2800,19 @@ are guaranteed to be available by Stage::Acceleration.
 @see invalidateArticulatedBodyInertias() **/
 void realizeArticulatedBodyInertias(const State&) const;
 
+/** This method checks whether the sparse mass matrix factorization used by
+solveWithMFactorization() and calcMInvSubmatrix() has already been computed 
+since the last change to a Position stage state variable (q) and if so returns
+immediately at little cost; otherwise, it computes the factorization. It is 
+not otherwise computed until one of those methods needs it. This will realize
+composite body inertias also if necessary. The mass matrix must be positive 
+definite; an exception is thrown if it isn't, for example if there are 
+massless terminal bodies.
+@par Required stage
+  \c Stage::Position, or \c Stage::Instance and \c PositionKinematics
+@see invalidateMFactorization() **/
+void realizeMFactorization(const State&) const;
+
 /** (Advanced) This method ensures that velocity-dependent computations that 
 also depend on articulated body inertias (ABIs) are up to date with the most 
 recent changes to the configuration state variables q and velocity state 
@@ -2866,6 +3090,41 @@ realize(Acceleration); false if isPositionKinematicsRealized() would return
 false, or after a call to invalidateArticulatedBodyInertias(). **/
 bool isArticulatedBodyInertiasRealized(const State&) const;
 
+/** (Advanced) Return the number of mobilized bodies (not counting Ground) whose
+position kinematics was calculated the last time position kinematics was 
+realized in this State. This is the total number of mobilized bodies except
+when incremental position kinematics is enabled and only some of the q's have
+changed. It returns zero if position kinematics hasn't been realized since the
+last Instance-stage change. 
+@see setUseIncrementalPositionKinematics() **/
+int getNumBodiesRecalculatedInPositionKinematics(const State&) const;
+
+/** (Advanced) Return the total number of position and velocity constraint 
+projection matrices that have been formed and factored by projectQ() and 
+projectU() in modified Newton mode, in this State and the States it was copied
+from. Full Newton projections aren't counted, so this is always zero unless 
+modified Newton projection is enabled.
+@see getNumProjectionFactorizationReuses(), setUseModifiedNewtonProjection() **/
+int getNumProjectionFactorizations(const State&) const;
+
+/** (Advanced) Return the total number of calls to projectQ() and projectU() in
+this State and the States it was copied from that started with a factored 
+matrix saved by an earlier projection rather than factoring a new one. This is
+always zero unless modified Newton projection is enabled.
+@see getNumProjectionFactorizations(), setUseModifiedNewtonProjection() **/
+int getNumProjectionFactorizationReuses(const State&) const;
+
+/** (Advanced) This is useful for timing computation time for 
+realizeMFactorization(), which otherwise will not recalculate the 
+factorization if called repeatedly. **/
+void invalidateMFactorization(const State& state) const;
+
+/** (Advanced) Check whether the sparse mass matrix factorization has already
+been realized. This will be true after realizeMFactorization() or any method
+that uses it; false if isPositionKinematicsRealized() would return false or 
+after a call to invalidateMFactorization(). **/
+bool isMFactorizationRealized(const State&) const;
+
 /** (Advanced) Force invalidation of articulated body velocity computations, 
 which otherwise remain valid until a velocity- or position-stage variable is
 modified or any other prerequisite is invalidated. This is useful for timing 
@@ -36,6 +36,9 @@ patch analysis methods.
 #include "simbody/internal/SimbodyMatterSubsystem.h"
 #include "simbody/internal/MultibodySystem.h"
 
+#include "NearestFaceGuesses.h"
+#include "ParallelLoop.h"
+
 namespace SimTK {
 
 //==============================================================================
@@ -67,6 +70,10 @@ void setTrackDissipatedEnergy(bool shouldTrack) {
 }
 bool getTrackDissipatedEnergy() const {return m_trackDissipatedEnergy;}
 
+void setNumberOfThreads(int numThreads) 
+{   m_forceLoop.setNumberOfThreads(numThreads); }
+int getNumberOfThreads() const {return m_forceLoop.getNumberOfThreads();}
+
 int getNumContactForces(const State& s) const {
     ensureForceCacheValid(s);
     const Array_<ContactForce>& forces = getForceCache(s);
@@ -230,6 +237,10 @@ int realizeSubsystemTopologyImpl(State& s) const override {
     // calculate the forces.
     wThis->m_potEnergyCacheIx = allocateLazyCacheEntry(s, 
         Stage::Position, new Value<Real>(NaN));
+    // Mesh-mesh elastic foundation contacts remember the nearest faces they 
+    // found here. This is never marked valid; it is just a hint.
+    wThis->m_nearestFacesCacheIx = allocateLazyCacheEntry(s,
+        Stage::Position, new Value<NearestFaceGuesses>());
 
     // This state variable is used to integrate power to get dissipated
     // energy. Allocate only if requested.
@@ -325,6 +336,11 @@ const Real& getDissipatedEnergyVar(const State& s) const
 Real& updDissipatedEnergyVar(State& s) const
 {   return updZ(s)[m_dissipatedEnergyIx]; }
 
+// Mesh-mesh contact generators keep their nearest face guesses here.
+NearestFaceGuesses& updNearestFaceGuesses(const State& s) const
+{   return Value<NearestFaceGuesses>::updDowncast
+                                    (updCacheEntry(s,m_nearestFacesCacheIx)); }
+
 //--------------------------------------------------------------------------
                                   private:
 
@@ -391,6 +407,10 @@ ContactForceGenerator*              m_defaultGenerator;
 ZIndex                              m_dissipatedEnergyIx;
 CacheEntryIndex                     m_potEnergyCacheIx;
 CacheEntryIndex                     m_forceCacheIx;
+CacheEntryIndex                     m_nearestFacesCacheIx;
+
+// Optionally calculates contact forces on several threads.
+ParallelLoop                        m_forceLoop;
 };
 
 void CompliantContactSubsystemImpl::
@@ -419,14 +439,17 @@ ensurePotentialEnergyCacheValid(const State& state) const {
     // results except for the PE.
     const ContactSnapshot& active = m_tracker.getActiveContacts(state);
     const int nContacts = active.getNumContacts();
-    for (int i=0; i<nContacts; ++i) {
+    Array_<Real> contactPE(nContacts);
+    m_forceLoop.forEachIndex(nContacts, [&](int i) {
         const Contact& contact = active.getContact(i);
         const ContactForceGenerator& generator = 
             getForceGenerator(contact.getTypeId());
         ContactForce force;
         generator.calcContactForce(state,contact,SpatialVec(Vec3(0)), force);
-        pe += force.getPotentialEnergy();
-    }
+        contactPE[i] = force.getPotentialEnergy();
+    });
+    for (int i=0; i<nContacts; ++i)
+        pe += contactPE[i]; // always in the same order
 
     markPotentialEnergyCacheValid(state);
 }
@@ -439,17 +462,21 @@ ensureForceCacheValid(const State& state) const {
     SimTK_STAGECHECK_GE_ALWAYS(getStage(state), Stage::Velocity,
         "CompliantContactSubystemImpl::ensureForceCacheValid()");
 
-    Array_<ContactForce>& forces = updForceCache(state);
-    forces.clear();
-
-
+    // Each contact's force goes in its own slot so that the contacts can be
+    // processed in parallel. Then we squeeze out the contacts that didn't
+    // generate a force, preserving the order so that everything downstream
+    // (including the accumulation of body forces) is the same regardless of
+    // the number of threads.
     const ContactSnapshot& active = m_tracker.getActiveContacts(state);
     const int nContacts = active.getNumContacts();
-    for (int i=0; i<nContacts; ++i) {
+    Array_<ContactForce>& forces = updForceCache(state);
+    forces.resize(nContacts);
+    m_forceLoop.forEachIndex(nContacts, [&](int i) {
+        forces[i] = ContactForce(); // invalid
         const Contact& contact = active.getContact(i);
         if (contact.getCondition() == Contact::Broken) {
             // No need to generate forces; this will be gone next time.
-            continue;
+            return;
         }
         const Transform& X_S1S2 = contact.getTransform();
         const ContactSurfaceIndex surf1(contact.getSurface1());
@@ -476,15 +503,21 @@ ensureForceCacheValid(const State& state) const {
 
         const ContactForceGenerator& generator = 
             getForceGenerator(contact.getTypeId());
-        forces.push_back(); // allocate a new garbage ContactForce
         // Calculate the contact force measured and expressed in S1.
-        generator.calcContactForce(state, contact, V_S1S2, forces.back());
+        generator.calcContactForce(state, contact, V_S1S2, forces[i]);
         // Re-express the contact force in Ground for later use.
-        if (forces.back().isValid())
-            forces.back().changeFrameInPlace(X_GS1); // switch to Ground
-        else
-            forces.pop_back(); // never mind ...
+        if (forces[i].isValid())
+            forces[i].changeFrameInPlace(X_GS1); // switch to Ground
+    });
+
+    int nForces = 0;
+    for (int i=0; i < nContacts; ++i) {
+        if (!forces[i].isValid())
+            continue; // never mind ...
+        if (nForces != i) forces[nForces] = forces[i];
+        ++nForces;
     }
+    forces.resize(nForces);
 
     markForceCacheValid(state);
 }
@@ -545,6 +578,14 @@ void CompliantContactSubsystem::setTrackDissipatedEnergy(bool shouldTrack)
 bool CompliantContactSubsystem::getTrackDissipatedEnergy() const
 {   return getImpl().getTrackDissipatedEnergy(); }
 
+void CompliantContactSubsystem::setNumberOfThreads(int numThreads) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, "CompliantContactSubsystem",
+        "setNumberOfThreads", "Illegal number of threads %d.", numThreads);
+    updImpl().setNumberOfThreads(numThreads);
+}
+int CompliantContactSubsystem::getNumberOfThreads() const
+{   return getImpl().getNumberOfThreads(); }
+
 int CompliantContactSubsystem::getNumContactForces(const State& s) const
 {   return getImpl().getNumContactForces(s); }
 
@@ -1696,7 +1737,7 @@ void ContactForceGenerator::ElasticFoundation::calcContactForceAndDetails
 
         processOneMesh(state, 
             mesh, contact.getSurface1Faces(),
-            X_S1S2, V_S1S2, shape2,
+            X_S1S2, V_S1S2, shape2, surf1x, surf2x,
             s1, areaScale1,
             kh, c, us, ud, uv,
             patchCentroid_S1,
@@ -1726,7 +1767,7 @@ void ContactForceGenerator::ElasticFoundation::calcContactForceAndDetails
 
         processOneMesh(state, 
             mesh, contact.getSurface2Faces(),
-            X_S2S1, V_S2S1, shape1,
+            X_S2S1, V_S2S1, shape1, surf2x, surf1x,
             s2, areaScale2,
             kh, c, us, ud, uv,
             patchCentroid_S2,
@@ -1828,6 +1869,8 @@ processOneMesh
     const Transform&                        X_MO, 
     const SpatialVec&                       V_MO,
     const ContactGeometry&                  other,
+    ContactSurfaceIndex                     meshSurf,
+    ContactSurfaceIndex                     otherSurf,
     Real                                    meshDeformationFraction, // 0..1
     Real                                    areaScaleFactor,
     Real kh, Real c, Real us, Real ud, Real uv, // composite material props
@@ -1861,21 +1904,42 @@ processOneMesh
     const Real vtrans   = subsys.getTransitionVelocity();
     const Real ooVtrans = subsys.getOOTransitionVelocity(); // 1/vtrans
 
+    // Find the nearest point on the other surface to every spring (face 
+    // centroid). If the other surface is a mesh, do them all at once so that
+    // each search can start from the face that was nearest last time.
+    const Array_<int> faces(insideFaces.begin(), insideFaces.end());
+    const Transform X_OM = ~X_MO;
+    Array_<Vec3> springPos_O(faces.size()), nearestPoint_O(faces.size());
+    Array_<bool> inside(faces.size());
+    Array_<UnitVec3> normal_O(faces.size()); // not used
+    for (unsigned i=0; i < faces.size(); ++i) // 18 flops each
+        springPos_O[i] = X_OM*mesh.findCentroid(faces[i]);
+    if (ContactGeometry::TriangleMesh::isInstance(other)) {
+        const CompliantContactSubsystemImpl& subsysImpl = 
+            SimTK_DYNAMIC_CAST_DEBUG<const CompliantContactSubsystemImpl&>
+                (subsys.getSubsystemGuts());
+        subsysImpl.updNearestFaceGuesses(state).findNearestPoints
+           (meshSurf, otherSurf, mesh.getNumFaces(), faces, 
+            ContactGeometry::TriangleMesh::getAs(other), springPos_O, 
+            nearestPoint_O, inside, normal_O);
+    } else {
+        for (unsigned i=0; i < faces.size(); ++i) {
+            bool isInside;
+            nearestPoint_O[i] = 
+                other.findNearestPoint(springPos_O[i], isInside, normal_O[i]);
+            inside[i] = isInside;
+        }
+    }
+
     // Now loop over all the faces again, evaluate the force from each 
     // spring, and apply it at the patch centroid.
     // This costs roughly 300 flops per contacting face.
-    for (std::set<int>::const_iterator iter = insideFaces.begin(); 
-                                       iter != insideFaces.end(); ++iter) 
-    {   const int   face        = *iter;
+    for (unsigned i=0; i < faces.size(); ++i) 
+    {   if (!inside[i])
+            continue;
+        const int   face        = faces[i];
         const Vec3  springPos_M = mesh.findCentroid(face);
         const Real  faceArea    = areaScaleFactor*mesh.getFaceArea(face);
-
-        bool        inside;
-        UnitVec3    normal_O; // not used
-        const Vec3  nearestPoint_O = // 18 flops + cost of findNearestPoint
-            other.findNearestPoint(~X_MO*springPos_M, inside, normal_O);
-        if (!inside)
-            continue;
         
         // Although the "spring" is associated with just one surface (the mesh M)
         // it is considered here to include the compression of both surfaces
@@ -1888,7 +1952,7 @@ processOneMesh
         // i.e., in the  direction that the force will be applied to the 
         // "other" body. This is the same convention we use for the patch 
         // normal for Hertz contact.
-        const Vec3 nearestPoint_M = X_MO*nearestPoint_O; // 18 flops
+        const Vec3 nearestPoint_M = X_MO*nearestPoint_O[i]; // 18 flops
         const Vec3 overlap_M      = springPos_M - nearestPoint_M; // 3 flops
         const Real overlap        = overlap_M.norm(); // ~40 flops
 
@@ -3092,6 +3092,12 @@ Implementation* clone() const override {
     return newCoupler;
 }
 
+// Allocate the scratch space for the Function arguments.
+void realizeTopology(State& state) const override {
+    functionArgsIx = getMatterSubsystem().allocateLazyCacheEntry(state, 
+        Stage::Instance, new Value<Vector>(Vector((int)coordBodies.size())));
+}
+
 void calcPositionErrors     
    (const State&                                    state,
     const Array_<Transform,ConstrainedBodyIndex>&   X_AB, 
@@ -3126,11 +3132,16 @@ Array_<ConstrainedMobilizerIndex>   coordBodies;
 Array_<MobilizerQIndex>             coordIndices;
 
 //  TOPOLOGY CACHE
-//  None.
 
-//  A reusable temporary variable allocated to the correct size
-//  to hold all the Function arguments.
-mutable Vector                      temp;
+// The Function arguments are gathered into a Vector in the State, which 
+// is never marked valid, so that the error and force methods don't have to 
+// allocate one each time.
+mutable CacheEntryIndex             functionArgsIx;
+
+Vector& updFunctionArgs(const State& state) const {
+    return Value<Vector>::updDowncast
+       (getMatterSubsystem().updCacheEntry(state, functionArgsIx));
+}
 
 // This allows copies to be made of this constraint which share
 // the function object.
@@ -3165,6 +3176,13 @@ Implementation* clone() const override {
     return new SpeedCouplerImpl(*this);
 }
 
+// Allocate the scratch space for the Function arguments.
+void realizeTopology(State& state) const override {
+    functionArgsIx = getMatterSubsystem().allocateLazyCacheEntry(state, 
+        Stage::Instance, new Value<Vector>
+           (Vector((int)(speedBodies.size() + coordBodies.size()))));
+}
+
 void calcVelocityErrors     
    (const State&                                    state,
     const Array_<SpatialVec,ConstrainedBodyIndex>&  V_AB, 
@@ -3192,7 +3210,14 @@ Array_<ConstrainedMobilizerIndex>   speedBodies;
 Array_<MobilizedBodyIndex>          coordBodies;
 Array_<MobilizerUIndex>             speedIndices;
 Array_<MobilizerQIndex>             coordIndices;
-mutable Vector                      temp;
+
+// Function arguments; see CoordinateCouplerImpl.
+mutable CacheEntryIndex             functionArgsIx;
+
+Vector& updFunctionArgs(const State& state) const {
+    return Value<Vector>::updDowncast
+       (getMatterSubsystem().updCacheEntry(state, functionArgsIx));
+}
 };
 
 
@@ -3220,6 +3245,12 @@ Implementation* clone() const override {
     return new PrescribedMotionImpl(*this);
 }
 
+// Allocate the scratch space for the Function argument (time).
+void realizeTopology(State& state) const override {
+    functionArgsIx = getMatterSubsystem().allocateLazyCacheEntry(state, 
+        Stage::Instance, new Value<Vector>(Vector(1)));
+}
+
 void calcPositionErrors     
    (const State&                                    state,
     const Array_<Transform,ConstrainedBodyIndex>&   X_AB, 
@@ -3250,7 +3281,14 @@ const Function*             function;
 int*                        referenceCount;
 ConstrainedMobilizerIndex   coordBody;
 MobilizerQIndex             coordIndex;
-mutable Vector              temp;
+
+// Function argument; see CoordinateCouplerImpl.
+mutable CacheEntryIndex     functionArgsIx;
+
+Vector& updFunctionArgs(const State& state) const {
+    return Value<Vector>::updDowncast
+       (getMatterSubsystem().updCacheEntry(state, functionArgsIx));
+}
 };
 
 
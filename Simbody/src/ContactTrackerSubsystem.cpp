@@ -27,10 +27,13 @@
 #include "simbody/internal/SimbodyMatterSubsystem.h"
 #include "simbody/internal/ContactTrackerSubsystem.h"
 
+#include "ParallelLoop.h"
+
 #include <utility>
 using std::pair; using std::make_pair;
 #include <iostream>
 using std::cout; using std::endl;
+#include <algorithm>
 #include <set>
 
 using namespace SimTK;
@@ -67,22 +70,93 @@ static std::ostream& operator<<(std::ostream& o, const Bubble& bb) {
     return o;
 }
 
-// For spatial sorting of bubbles.
-class BubbleExtent {
+// A node of the bounding box hierarchy the broad phase builds over the 
+// bubbles. Every node covers a contiguous run order[begin,end) of the
+// bubbles, and an internal node's two children split its run in half.
+struct BubbleBoxNode {
+    Vec3    lo, hi;         // box enclosing the node's bubbles, in Ground
+    int     begin, end;     // the node's run of BroadPhaseCache::order
+    int     left, right;    // child nodes, or -1 if this is a leaf
+};
+
+// Orders bubbles by one coordinate of their centers.
+class BubbleCenterLess {
 public:
-    BubbleExtent(Real start, Real end, BubbleIndex index) 
-    :   start(start), end(end), index(index) {}
-    BubbleExtent() {}
-    bool operator<(const BubbleExtent& e) const 
-    {   return start < e.start; }
-    Real        start, end; // span along chosen sort axis
-    BubbleIndex index;
+    BubbleCenterLess(const Array_<Vec3,BubbleIndex>& centers, int axis) 
+    :   centers(centers), axis(axis) {}
+    bool operator()(BubbleIndex b1, BubbleIndex b2) const 
+    {   return centers[b1][axis] < centers[b2][axis]; }
+private:
+    const Array_<Vec3,BubbleIndex>& centers;
+    int                             axis;
 };
-static std::ostream& operator<<(std::ostream& o, const BubbleExtent& bx) {
-    o << bx.index << ":(" << bx.start << "," << bx.end << ")";
+
+// Workspace for the broad phase, kept in the State so that we don't have to
+// allocate it from the heap each time and so that States realized 
+// concurrently don't share it. Nothing here affects the results.
+struct BroadPhaseCache {
+    Array_<Vec3,BubbleIndex>    centers;    // bubble centers in Ground
+    Array_<BubbleIndex,int>     order;      // bubbles grouped by tree node
+    Array_<BubbleBoxNode,int>   nodes;      // the tree; nodes[0] is the root
+    Array_<int>                 stack;      // nodes waiting to be visited
+};
+static std::ostream& operator<<(std::ostream& o, const BroadPhaseCache& bpc) {
+    o << "order: " << bpc.order << "\n";
     return o;
 }
 
+static bool boxesOverlap(const Vec3& lo1, const Vec3& hi1, 
+                         const Vec3& lo2, const Vec3& hi2) {
+    return lo1[0] <= hi2[0] && lo2[0] <= hi1[0]
+        && lo1[1] <= hi2[1] && lo2[1] <= hi1[1]
+        && lo1[2] <= hi2[2] && lo2[2] <= hi1[2];
+}
+
+// Build the subtree holding the bubbles in bpc.order[begin,end) and return 
+// the index of its root node. The run is split at the median center along 
+// the direction in which the centers are most spread out, so the tree is 
+// balanced whatever the shape of the cloud of bubbles.
+static int buildBubbleTree(const Array_<Bubble,BubbleIndex>& bubbles, 
+                           BroadPhaseCache& bpc, int begin, int end) {
+    const int MaxLeafBubbles = 4;
+    const int nodeIndex = bpc.nodes.size();
+    bpc.nodes.push_back(); // default construct; filled in below
+
+    Vec3 lo(Infinity), hi(-Infinity), centerLo(Infinity), centerHi(-Infinity);
+    for (int i=begin; i < end; ++i) {
+        const BubbleIndex bbx = bpc.order[i];
+        const Vec3& center = bpc.centers[bbx];
+        const Real  radius = bubbles[bbx].getRadius();
+        for (int k=0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], center[k]-radius);
+            hi[k] = std::max(hi[k], center[k]+radius);
+            centerLo[k] = std::min(centerLo[k], center[k]);
+            centerHi[k] = std::max(centerHi[k], center[k]);
+        }
+    }
+
+    int left = -1, right = -1;
+    if (end-begin > MaxLeafBubbles) {
+        const Vec3 spread = centerHi - centerLo;
+        int axis = (spread[0] > spread[1] ? 0 : 1);
+        if (spread[2] > spread[axis])
+            axis = 2;
+        const int mid = (begin+end)/2;
+        std::nth_element(bpc.order.begin()+begin, bpc.order.begin()+mid,
+                         bpc.order.begin()+end, 
+                         BubbleCenterLess(bpc.centers, axis));
+        left  = buildBubbleTree(bubbles, bpc, begin, mid);
+        right = buildBubbleTree(bubbles, bpc, mid, end);
+    }
+
+    // Children were appended after us so this reference is safe now.
+    BubbleBoxNode& node = bpc.nodes[nodeIndex];
+    node.lo = lo; node.hi = hi;
+    node.begin = begin; node.end = end;
+    node.left = left; node.right = right;
+    return nodeIndex;
+}
+
 typedef std::map< pair<ContactGeometryTypeId,ContactGeometryTypeId>,
                   pair<ContactTracker*,bool> > TrackerMap;
 
@@ -97,6 +171,15 @@ typedef std::map< pair<ContactGeometryTypeId,ContactGeometryTypeId>,
 typedef std::map<ContactSurfaceIndex,const Contact*> ContactSurfaceSet;
 typedef std::map<ContactSurfaceIndex,ContactSurfaceSet> PairMap;
 
+// One surface pair for the narrow phase, with the surfaces in the order
+// required by its tracker. The previous Contact is null if this pair wasn't
+// being tracked.
+struct TrackingJob {
+    ContactSurfaceIndex     surf1, surf2;
+    const ContactTracker*   tracker;
+    const Contact*          prev;
+};
+
 std::ostream& operator<<(std::ostream& o, const ContactSurfaceSet& css) {
     ContactSurfaceSet::const_iterator p = css.begin();
     o << "{";
@@ -224,6 +307,10 @@ int realizeSubsystemTopologyImpl(State& state) const override {
     wThis->m_predictedContactsIx = allocateAutoUpdateDiscreteVariable
         (state, Stage::Dynamics, new Value<ContactSnapshot>(), 
          Stage::Acceleration);  // update depends on accelerations
+    // This is never marked valid; we just update it whenever we run the
+    // broad phase.
+    wThis->m_broadPhaseCacheIx = allocateLazyCacheEntry
+        (state, Stage::Position, new Value<BroadPhaseCache>());
 
     const SimbodyMatterSubsystem& matter = getMatterSubsystem();
 
@@ -277,80 +364,85 @@ int realizeSubsystemVelocityImpl(const State& state) const override {
 // Adds new pairs to the existing set, if not already present.
 void addInBroadPhasePairs(const State& state, PairMap& pairs) const {
     const int numBubbles = getNumBubbles();
+    if (numBubbles == 0)
+        return;
+    BroadPhaseCache& bpc = Value<BroadPhaseCache>::updDowncast
+                                (updCacheEntry(state, m_broadPhaseCacheIx));
     
-    // Perform a sweep-and-prune on a single axis to identify potential 
-    // contacts. First, find which axis has the most variation in body 
-    // locations. That is the axis we will use.
-    // TODO: this one-axis method is not good enough in general
-    
-    Vector_<Vec3> centers(numBubbles);
+    // Build a hierarchy of axis-aligned boxes around the bubbles. Unlike a
+    // sweep along one axis, this prunes in all three directions, so it stays
+    // fast when many bubbles overlap along any one axis, for example when 
+    // they are spread over a plane.
+    Array_<Vec3,BubbleIndex>& centers = bpc.centers;
+    centers.resize(numBubbles);
     for (BubbleIndex bbx(0); bbx < numBubbles; ++bbx) {
         const Bubble&  bubb = m_bubbles[bbx];
         const Surface& surf = m_surfaces[bubb.surface];
         centers[bbx] = surf.mobod->getBodyTransform(state) 
                         * bubb.getCenter();
     }
-    Vec3 average = mean(centers);
-    Vec3 var(0);
+    Array_<BubbleIndex,int>& order = bpc.order;
+    order.resize(numBubbles);
     for (BubbleIndex bbx(0); bbx < numBubbles; ++bbx)
-        var += abs(centers[bbx]-average);
-    int axis = (var[0] > var[1] ? 0 : 1);
-    if (var[2] > var[axis])
-        axis = 2;
+        order[bbx] = bbx;
+    bpc.nodes.clear();
+    buildBubbleTree(m_bubbles, bpc, 0, numBubbles);
     
-    // Find the extent of each bubble along the axis and sort them by 
-    // starting location.
-    Array_<BubbleExtent,int> extents(numBubbles);
-    for (BubbleIndex bbx(0); bbx < numBubbles; ++bbx) {
-        const Real radius = m_bubbles[bbx].getRadius();
-        const Real center = centers[bbx][axis];
-        extents[bbx] = BubbleExtent(center-radius, center+radius, bbx);
-    }
-    //cout << "Bubble extents:" << extents << "\n";
+    // Now find each bubble's potential contacts by descending the tree with 
+    // its box. The bubble at order[p] is paired only with bubbles later in
+    // the order so that every pair is considered just once; that also lets
+    // us skip any node whose bubbles all come before p.
+    Array_<int>& stack = bpc.stack;
+    for (int p=0; p < numBubbles; ++p) {
+        const BubbleIndex bbx1    = order[p];
+        const Bubble&     bubb1   = m_bubbles[bbx1];
+        const Real        radius1 = bubb1.getRadius();
+        const Vec3&       center1 = centers[bbx1];
+        const Vec3        lo1 = center1 - Vec3(radius1);
+        const Vec3        hi1 = center1 + Vec3(radius1);
+
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const BubbleBoxNode& node = bpc.nodes[stack.back()];
+            stack.pop_back();
+            if (node.end <= p+1 || !boxesOverlap(lo1, hi1, node.lo, node.hi))
+                continue;
+            if (node.left >= 0) {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+                continue;
+            }
 
-    // Expensive: O(n log n)
-    std::sort(extents.begin(), extents.end());
-    
-    // Now sweep along the axis, finding potential contacts.
-    
-    for (int ex1=0; ex1 < numBubbles; ++ex1) {
-        const BubbleExtent& extent1 = extents[ex1];
-        const Bubble&       bubb1   = m_bubbles[extent1.index];
-        const Real          radius1 = bubb1.getRadius();
-        const Vec3&         center1 = centers[extent1.index];
-
-        // Loop over just the overlapping bubbles.
-        for (int ex2(ex1+1); ex2 < numBubbles; ++ex2) {
-            const BubbleExtent& extent2 = extents[ex2];
-            if (extent2.start > extent1.end)
-                break;  // no more bubbles can overlap with extent1
-
-            // These bubbles do overlap along this axis. See if they are
-            // actually touching.
-            const Bubble& bubb2   = m_bubbles[extent2.index];
-            const Real    radius2 = bubb2.getRadius();
-            const Vec3&   center2 = centers[extent2.index];
-            if ((center1-center2).normSqr() > square(radius1+radius2))
-                continue; // nope
-
-            // The bubbles are touching. We'll add the corresponding surfaces
-            // to the narrow-phase list unless there are relevant exclusions.
-            const Surface& surf1 = m_surfaces[bubb1.surface];
-            const Surface& surf2 = m_surfaces[bubb2.surface];
-            // Ignore if on the same body.
-            if (surf1.mobod == surf2.mobod) continue;
-            assert(bubb1.surface != bubb2.surface); // duh!
-            // Ignore if surfaces are in a common clique.
-            if (surf1.surface->isInSameClique(*surf2.surface)) continue;
-            // We'll need to do a narrow phase investigation of these two
-            // surfaces; use the lower-numbered one as the index to avoid
-            // duplicates.
-            ContactSurfaceIndex low=bubb1.surface, high=bubb2.surface;
-            if (low > high) std::swap(low,high);
-            ContactSurfaceSet& surfSet = pairs[low];
-            // Insert this pair with null Contact if the pair isn't already
-            // in the PairMap.
-            surfSet.insert(make_pair(high,(Contact*)0));
+            for (int q=std::max(node.begin, p+1); q < node.end; ++q) {
+                // These bubbles' boxes overlap. See if they are actually 
+                // touching.
+                const Bubble& bubb2   = m_bubbles[order[q]];
+                const Real    radius2 = bubb2.getRadius();
+                const Vec3&   center2 = centers[order[q]];
+                if ((center1-center2).normSqr() > square(radius1+radius2))
+                    continue; // nope
+
+                // The bubbles are touching. We'll add the corresponding 
+                // surfaces to the narrow-phase list unless there are relevant
+                // exclusions.
+                const Surface& surf1 = m_surfaces[bubb1.surface];
+                const Surface& surf2 = m_surfaces[bubb2.surface];
+                // Ignore if on the same body.
+                if (surf1.mobod == surf2.mobod) continue;
+                assert(bubb1.surface != bubb2.surface); // duh!
+                // Ignore if surfaces are in a common clique.
+                if (surf1.surface->isInSameClique(*surf2.surface)) continue;
+                // We'll need to do a narrow phase investigation of these two
+                // surfaces; use the lower-numbered one as the index to avoid
+                // duplicates.
+                ContactSurfaceIndex low=bubb1.surface, high=bubb2.surface;
+                if (low > high) std::swap(low,high);
+                ContactSurfaceSet& surfSet = pairs[low];
+                // Insert this pair with null Contact if the pair isn't 
+                // already in the PairMap.
+                surfSet.insert(make_pair(high,(Contact*)0));
+            }
         }
     }
 }
@@ -408,71 +500,87 @@ void ensureActiveContactsUpdated(const State& state) const {
     addInBroadPhasePairs(state, interesting);
     //cout << "Interesting pairs:\n" << interesting << "\n";
 
+    // Flatten the interesting pairs into a list of narrow phase jobs, in
+    // surface order, skipping pairs for which we have no tracker.
+    Array_<TrackingJob> jobs;
     PairMap::const_iterator p = interesting.begin();
     for (; p != interesting.end(); ++p) {
         const ContactSurfaceIndex index1 = p->first;
-        const Transform transform1 = 
-            m_surfaces[index1].mobod->getBodyTransform(state)
-                * m_surfaces[index1].X_BS;
-        const ContactGeometry& geom1 = m_surfaces[index1].surface->getShape();
-        const ContactGeometryTypeId typeId1 = geom1.getTypeId();
+        const ContactGeometryTypeId typeId1 = 
+            m_surfaces[index1].surface->getShape().getTypeId();
 
         const ContactSurfaceSet& others = p->second;
         ContactSurfaceSet::const_iterator q = others.begin();
         for (; q != others.end(); ++q) {
             const ContactSurfaceIndex index2 = q->first;
-            const Transform transform2 = 
-                m_surfaces[index2].mobod->getBodyTransform(state)
-                    * m_surfaces[index2].X_BS;
-            const ContactGeometry& geom2 = 
-                m_surfaces[index2].surface->getShape();
-            const ContactGeometryTypeId typeId2 = geom2.getTypeId();
+            const ContactGeometryTypeId typeId2 = 
+                m_surfaces[index2].surface->getShape().getTypeId();
             if (!hasContactTracker(typeId1,typeId2))
                 continue; // No algorithm available for detecting collisions between these two objects.
             bool mustReverse;
             const ContactTracker& tracker = 
                 getContactTracker(typeId1, typeId2, mustReverse);
 
+            TrackingJob job;
+            job.tracker = &tracker;
             // Put the surfaces in the order required by the tracker.
-            const ContactSurfaceIndex trackSurf1 = (mustReverse? index2:index1);
-            const ContactSurfaceIndex trackSurf2 = (mustReverse? index1:index2);
-
-            UntrackedContact untracked; // empty handle in case we need it
-            const Contact* prev = q->second;
-            if (prev && prev->getCondition() == Contact::Broken)
-                prev = 0; // that contact expired
-            if (!prev) { 
-                untracked = UntrackedContact(trackSurf1, trackSurf2);
-                prev = &untracked;
-            }
-            Contact next; // empty handle
-            if (mustReverse)
-                tracker.trackContact
-                   (*prev, transform2,geom2, transform1,geom1, 0/*TODO*/, next);
-            else
-                tracker.trackContact
-                   (*prev, transform1,geom1, transform2,geom2, 0/*TODO*/, next);
-
-            if (!next.isEmpty()) {
-                next.setSurfaces(trackSurf1,trackSurf2);
-                next.setContactId(prev->getCondition()==Contact::Untracked
-                                    ? Contact::createNewContactId()
-                                    : prev->getContactId()); // persistent
-                if (   prev->getCondition()==Contact::Untracked
-                    || prev->getCondition()==Contact::Anticipated)
-                    next.setCondition(Contact::NewContact);
-                else { // was NewContact or Ongoing; now Ongoing or Broken
-                    assert(prev->getCondition()==Contact::NewContact
-                           || prev->getCondition()==Contact::Ongoing);
-                    if (next.getTypeId() != BrokenContact::classTypeId())
-                        next.setCondition(Contact::Ongoing);
-                    // Condition will already by Broken for a BrokenContact
-                }
-                nextActive.adoptContact(next);
-            }
+            job.surf1 = (mustReverse? index2:index1);
+            job.surf2 = (mustReverse? index1:index2);
+            job.prev  = q->second;
+            if (job.prev && job.prev->getCondition() == Contact::Broken)
+                job.prev = 0; // that contact expired
+            jobs.push_back(job);
         }
     }
 
+    // The narrow phase calculations are independent so they can be done
+    // in parallel; each writes only its own entry in nextContacts.
+    Array_<Contact> nextContacts(jobs.size());
+    m_narrowPhaseLoop.forEachIndex(jobs.size(), [&](int i) {
+        const TrackingJob& job = jobs[i];
+        const Surface& surf1 = m_surfaces[job.surf1];
+        const Surface& surf2 = m_surfaces[job.surf2];
+        const Transform X_GS1 = surf1.mobod->getBodyTransform(state)*surf1.X_BS;
+        const Transform X_GS2 = surf2.mobod->getBodyTransform(state)*surf2.X_BS;
+
+        UntrackedContact untracked; // empty handle in case we need it
+        const Contact* prev = job.prev;
+        if (!prev) { 
+            untracked = UntrackedContact(job.surf1, job.surf2);
+            prev = &untracked;
+        }
+        job.tracker->trackContact(*prev, X_GS1, surf1.surface->getShape(),
+                                         X_GS2, surf2.surface->getShape(),
+                                  0/*TODO*/, nextContacts[i]);
+    });
+
+    // Now record the new contacts serially in job order so that the
+    // snapshot and the new contact ids don't depend on the number of threads.
+    for (int i=0; i < (int)jobs.size(); ++i) {
+        const TrackingJob& job  = jobs[i];
+        Contact&           next = nextContacts[i];
+        if (next.isEmpty())
+            continue;
+        const Contact::Condition prevCondition = 
+            job.prev ? job.prev->getCondition() : Contact::Untracked;
+
+        next.setSurfaces(job.surf1,job.surf2);
+        next.setContactId(prevCondition==Contact::Untracked
+                            ? Contact::createNewContactId()
+                            : job.prev->getContactId()); // persistent
+        if (   prevCondition==Contact::Untracked
+            || prevCondition==Contact::Anticipated)
+            next.setCondition(Contact::NewContact);
+        else { // was NewContact or Ongoing; now Ongoing or Broken
+            assert(prevCondition==Contact::NewContact
+                   || prevCondition==Contact::Ongoing);
+            if (next.getTypeId() != BrokenContact::classTypeId())
+                next.setCondition(Contact::Ongoing);
+            // Condition will already by Broken for a BrokenContact
+        }
+        nextActive.adoptContact(next);
+    }
+
     markDiscreteVarUpdateValueRealized(state, m_activeContactsIx);
 }
 
@@ -591,6 +699,10 @@ Array_<Surface,ContactSurfaceIndex>     m_surfaces;
 Array_<Bubble,BubbleIndex>              m_bubbles;
 DiscreteVariableIndex                   m_activeContactsIx;
 DiscreteVariableIndex                   m_predictedContactsIx;
+CacheEntryIndex                         m_broadPhaseCacheIx;
+
+// Optionally runs the narrow phase on several threads.
+ParallelLoop                            m_narrowPhaseLoop;
 };
 
 } // namespace SimTK
@@ -669,6 +781,15 @@ getContactTracker(ContactGeometryTypeId surface1,
                   bool& reverseOrder) const
 {   return getImpl().getContactTracker(surface1,surface2,reverseOrder); }
 
+void ContactTrackerSubsystem::setNumberOfThreads(int numThreads) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, "ContactTrackerSubsystem",
+        "setNumberOfThreads", "Illegal number of threads %d.", numThreads);
+    updImpl().m_narrowPhaseLoop.setNumberOfThreads(numThreads);
+}
+
+int ContactTrackerSubsystem::getNumberOfThreads() const
+{   return getImpl().m_narrowPhaseLoop.getNumberOfThreads(); }
+
 const ContactSnapshot& ContactTrackerSubsystem::
 getPreviousActiveContacts(const State& state) const
 {   return getImpl().getPrevActiveContacts(state); }
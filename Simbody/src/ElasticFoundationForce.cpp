@@ -138,16 +138,39 @@ void ElasticFoundationForceImpl::processContact
     const Transform t2g = body2.getBodyTransform(state)*subsystem.getBodyTransform(set, otherBodyIndex); // other object to ground
     const Transform t12 = ~t2g*t1g; // mesh to other object
 
+    // Find the nearest point on the other object to every spring. Against 
+    // another mesh, do them all at once so the search can start from the 
+    // faces found last time.
+
+    const Array_<int> faces(insideFaces.begin(), insideFaces.end());
+    Array_<Vec3> springPos(faces.size()), nearest(faces.size());
+    Array_<bool> inside(faces.size());
+    Array_<UnitVec3> normals(faces.size());
+    for (unsigned i = 0; i < faces.size(); i++)
+        springPos[i] = t12*param.springPosition[faces[i]];
+    if (ContactGeometry::TriangleMesh::isInstance(otherObject)) {
+        NearestFaceGuesses& guesses = Value<NearestFaceGuesses>::updDowncast
+            (subsystem.updCacheEntry(state, nearestFacesCacheIndex));
+        guesses.findNearestPoints(meshIndex, otherBodyIndex, 
+            (int)param.springPosition.size(), faces, 
+            ContactGeometry::TriangleMesh::getAs(otherObject), springPos, 
+            nearest, inside, normals);
+    } else {
+        for (unsigned i = 0; i < faces.size(); i++) {
+            bool isInside;
+            nearest[i] = otherObject.findNearestPoint(springPos[i], isInside, 
+                                                      normals[i]);
+            inside[i] = isInside;
+        }
+    }
+
     // Loop over all the springs, and evaluate the force from each one.
 
-    for (std::set<int>::const_iterator iter = insideFaces.begin(); 
-                                       iter != insideFaces.end(); ++iter) {
-        int face = *iter;
-        UnitVec3 normal;
-        bool inside;
-        Vec3 nearestPoint = otherObject.findNearestPoint(t12*param.springPosition[face], inside, normal);
-        if (!inside)
+    for (unsigned i = 0; i < faces.size(); i++) {
+        const int face = faces[i];
+        if (!inside[i])
             continue;
+        Vec3 nearestPoint = nearest[i];
         
         // Find how much the spring is displaced.
         
@@ -201,6 +224,8 @@ Real ElasticFoundationForceImpl::calcPotentialEnergy(const State& state) const {
 void ElasticFoundationForceImpl::realizeTopology(State& state) const {
     energyCacheIndex = subsystem.allocateCacheEntry
                         (state, Stage::Dynamics, new Value<Real>());
+    nearestFacesCacheIndex = subsystem.allocateLazyCacheEntry
+                        (state, Stage::Position, new Value<NearestFaceGuesses>());
 }
 
 
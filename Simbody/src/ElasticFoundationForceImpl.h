@@ -28,6 +28,7 @@
 #include "simbody/internal/common.h"
 #include "simbody/internal/ElasticFoundationForce.h"
 #include "ForceImpl.h"
+#include "NearestFaceGuesses.h"
 
 namespace SimTK {
 
@@ -59,6 +60,7 @@ private:
     std::map<ContactSurfaceIndex, Parameters> parameters;
     Real transitionVelocity;
     mutable CacheEntryIndex energyCacheIndex;
+    mutable CacheEntryIndex nearestFacesCacheIndex; // see NearestFaceGuesses
 };
 
 class ElasticFoundationForceImpl::Parameters {
@@ -28,6 +28,8 @@
 #include "simbody/internal/SimbodyMatterSubsystem.h"
 #include "simbody/internal/Force_Gravity.h"
 
+#include <atomic>
+
 #include "ForceImpl.h"
 
 namespace SimTK {
@@ -87,8 +89,7 @@ friend class Force::Gravity;
                 Real                            zeroHeight)
     :   matter(matter), defDirection(direction), defMagnitude(magnitude), 
         defZeroHeight(zeroHeight), 
-        defMobodIsImmune(matter.getNumBodies(), false),
-        numEvaluations(0)
+        defMobodIsImmune(matter.getNumBodies(), false)
     {   defMobodIsImmune.front() = true; } // Ground is always immune
 
     // Constructor from a gravity vector, which might have zero magnitude.
@@ -196,7 +197,9 @@ friend class Force::Gravity;
     DiscreteVariableIndex           parametersIx;
     CacheEntryIndex                 forceCacheIx;
 
-    mutable long long               numEvaluations;
+    // Atomic since States may be realized concurrently; a copy of this
+    // force element starts counting from zero.
+    mutable ResetOnCopy<std::atomic<long long>> numEvaluations;
 };
 
 
@@ -40,6 +40,7 @@
 #include "ForceImpl.h"
 
 #include <memory>
+#include <mutex>
 
 //Threading constants used by CalcForcesTask
 namespace {
@@ -581,9 +582,10 @@ public:
         }
     }
 
-    void setNumberOfThreads(unsigned numThreads) {
-        SimTK_APIARGCHECK_ALWAYS(numThreads > 0, "GeneralForceSubsystemRep",
-                    "setNumberOfThreads", "Number of threads must be positive");
+    void setNumberOfThreads(int numThreads) {
+        SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, "GeneralForceSubsystem",
+            "setNumberOfThreads", "Illegal number of threads %d.", numThreads);
+        std::lock_guard<std::mutex> guard(calcForcesLock);
         calcForcesExecutor = new ParallelExecutor(numThreads);
     }
     
@@ -790,11 +792,11 @@ public:
         // exist?), not the contents.
         if (!cachedForcesAreValidCacheIndex.isValid()) {
             // Call calcForce() on all Forces, in parallel.
-            calcForcesTask->initializeAll(s,
+            executeCalcForcesTask([&](CalcForcesTask& task) {
+                task.initializeAll(s,
                     enabledNonParallelForces, enabledParallelForces,
-                    rigidBodyForces, particleForces, mobilityForces);
-            calcForcesExecutor->execute(calcForcesTask.updRef(),
-                          enabledParallelForces.size() + NumNonParallelThreads);
+                    rigidBodyForces, particleForces, mobilityForces);},
+                enabledParallelForces.size() + NumNonParallelThreads);
 
             // Allow forces to do their own realization, but wait until all
             // forces have executed calcForce(). TODO: not sure if that is
@@ -832,22 +834,22 @@ public:
 
             // Run through all the forces, accumulating directly into the
             // force arrays or indirectly into the cache as appropriate.
-            calcForcesTask->initializeCachedAndNonCached(s,
+            executeCalcForcesTask([&](CalcForcesTask& task) {
+                task.initializeCachedAndNonCached(s,
                                 enabledNonParallelForces, enabledParallelForces,
                                 rigidBodyForces, particleForces, mobilityForces,
                                 rigidBodyForceCache, particleForceCache,
-                                mobilityForceCache);
-            calcForcesExecutor->execute(calcForcesTask.updRef(),
-                          enabledParallelForces.size() + NumNonParallelThreads);
+                                mobilityForceCache);},
+                enabledParallelForces.size() + NumNonParallelThreads);
             cachedForcesAreValid = true;
         } else {
             // Cache already valid; just need to do the non-cached ones (the
             // ones for which dependsOnlyOnPositions is false).
-            calcForcesTask->initializeNonCached(s,
+            executeCalcForcesTask([&](CalcForcesTask& task) {
+                task.initializeNonCached(s,
                                enabledNonParallelForces, enabledParallelForces,
-                               rigidBodyForces, particleForces, mobilityForces);
-            calcForcesExecutor->execute(calcForcesTask.updRef(),
-                          enabledParallelForces.size() + NumNonParallelThreads);
+                               rigidBodyForces, particleForces, mobilityForces);},
+                enabledParallelForces.size() + NumNonParallelThreads);
         }
 
         // Accumulate the values from the cache into the global arrays.
@@ -904,11 +906,33 @@ public:
     }
 
 private:
+    // Initialize the shared calcForcesTask with initTask() and run it on
+    // nTasks threads of the executor. The task holds pointers into the State
+    // being realized, so if another thread is already using it (different
+    // States being realized concurrently) we run a private copy of the task
+    // serially on this thread instead of waiting.
+    template <class InitTask>
+    void executeCalcForcesTask(const InitTask& initTask, int nTasks) const {
+        if (calcForcesLock.try_lock()) {
+            std::lock_guard<std::mutex> guard(calcForcesLock, std::adopt_lock);
+            initTask(calcForcesTask.updRef());
+            calcForcesExecutor->execute(calcForcesTask.updRef(), nTasks);
+            return;
+        }
+        std::unique_ptr<CalcForcesTask> task(calcForcesTask->clone());
+        initTask(*task);
+        task->initialize();
+        for (int i=0; i < nTasks; ++i)
+            task->execute(i);
+        task->finish();
+    }
+
     Array_<Force*>                  forces;
 
     // For parallel calculation of forces.
     mutable ClonePtr<ParallelExecutor>               calcForcesExecutor;
     mutable ClonePtr<CalcForcesTask>                 calcForcesTask;
+    mutable ResetOnCopy<std::mutex>                  calcForcesLock;
     
     // TOPOLOGY "CACHE"
     // These indices must be filled in during realizeTopology and treated
@@ -990,7 +1014,7 @@ void GeneralForceSubsystem::setForceIsDisabled
    (State& state, ForceIndex index, bool disabled) const
 {   getRep().setForceIsDisabled(state, index, disabled); }
 
-void GeneralForceSubsystem::setNumberOfThreads(unsigned numThreads)
+void GeneralForceSubsystem::setNumberOfThreads(int numThreads)
 {   updRep().setNumberOfThreads(numThreads); }
 
 int GeneralForceSubsystem::getNumberOfThreads() const
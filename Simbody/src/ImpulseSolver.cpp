@@ -24,6 +24,8 @@
 #include "simbody/internal/common.h"
 #include "simbody/internal/ImpulseSolver.h"
 
+#include "ParallelLoop.h"
+
 namespace SimTK {
 
 // These static methods assume the "NA" value is -1 and the others count up
@@ -76,4 +78,342 @@ dumpUniContacts(const String& msg,
     printf("------------------------------\n\n");
 }
 
-} // namespace SimTK
\ No newline at end of file
+//------------------------------------------------------------------------------
+//                            SOLVE BY BLOCKS
+//------------------------------------------------------------------------------
+// Helpers for dividing a problem up among the diagonal blocks of A. A map takes
+// a multiplier index in one numbering to the same multiplier in another, 
+// global-to-local or local-to-global for a particular block.
+typedef Array_<MultiplierIndex,MultiplierIndex> MultiplierMap;
+
+static void remap(const MultiplierMap& map, Array_<MultiplierIndex>& mults) 
+{   for (unsigned i=0; i < mults.size(); ++i) mults[i] = map[mults[i]]; }
+
+// Renumber the multipliers used by each kind of constraint runtime.
+static void remap(const MultiplierMap& map, ImpulseSolver::UncondRT& rt)
+{   remap(map, rt.m_mults); }
+static void remap(const MultiplierMap& map, ImpulseSolver::UniContactRT& rt)
+{   rt.m_Nk = map[rt.m_Nk]; remap(map, rt.m_Fk); }
+static void remap(const MultiplierMap& map, ImpulseSolver::UniSpeedRT& rt)
+{   rt.m_ix = map[rt.m_ix]; }
+static void remap(const MultiplierMap& map, ImpulseSolver::BoundedRT& rt)
+{   rt.m_ix = map[rt.m_ix]; }
+static void remap(const MultiplierMap& map, 
+                  ImpulseSolver::ConstraintLtdFrictionRT& rt)
+{   remap(map, rt.m_Fk); remap(map, rt.m_Nk); }
+static void remap(const MultiplierMap& map, 
+                  ImpulseSolver::StateLtdFrictionRT& rt)
+{   remap(map, rt.m_Fk); }
+
+// All the multipliers of a runtime are in the same block, so any one of them
+// tells us which block that is.
+static MultiplierIndex anyMult(const ImpulseSolver::UncondRT& rt)
+{   return rt.m_mults[0]; }
+static MultiplierIndex anyMult(const ImpulseSolver::UniContactRT& rt)
+{   return rt.m_Nk; }
+static MultiplierIndex anyMult(const ImpulseSolver::UniSpeedRT& rt)
+{   return rt.m_ix; }
+static MultiplierIndex anyMult(const ImpulseSolver::BoundedRT& rt)
+{   return rt.m_ix; }
+static MultiplierIndex anyMult(const ImpulseSolver::ConstraintLtdFrictionRT& rt)
+{   return rt.m_Fk[0]; }
+static MultiplierIndex anyMult(const ImpulseSolver::StateLtdFrictionRT& rt)
+{   return rt.m_Fk[0]; }
+
+// Collect the indices of the runtimes belonging to each block.
+template <class RT> static void
+sortIntoBlocks(const Array_<RT>& all, const Array_<int,MultiplierIndex>& blockOf,
+               Array_< Array_<int> >& inBlock) {
+    for (unsigned k=0; k < all.size(); ++k)
+        inBlock[blockOf[anyMult(all[k])]].push_back(k);
+}
+
+// Make local copies of one block's runtimes, renumbered for the block.
+template <class RT> static void
+gatherBlock(const Array_<RT>& all, const Array_<int>& which, 
+            const MultiplierMap& toLocal, Array_<RT>& local) {
+    local.clear();
+    for (unsigned i=0; i < which.size(); ++i) {
+        local.push_back(all[which[i]]);
+        remap(toLocal, local.back());
+    }
+}
+
+// Copy back the solver's results for one block, restoring global numbering.
+template <class RT> static void
+scatterBlock(const Array_<RT>& local, const Array_<int>& which,
+             const MultiplierMap& toGlobal, Array_<RT>& all) {
+    for (unsigned i=0; i < which.size(); ++i) {
+        RT& rt = all[which[i]];
+        rt = local[i];
+        remap(toGlobal, rt);
+    }
+}
+
+// Everything one block's solve() reads or writes, so that different blocks
+// can be solved at the same time.
+namespace {
+struct BlockProblem {
+    Array_<MultiplierIndex>                         participating, expanding;
+    Vector                                          D, piExpand, verrStart, 
+                                                    verrApplied, pi, piGuess;
+    Array_<ImpulseSolver::UncondRT>                 unconditional;
+    Array_<ImpulseSolver::UniContactRT>             uniContact;
+    Array_<ImpulseSolver::UniSpeedRT>               uniSpeed;
+    Array_<ImpulseSolver::BoundedRT>                bounded;
+    Array_<ImpulseSolver::ConstraintLtdFrictionRT>  consLtdFriction;
+    Array_<ImpulseSolver::StateLtdFrictionRT>       stateLtdFriction;
+    bool                                            converged;
+};
+}
+
+// Worker 0 is the solver itself; each other thread gets a clone. Clones are
+// made only once, so they keep their working memory from step to step.
+class ImpulseSolver::BlockWorkers {
+public:
+    BlockWorkers(const ImpulseSolver& solver, int nThreads) {
+        solvers.push_back(&solver);
+        for (int w=1; w < nThreads; ++w) {
+            ImpulseSolver* copy = solver.clone();
+            if (!copy) break; // can't solve in parallel
+            copy->clearStats();
+            clones.push_back(copy);
+            solvers.push_back(copy);
+        }
+        loop.setNumberOfThreads((int)solvers.size());
+    }
+    ~BlockWorkers() {
+        for (unsigned w=0; w < clones.size(); ++w)
+            delete clones[w];
+    }
+
+    // Move the clones' stats into the main solver so that they are reported
+    // as though the main solver had solved all the blocks.
+    void collectStats(const ImpulseSolver& solver) const {
+        for (unsigned w=0; w < clones.size(); ++w) {
+            const ImpulseSolver& c = *clones[w];
+            for (int p=0; p < MaxNumPhases; ++p) {
+                solver.m_nSolves[p] += c.m_nSolves[p];
+                solver.m_nIters[p]  += c.m_nIters[p];
+                solver.m_nFail[p]   += c.m_nFail[p];
+            }
+            solver.m_nBilateralSolves += c.m_nBilateralSolves;
+            solver.m_nBilateralIters  += c.m_nBilateralIters;
+            solver.m_nBilateralFail   += c.m_nBilateralFail;
+            c.clearStats();
+        }
+    }
+
+    ParallelLoop                    loop;
+    Array_<const ImpulseSolver*>    solvers;    // indexed by worker
+    Array_<ImpulseSolver*>          clones;     // owned
+};
+
+ImpulseSolver::~ImpulseSolver() {}
+
+ImpulseSolver::BlockWorkers& ImpulseSolver::updBlockWorkers() const {
+    if (!m_workers)
+        m_workers.reset(new BlockWorkers(*this, m_numThreads));
+    return *m_workers;
+}
+
+// Find each multiplier's block and its local index there.
+static void mapMultipliersToBlocks
+   (const ImpulseSolver::BlockDiagonalMatrix& A,
+    Array_<int,MultiplierIndex>& blockOf, MultiplierMap& toLocal) {
+    const int m = A.size();
+    blockOf.resize(m); toLocal.resize(m);
+    for (unsigned b=0; b < A.m_mults.size(); ++b) {
+        const Array_<MultiplierIndex>& mults = A.m_mults[b];
+        for (unsigned i=0; i < mults.size(); ++i) {
+            blockOf[mults[i]] = (int)b;
+            toLocal[mults[i]] = MultiplierIndex(i);
+        }
+    }
+}
+
+bool ImpulseSolver::
+solveByBlocks
+   (int                                 phase,
+    const Array_<MultiplierIndex>&      participating, 
+    const BlockDiagonalMatrix&          A,
+    const Vector&                       D,
+    const Array_<MultiplierIndex>&      expanding,
+    Vector&                             piExpand,
+    Vector&                             verrStart,
+    Vector&                             verrApplied,
+    Vector&                             pi,
+    Array_<UncondRT>&                   unconditional,
+    Array_<UniContactRT>&               uniContact,
+    Array_<UniSpeedRT>&                 uniSpeed,
+    Array_<BoundedRT>&                  bounded,
+    Array_<ConstraintLtdFrictionRT>&    consLtdFriction,
+    Array_<StateLtdFrictionRT>&         stateLtdFriction) const
+{
+    const int m = A.size();
+    const int nBlocks = (int)A.m_blocks.size();
+    assert((int)A.m_mults.size() == nBlocks);
+    assert(D.size()==m && verrStart.size()==m && piExpand.size()==m);
+    assert(verrApplied.size()==0 || verrApplied.size()==m);
+    const bool hasAppliedImpulse = (verrApplied.size() > 0);
+
+    Vector piGuess;
+    const bool hasGuess = takeInitialGuess(m, piGuess);
+
+    pi.resize(m);
+    pi.setToZero();
+
+    Array_<int,MultiplierIndex> blockOf;
+    MultiplierMap toLocal;
+    mapMultipliersToBlocks(A, blockOf, toLocal);
+
+    // Divide up the participating and expanding lists and the runtimes.
+    Array_<BlockProblem> prob(nBlocks);
+    for (unsigned i=0; i < participating.size(); ++i) {
+        const MultiplierIndex mx = participating[i];
+        prob[blockOf[mx]].participating.push_back(toLocal[mx]);
+    }
+    for (unsigned i=0; i < expanding.size(); ++i) {
+        const MultiplierIndex mx = expanding[i];
+        prob[blockOf[mx]].expanding.push_back(toLocal[mx]);
+    }
+    Array_< Array_<int> > uncondIn(nBlocks), uniContIn(nBlocks), 
+                          uniSpeedIn(nBlocks), boundedIn(nBlocks),
+                          consLtdIn(nBlocks), stateLtdIn(nBlocks);
+    sortIntoBlocks(unconditional,    blockOf, uncondIn);
+    sortIntoBlocks(uniContact,       blockOf, uniContIn);
+    sortIntoBlocks(uniSpeed,         blockOf, uniSpeedIn);
+    sortIntoBlocks(bounded,          blockOf, boundedIn);
+    sortIntoBlocks(consLtdFriction,  blockOf, consLtdIn);
+    sortIntoBlocks(stateLtdFriction, blockOf, stateLtdIn);
+
+    for (int b=0; b < nBlocks; ++b) {
+        const Array_<MultiplierIndex>& mults = A.m_mults[b];
+        const int mb = (int)mults.size();
+        BlockProblem& p = prob[b];
+        p.D.resize(mb); p.piExpand.resize(mb); p.verrStart.resize(mb);
+        p.verrApplied.resize(hasAppliedImpulse ? mb : 0);
+        for (int i=0; i < mb; ++i) {
+            const MultiplierIndex mx = mults[i];
+            p.D[i] = D[mx]; p.piExpand[i] = piExpand[mx]; 
+            p.verrStart[i] = verrStart[mx];
+            if (hasAppliedImpulse) p.verrApplied[i] = verrApplied[mx];
+        }
+        if (hasGuess) {
+            p.piGuess.resize(mb);
+            for (int i=0; i < mb; ++i) p.piGuess[i] = piGuess[mults[i]];
+        }
+
+        gatherBlock(unconditional,    uncondIn[b],   toLocal, p.unconditional);
+        gatherBlock(uniContact,       uniContIn[b],  toLocal, p.uniContact);
+        gatherBlock(uniSpeed,         uniSpeedIn[b], toLocal, p.uniSpeed);
+        gatherBlock(bounded,          boundedIn[b],  toLocal, p.bounded);
+        gatherBlock(consLtdFriction,  consLtdIn[b],  toLocal, 
+                    p.consLtdFriction);
+        gatherBlock(stateLtdFriction, stateLtdIn[b], toLocal, 
+                    p.stateLtdFriction);
+    }
+
+    // The blocks are independent so can be solved in any order.
+    const BlockWorkers& workers = updBlockWorkers();
+    workers.loop.forEachIndexOnWorker(nBlocks, [&](int b, int w) {
+        const ImpulseSolver& solver = *workers.solvers[w];
+        BlockProblem& p = prob[b];
+        solver.m_piGuess = p.piGuess; // empty if none
+        p.converged = solver.solve(phase, p.participating, A.m_blocks[b], 
+            p.D, p.expanding, p.piExpand, p.verrStart, p.verrApplied, p.pi,
+            p.unconditional, p.uniContact, p.uniSpeed, p.bounded, 
+            p.consLtdFriction, p.stateLtdFriction);
+    });
+    workers.collectStats(*this);
+
+    bool converged = true;
+    for (int b=0; b < nBlocks; ++b) {
+        const Array_<MultiplierIndex>& mults = A.m_mults[b];
+        const BlockProblem& p = prob[b];
+        if (!p.converged) converged = false;
+        for (unsigned i=0; i < mults.size(); ++i) {
+            const MultiplierIndex mx = mults[i];
+            pi[mx] = p.pi[i]; piExpand[mx] = p.piExpand[i];
+            verrStart[mx] = p.verrStart[i];
+            if (hasAppliedImpulse) verrApplied[mx] = p.verrApplied[i];
+        }
+        const MultiplierMap toGlobal(mults.begin(), mults.end());
+        scatterBlock(p.unconditional, uncondIn[b],   toGlobal, unconditional);
+        scatterBlock(p.uniContact,    uniContIn[b],  toGlobal, uniContact);
+        scatterBlock(p.uniSpeed,      uniSpeedIn[b], toGlobal, uniSpeed);
+        scatterBlock(p.bounded,       boundedIn[b],  toGlobal, bounded);
+        scatterBlock(p.consLtdFriction,  consLtdIn[b],  toGlobal, 
+                     consLtdFriction);
+        scatterBlock(p.stateLtdFriction, stateLtdIn[b], toGlobal, 
+                     stateLtdFriction);
+    }
+
+    return converged;
+}
+
+//------------------------------------------------------------------------------
+//                        SOLVE BILATERAL BY BLOCKS
+//------------------------------------------------------------------------------
+bool ImpulseSolver::
+solveBilateralByBlocks
+   (const Array_<MultiplierIndex>&  participating,
+    const BlockDiagonalMatrix&      A,
+    const Vector&                   D,
+    const Vector&                   rhs,
+    Vector&                         pi) const
+{
+    const int m = A.size();
+    const int nBlocks = (int)A.m_blocks.size();
+    assert(D.size()==m && rhs.size()==m);
+
+    pi.resize(m);
+    pi.setToZero();
+
+    Array_<int,MultiplierIndex> blockOf;
+    MultiplierMap toLocal;
+    mapMultipliersToBlocks(A, blockOf, toLocal);
+
+    // Only blocks with participating multipliers need solving; pi is zero
+    // in the rest.
+    Array_<BlockProblem> prob(nBlocks);
+    Array_<int> toSolve;
+    for (unsigned i=0; i < participating.size(); ++i) {
+        const MultiplierIndex mx = participating[i];
+        prob[blockOf[mx]].participating.push_back(toLocal[mx]);
+    }
+    for (int b=0; b < nBlocks; ++b) {
+        if (prob[b].participating.empty())
+            continue;
+        toSolve.push_back(b);
+        const Array_<MultiplierIndex>& mults = A.m_mults[b];
+        const int mb = (int)mults.size();
+        BlockProblem& p = prob[b];
+        p.D.resize(mb); p.verrStart.resize(mb); // verrStart is rhs here
+        for (int i=0; i < mb; ++i) {
+            p.D[i] = D[mults[i]]; p.verrStart[i] = rhs[mults[i]];
+        }
+    }
+
+    const BlockWorkers& workers = updBlockWorkers();
+    workers.loop.forEachIndexOnWorker((int)toSolve.size(), [&](int k, int w) {
+        const int b = toSolve[k];
+        BlockProblem& p = prob[b];
+        p.converged = workers.solvers[w]->solveBilateral
+           (p.participating, A.m_blocks[b], p.D, p.verrStart, p.pi);
+    });
+    workers.collectStats(*this);
+
+    bool converged = true;
+    for (unsigned k=0; k < toSolve.size(); ++k) {
+        const int b = toSolve[k];
+        const Array_<MultiplierIndex>& mults = A.m_mults[b];
+        if (!prob[b].converged) converged = false;
+        for (unsigned i=0; i < mults.size(); ++i)
+            pi[mults[i]] = prob[b].pi[i];
+    }
+
+    return converged;
+}
+
+} // namespace SimTK
@@ -444,6 +444,28 @@ public:
         mech.getRep().multiplyByNInv(s,true,fu,fq);
     }  
 
+    // Only the Matter subsystem has u's, so its mass matrix is the System's.
+    bool multiplyByMImpl(const State& s, const Vector& a, 
+                         Vector& Ma) const override {
+        getMatterSubsystem().multiplyByM(s,a,Ma);
+        return true;
+    }
+    bool multiplyByMPlusDInvImpl(const State& s, const Vector& d,
+                                 const Vector& f, Vector& x) const override {
+        const SimbodyMatterSubsystemRep& rep = getMatterSubsystem().getRep();
+        const int nu = rep.getNU(s);
+        SimTK_ERRCHK3_ALWAYS(d.size() == nu && f.size() == nu,
+            "MultibodySystem::multiplyByMPlusDInv()",
+            "Arguments 'd' and 'f' had lengths %d and %d but should both have"
+            " the length of u, %d.", d.size(), f.size(), nu);
+        // The implementation needs contiguous Vectors.
+        const Vector dc(d), fc(f);
+        Vector xc(nu, Real(0));
+        rep.multiplyByMPlusDInv(s,dc,fc,xc);
+        x = xc;
+        return true;
+    }
+
     // Currently prescribe() and project() affect only the Matter subsystem.
     bool prescribeQImpl(State& state) const override {
         const SimbodyMatterSubsystem& mech = getMatterSubsystem();
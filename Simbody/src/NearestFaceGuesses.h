@@ -0,0 +1,125 @@
+#ifndef SimTK_SIMBODY_NEAREST_FACE_GUESSES_H_
+#define SimTK_SIMBODY_NEAREST_FACE_GUESSES_H_
+
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simmath/internal/ContactGeometry.h"
+#include "simmath/internal/Contact.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace SimTK {
+
+//==============================================================================
+//                          NEAREST FACE GUESSES
+//==============================================================================
+/* This is a private utility for the elastic foundation models. Each spring 
+(face centroid) of a mesh in contact with another mesh needs the nearest 
+point on the other mesh, and from one evaluation to the next that point 
+almost always stays on the same face. This class remembers, for each ordered 
+pair of contact surfaces, which face of the other mesh was nearest each face 
+of the first last time, and feeds those back as guesses to 
+ContactGeometry::TriangleMesh::findNearestPoints(), which then only searches 
+the parts of the other mesh closer than the guessed face.
+
+The owning force keeps one of these in a lazy Position-stage cache entry, so 
+each State has its own guesses. findNearestPoints() breaks ties canonically, 
+so the guesses affect only the cost of the queries and never their results; 
+that is why the entry never needs to be marked valid, and why copying starts 
+over with no guesses. Contact forces for one State may be computed on several 
+threads, so the lock is taken once per pair of surfaces, just to find that 
+pair's guesses; the guesses themselves are read and written without it. */
+class NearestFaceGuesses {
+public:
+    NearestFaceGuesses() {}
+    NearestFaceGuesses(const NearestFaceGuesses&) {}
+    NearestFaceGuesses& operator=(const NearestFaceGuesses&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        guesses.clear();
+        return *this;
+    }
+
+    // Find the nearest point on otherMesh to each of points_O, which are the
+    // spring locations of the given faces of mesh surface meshSurf (having 
+    // numMeshFaces faces), expressed in otherMesh's frame O.
+    void findNearestPoints(ContactSurfaceIndex                 meshSurf,
+                           ContactSurfaceIndex                 otherSurf,
+                           int                                 numMeshFaces,
+                           const ArrayViewConst_<int>&         meshFaces,
+                           const ContactGeometry::TriangleMesh& otherMesh,
+                           const ArrayViewConst_<Vec3>&        points_O,
+                           Array_<Vec3>&                       nearest_O,
+                           Array_<bool>&                       inside,
+                           Array_<UnitVec3>&                   normals_O) 
+    {
+        const std::shared_ptr<Guesses> saved = 
+            getGuesses(meshSurf, otherSurf, numMeshFaces);
+
+        Array_<int> faces(meshFaces.size());
+        for (unsigned i=0; i < meshFaces.size(); ++i)
+            faces[i] = saved->face[meshFaces[i]].load(std::memory_order_relaxed);
+
+        otherMesh.findNearestPoints(points_O, faces, nearest_O, inside,
+                                    normals_O);
+
+        for (unsigned i=0; i < meshFaces.size(); ++i)
+            saved->face[meshFaces[i]].store(faces[i], std::memory_order_relaxed);
+    }
+
+private:
+    // One guessed face of the other mesh per face of the first; -1 if none.
+    struct Guesses {
+        explicit Guesses(int n) : size(n), face(new std::atomic<int>[n]) {
+            for (int i=0; i < n; ++i)
+                face[i].store(-1, std::memory_order_relaxed);
+        }
+        const int                          size;
+        std::unique_ptr<std::atomic<int>[]> face;
+    };
+
+    // A caller still using a replaced set of guesses keeps it alive.
+    std::shared_ptr<Guesses> getGuesses(ContactSurfaceIndex meshSurf, 
+                                        ContactSurfaceIndex otherSurf, 
+                                        int numMeshFaces) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<Guesses>& saved = 
+            guesses[std::make_pair(meshSurf, otherSurf)];
+        if (!saved || saved->size != numMeshFaces)
+            saved.reset(new Guesses(numMeshFaces));
+        return saved;
+    }
+
+    std::mutex mutex;
+    std::map<std::pair<ContactSurfaceIndex,ContactSurfaceIndex>, 
+             std::shared_ptr<Guesses> > guesses;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMBODY_NEAREST_FACE_GUESSES_H_
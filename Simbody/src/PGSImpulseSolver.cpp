@@ -333,6 +333,16 @@ solve(int                                 phase,
     pi.resize(m);
     pi.setToZero(); // Use this for piUnknown
 
+    // If we were given a starting guess, use it for the participating 
+    // multipliers. Any guess converges, but a good one converges faster.
+    Vector piGuess;
+    if (takeInitialGuess(m, piGuess)) {
+        for (int i=0; i < p; ++i) {
+            const MultiplierIndex mx = participating[i];
+            if (!isNaN(piGuess[mx])) pi[mx] = piGuess[mx];
+        }
+    }
+
     // If there are applied forces, add them to the rhs.
     if (verrApplied.size()) 
         verrStart += verrApplied;
@@ -173,6 +173,13 @@ solve(int                                 phase,
     pi.resize(m);
     pi.setToZero(); // Use this for piUnknown
 
+    // A starting guess, if we were given one, is used only for the first
+    // sliding interval. A guessed normal impulse of exactly zero means the
+    // contact separated last time; we start with it released and afterwards
+    // make sure it didn't need to be active after all.
+    Vector piWarm;
+    bool useWarmStart = takeInitialGuess(m, piWarm);
+
     const bool hasAppliedImpulse = (verrApplied.size() > 0);
 
 
@@ -273,6 +280,32 @@ solve(int                                 phase,
         // Sets all non-Observer uni contacts to active or known.
         classifyFrictionals(uniContact); // no Impendings at interval start
 
+        // Start from the guess if we have one, with the separated contacts
+        // and their friction removed from the active set.
+        Array_<int> warmReleased; // uni contacts released because of the guess
+        if (useWarmStart) {
+            for (MultiplierIndex mx(0); mx < m; ++mx)
+                piGuess[mx] = isNaN(piWarm[mx]) ? Real(0) : piWarm[mx];
+            Array_<bool,MultiplierIndex> isReleased(m, false);
+            for (int k=0; k < mUniCont; ++k) {
+                UniContactRT& rt = uniContact[k];
+                if (rt.m_type != Participating || piWarm[rt.m_Nk] != 0)
+                    continue;
+                rt.m_contactCond = UniOff;
+                isReleased[rt.m_Nk] = true;
+                for (unsigned i=0; i < rt.m_Fk.size(); ++i)
+                    isReleased[rt.m_Fk[i]] = true;
+                warmReleased.push_back(k);
+            }
+            if (!warmReleased.empty()) {
+                Array_<MultiplierIndex,ActiveIndex> stillActive;
+                for (ActiveIndex ax(0); ax < (int)m_active.size(); ++ax)
+                    if (!isReleased[m_active[ax]])
+                        stillActive.push_back(m_active[ax]);
+                m_active = stillActive;
+            }
+        }
+
         int its = 1;
         for (; ; ++its) {
 
@@ -296,6 +329,12 @@ solve(int                                 phase,
             m_mult2active.resize(m);
             fillMult2Active(m_active, m_mult2active);
             initializeNewton(A, piGuess, verrApplied, uniContact);
+            // Use the guessed normal impulses rather than the small ones 
+            // chosen above.
+            if (useWarmStart && its == 1)
+                for (ActiveIndex ax(0); ax < (int)m_active.size(); ++ax)
+                    if (!isNaN(piWarm[m_active[ax]]))
+                        m_piActive[ax] = piWarm[m_active[ax]];
             updateDirectionsAndCalcCurrentError(A, uniContact, 
                                                 piELeft, verrApplied,
                                                 m_piActive,m_errActive);
@@ -393,6 +432,7 @@ solve(int                                 phase,
 
             SimTK_DEBUG2("<<<< NEWTON done in %d iters; norm=%g.\n",
                          newtIter,errNorm);
+            m_nIters[phase] += newtIter;
 
             // UNCONDITIONAL: these are always on.
             for (int fx=0; fx < mUncond; ++fx) {
@@ -562,6 +602,31 @@ solve(int                                 phase,
             }
         } 
 
+        // If the guess released some contacts, make sure none of them ended 
+        // up approaching. Otherwise forget the guess and redo this interval.
+        if (!warmReleased.empty()) {
+            bool guessWasOK = true;
+            for (unsigned i=0; i < warmReleased.size(); ++i) {
+                const UniContactRT& rt = uniContact[warmReleased[i]];
+                const MultiplierIndex Nk = rt.m_Nk;
+                Real vEnd = m_verrLeft[Nk] + m_verrExpand[Nk]
+                            - multRowTimesActiveCol(A,Nk,m_active,m_piActive);
+                if (hasAppliedImpulse) vEnd += verrApplied[Nk];
+                if (rt.m_sign*vEnd < -m_convergenceTol) {
+                    guessWasOK = false;
+                    break;
+                }
+            }
+            if (!guessWasOK) {
+                SimTK_DEBUG("Guess released an approaching contact; "
+                            "restarting interval.\n");
+                useWarmStart = false;
+                --interval;
+                continue;
+            }
+        }
+        useWarmStart = false; // only for the first interval
+
         // Need to check what fraction s of this interval we can accept. We are
         // only limited by frictional contacts that are currently Sliding;
         // Rolling and Impending-slip contacts don't restrict the interval.
@@ -0,0 +1,128 @@
+#ifndef SimTK_SIMBODY_PARALLEL_LOOP_H_
+#define SimTK_SIMBODY_PARALLEL_LOOP_H_
+
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace SimTK {
+
+//==============================================================================
+//                              PARALLEL LOOP
+//==============================================================================
+/* This is a private utility for subsystems that have a loop over independent
+items (contacts, surface pairs) that they want to be able to run on several
+threads. It owns an optional ParallelExecutor and is meant to be a data member
+of a subsystem's implementation class. Copying it copies only the thread
+count; the copy creates its own executor when first used.
+
+Items are handed out one at a time from a shared counter since their costs
+can differ wildly (a sphere pair vs. a mesh pair). The loop body must write
+only to storage belonging to its own item so that the results are the same
+regardless of which thread did the work; callers then combine the per-item
+results serially in item order to get bitwise-reproducible answers.
+
+ParallelExecutor is not reentrant, so a loop that finds the executor busy
+(for example because another thread is realizing a different State of the
+same System) just runs serially. */
+class ParallelLoop {
+public:
+    ParallelLoop() : numThreads(1) {}
+
+    void setNumberOfThreads(int nThreads) {
+        assert(nThreads > 0);
+        std::lock_guard<std::mutex> guard(executorLock);
+        numThreads = nThreads;
+        executor.reset();
+    }
+    int getNumberOfThreads() const {return numThreads;}
+
+    // Call op(i) for every i in [0,n). If any calls throw, all the others are
+    // still made and then the exception from the lowest-numbered item is
+    // rethrown here.
+    template <class Op>
+    void forEachIndex(int n, const Op& op) const {
+        forEachIndexOnWorker(n, [&op](int i, int) {op(i);});
+    }
+
+    // Same, but call op(i,w) where w in [0,getNumberOfThreads()) identifies
+    // the worker making the call. Calls with the same w are never made at the
+    // same time, so the loop body can use scratch storage belonging to w.
+    template <class Op>
+    void forEachIndexOnWorker(int n, const Op& op) const {
+        if (numThreads < 2 || n < 2 || !executorLock.try_lock()) {
+            for (int i=0; i < n; ++i)
+                op(i, 0);
+            return;
+        }
+        std::lock_guard<std::mutex> guard(executorLock, std::adopt_lock);
+        if (!executor)
+            executor.reset(new ParallelExecutor(numThreads));
+        LoopTask<Op> task(n, op);
+        executor->execute(task, std::min(numThreads, n));
+        task.rethrowAnyError();
+    }
+
+private:
+    template <class Op>
+    class LoopTask : public ParallelExecutor::Task {
+    public:
+        LoopTask(int n, const Op& op) : n(n), op(op), next(0), errors(n) {}
+
+        void execute(int worker) override {
+            int i;
+            while ((i = next++) < n) {
+                try {
+                    op(i, worker);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        }
+
+        void rethrowAnyError() const {
+            for (int i=0; i < n; ++i)
+                if (errors[i]) std::rethrow_exception(errors[i]);
+        }
+    private:
+        const int                   n;
+        const Op&                   op;
+        std::atomic<int>            next;
+        Array_<std::exception_ptr>  errors;
+    };
+
+    int                                                     numThreads;
+    mutable ResetOnCopy<std::unique_ptr<ParallelExecutor>>  executor;
+    mutable ResetOnCopy<std::mutex>                         executorLock;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMBODY_PARALLEL_LOOP_H_
@@ -478,9 +478,13 @@ virtual void realizeDynamics(
 virtual void realizeReport(
     const SBStateDigest&         sbs) const=0;
 
+// If addToD is not null, its entries (one per u) are added to the diagonal
+// of each mobilizer's hinge inertia D. The articulated body inertias are then
+// those of the system with mass matrix M + diag(addToD).
 virtual void realizeArticulatedBodyInertiasInward(
     const SBInstanceCache&          ic,
     const SBTreePositionCache&      pc,
+    const Real*                     addToD,
     SBArticulatedBodyInertiaCache&  abc) const=0;
 
 virtual void realizeYOutward(
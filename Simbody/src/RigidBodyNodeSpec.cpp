@@ -35,6 +35,59 @@ instantiations of the class for all possible values of the arguments. */
 #include "RigidBodyNodeSpec_Free.h"
 #include "RigidBodyNodeSpec_Custom.h"
 
+//==============================================================================
+//                              INVERT SYMMETRIC
+//==============================================================================
+// Invert a small symmetric positive definite matrix such as the articulated
+// body hinge inertia D = ~H*P*H, using only its lower triangle. Mat::invert()
+// has closed forms only up to 3x3 and sends larger matrices to Lapack through
+// heap-allocated temporaries, which dominated the articulated body inertia
+// calculation for 4-6 dof mobilizers like Free. Here the sizes are known at
+// compile time so the loops unroll into straight-line code on the stack.
+// We use the Cholesky factorization D = L*~L, invert L in place, then form
+// DI = ~(L^-1)*L^-1. Returns false without touching DI if D is not
+// numerically positive definite, in which case the caller should fall back
+// to the general inverse so that the usual exception is thrown.
+// Cost: ~(2/3)N^3 flops + N square roots.
+template <int N> static bool
+invertSymmetricPositiveDefinite(const Mat<N,N>& D, Mat<N,N>& DI) {
+    Mat<N,N> L; // only the lower triangle is used
+    Real ooDiag[N];
+    for (int j=0; j < N; ++j) {
+        Real d = D(j,j);
+        for (int k=0; k < j; ++k) d -= square(L(j,k));
+        if (!(d > 0)) return false;
+        L(j,j) = std::sqrt(d);
+        ooDiag[j] = 1/L(j,j);
+        for (int i=j+1; i < N; ++i) {
+            Real s = D(i,j);
+            for (int k=0; k < j; ++k) s -= L(i,k)*L(j,k);
+            L(i,j) = s*ooDiag[j];
+        }
+    }
+
+    // W = L^-1 is also lower triangular; forward substitute one column at
+    // a time.
+    Mat<N,N> W;
+    for (int j=0; j < N; ++j) {
+        W(j,j) = ooDiag[j];
+        for (int i=j+1; i < N; ++i) {
+            Real s = 0;
+            for (int k=j; k < i; ++k) s += L(i,k)*W(k,j);
+            W(i,j) = -s*ooDiag[i];
+        }
+    }
+
+    // DI = ~W*W; the result is exactly symmetric.
+    for (int i=0; i < N; ++i)
+        for (int j=0; j <= i; ++j) {
+            Real s = 0;
+            for (int k=i; k < N; ++k) s += W(k,i)*W(k,j);
+            DI(i,j) = DI(j,i) = s;
+        }
+    return true;
+}
+
 //==============================================================================
 //                              CALC H_PB_G
 //==============================================================================
@@ -251,6 +304,7 @@ RigidBodyNodeSpec<dof, noR_FM, noX_MB, noR_PF>::
 realizeArticulatedBodyInertiasInward(
     const SBInstanceCache&          ic,
     const SBTreePositionCache&      pc,
+    const Real*                     addToD,
     SBArticulatedBodyInertiaCache&  abc) const 
 {
     ArticulatedInertia& P = updP(abc);
@@ -300,9 +354,15 @@ realizeArticulatedBodyInertiasInward(
 
     const HType PH = P*H;   // 66*dof   flops
     D  = ~H * PH;           // 11*dof^2 flops (symmetric result)
-
-    // this will throw an exception if the matrix is ill conditioned
-    DI = D.invert();                        // ~dof^3 flops (symmetric)
+    if (addToD)
+        for (int i=0; i < dof; ++i)
+            D(i,i) += addToD[uIndex+i];
+
+    // Small sizes have closed-form inverses already. For larger ones D is
+    // positive definite unless the mobilizer is singular here; in that case
+    // invert() will throw an exception if the matrix is ill conditioned.
+    if (dof <= 3 || !invertSymmetricPositiveDefinite(D, DI))
+        DI = D.invert();                    // ~dof^3 flops (symmetric)
     G  = PH * DI;                           // 12*dof^2-6*dof flops
 
     // Want P+ = P - G*~PH. We can do this in about 55*dof flops.
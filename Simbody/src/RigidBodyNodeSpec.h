@@ -351,6 +351,7 @@ void realizeReport(const SBStateDigest& sbs) const override
 void realizeArticulatedBodyInertiasInward(
     const SBInstanceCache&          ic,
     const SBTreePositionCache&      pc,
+    const Real*                     addToD,
     SBArticulatedBodyInertiaCache&  abc) const override;
 
 // This dynamics-stage calculation is needed for handling constraints. It
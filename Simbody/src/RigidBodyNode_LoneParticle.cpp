@@ -191,14 +191,22 @@ void realizeDynamics(const SBStateDigest&) const override {
 void realizeReport(const SBStateDigest&) const override {
 }
 
+// We don't use G, D or DI but keep the diagonal of D (just the mass unless 
+// something was added to it) in D's slot for multiplyByMInvPass2Outward().
 void realizeArticulatedBodyInertiasInward(
         const SBInstanceCache&          ic,
         const SBTreePositionCache&      pc,
+        const Real*                     addToD,
         SBArticulatedBodyInertiaCache&  abc) const override {
     ArticulatedInertia& P     = updP(abc);
     ArticulatedInertia& PPlus = updPPlus(abc);
 
     PPlus = P = ArticulatedInertia(getMk_G(pc));
+
+    Vec3& diagD = Vec3::updAs(&abc.storageForD[uSqIndex]);
+    diagD = getMass();
+    if (addToD)
+        diagD += Vec3::getAs(&addToD[uIndex]);
 }
 
 void realizeYOutward(
@@ -353,7 +361,8 @@ void multiplyByMInvPass2Outward(
         udot = 0;
         A_GB = SpatialVec(Vec3(0), Vec3(0));
     } else {
-        udot = eps/getMass();
+        const Vec3& diagD = Vec3::getAs(&abc.storageForD[uSqIndex]);
+        udot = Vec3(eps[0]/diagD[0], eps[1]/diagD[1], eps[2]/diagD[2]);
         A_GB = SpatialVec(Vec3(0), udot);
     }
 }
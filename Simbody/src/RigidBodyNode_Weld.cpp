@@ -175,6 +175,7 @@ public:
     void realizeArticulatedBodyInertiasInward(
         const SBInstanceCache&,
         const SBTreePositionCache&,
+        const Real*,
         SBArticulatedBodyInertiaCache& abc) const override 
     {   ArticulatedInertia& P = updP(abc);
         P = ArticulatedInertia(SymMat33(Infinity), Mat33(Infinity), 
@@ -441,6 +442,7 @@ public:
     void realizeArticulatedBodyInertiasInward
        (const SBInstanceCache&          ic,
         const SBTreePositionCache&      pc, 
+        const Real*                     addToD,
         SBArticulatedBodyInertiaCache&  abc) const override 
     {
         ArticulatedInertia& P = updP(abc);
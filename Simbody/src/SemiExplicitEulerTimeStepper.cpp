@@ -28,6 +28,7 @@
 
 #include "SimbodyMatterSubsystemRep.h"
 
+#include <algorithm>
 #include <iostream>
 using std::cout; using std::endl;
 
@@ -40,6 +41,7 @@ namespace {
     const Real  DefConstraintTol       = DefAccuracy/10;
     const Real  DefMinSignificantForce = SignificantReal;
     const int   DefMaxInducedImpactsPerStep = 5;
+    const Real  DefSleepTime           = 0.5;
     const SemiExplicitEulerTimeStepper::RestitutionModel   
         DefRestitutionModel    = SemiExplicitEulerTimeStepper::Poisson;
     const SemiExplicitEulerTimeStepper::InducedImpactModel 
@@ -64,6 +66,12 @@ SemiExplicitEulerTimeStepper(const MultibodySystem& mbs)
     m_maxInducedImpactsPerStep(DefMaxInducedImpactsPerStep),
     m_projectionMethod(DefPosProjMethod),
     m_solverType(DefImpulseSolverType), 
+    m_useWarmStart(false),
+    m_useBlockCompliance(false),
+    m_numThreads(1),
+    m_useSleeping(false),
+    m_sleepVelocity(0),             // means: use 2 x constraintTol
+    m_sleepTime(DefSleepTime),
     m_defaultCaptureVelocity(0),    // means: use 2 x constraintTol
     m_defaultMinCORVelocity(0),     // means: use capture velocity
     m_defaultTransitionVelocity(0), // means: use 2 x constraintTol
@@ -91,6 +99,17 @@ stepTo(Real time) {
     findProximalConstraints(s);
     // Enable all proximal constraints, reassigning multipliers if needed.
     enableProximalConstraints(s);
+    if (m_useSleeping) {
+        // Contacts of sleeping islands were left disabled. If an awake body
+        // has reached a sleeping island, wake it and try again.
+        findIslands(s);
+        while (wakeTouchedIslands()) {
+            mbs.realize(s, Stage::Position);
+            findProximalConstraints(s);
+            enableProximalConstraints(s);
+            findIslands(s);
+        }
+    }
     collectConstraintInfo(s);
 
     mbs.realize(s, Stage::Velocity);
@@ -104,6 +123,7 @@ stepTo(Real time) {
     const int m = verr0.size();
 
     if (m==0) {
+        m_prevUniContactForce.clear(); // no contacts were proximal
         takeUnconstrainedStep(s, h);
         return Integrator::ReachedScheduledEvent;
     }
@@ -114,8 +134,16 @@ stepTo(Real time) {
     // separate and no time is going by during an impact.
     calcCoefficientsOfFriction(s, verr0);
 
-    // Calculate the constraint compliance matrix A=GM\~G.
-    matter.calcProjectedMInv(s, m_GMInvGt); // m X m
+    // Calculate the constraint compliance matrix A=GM\~G, either as a whole
+    // or as just its independent diagonal blocks.
+    if (m_useBlockCompliance) {
+        m_GMInvGt.clear();
+        matter.calcProjectedMInvBlocks(s, m_GMInvGtBlocks.m_mults,
+                                          m_GMInvGtBlocks.m_blocks);
+    } else {
+        m_GMInvGtBlocks.clear();
+        matter.calcProjectedMInv(s, m_GMInvGt); // m X m
+    }
 
     // TODO: this is for soft constraints. D >= 0.
     m_D.resize(m); m_D.setToZero();
@@ -313,6 +341,8 @@ stepTo(Real time) {
     // needs to know the sliding velocity for proper friction classification and
     // that velocity is what's in verr0.
     Vector verrStart = verr0;
+    if (m_useWarmStart)
+        supplyWarmStartGuess(h, m);
     // Use lambda as a temp here; we are really calculating lambda*h.
     doCompressionPhase(s, verrStart, m_verr, lambda);
     #ifndef NDEBUG
@@ -324,6 +354,8 @@ stepTo(Real time) {
     // Convert multipliers from impulses to forces. These are the multipliers
     // reported at end of step.
     lambda /= h;
+    if (m_useWarmStart)
+        saveContactForcesForWarmStart(lambda);
 
     // Calculate constraint forces ~G*lambda (body frcs Fc, mobility frcs fc).
     Vector_<SpatialVec> Fc; Vector fc; 
@@ -335,12 +367,16 @@ stepTo(Real time) {
     matterRep.calcTreeForwardDynamicsOperator
        (s, f, Fp, F, &fc, &Fc, tac, udot, qdotdot, udotErr);
     m_deltaU = h*udot;
+    if (m_useSleeping)
+        zeroSleepingMobilities(s, m_deltaU);
 
     // Update auxiliary states z, invalidating Stage::Dynamics.
     s.updZ() += h*zdot;
 
     // Update u from deltaU, invalidating Stage::Velocity. 
     s.updU() += m_deltaU;
+    if (m_useSleeping)
+        putRestingIslandsToSleep(s, h);
 
     // Done with velocity update. Now calculate qdot, possibly including
     // an additional position error correction term.
@@ -373,6 +409,8 @@ stepTo(Real time) {
         matter.multiplyByGTranspose(s, m_impulse, m_genImpulse);
         // gen impulse to deltaU (watch sign)
         matter.multiplyByMInv(s, m_genImpulse, m_deltaU);
+        if (m_useSleeping)
+            zeroSleepingMobilities(s, m_deltaU);
 
         // convert corrected u to qdot (note we're not changing u)
         matter.multiplyByN(s,false,s.getU()-m_deltaU, qdot);
@@ -718,8 +756,19 @@ classifyUnilateralContactsForSimultaneousImpact
 //------------------------------------------------------------------------------
 void SemiExplicitEulerTimeStepper::initialize(const State& initState) {
     m_state = initState;
+    m_prevUniContactForce.clear(); // nothing to warm start from yet
     m_mbs.realize(m_state, Stage::Acceleration);
 
+    // Everything starts out awake.
+    const SimbodyMatterSubsystem& matter = m_mbs.getMatterSubsystem();
+    const int nb = matter.getNumBodies();
+    m_baseBodyOf.resize(nb);
+    for (MobilizedBodyIndex mbx(0); mbx < nb; ++mbx)
+        m_baseBodyOf[mbx] = mbx == GroundIndex ? GroundIndex
+            : matter.getMobilizedBody(mbx).getBaseMobilizedBody()
+                                          .getMobilizedBodyIndex();
+    wakeAllIslands();
+
     if (!m_solver) {
         const Real transVel = getDefaultFrictionTransitionVelocityInUse();
         m_solver = m_solverType==PLUS 
@@ -734,6 +783,7 @@ void SemiExplicitEulerTimeStepper::initialize(const State& initState) {
     // Make sure the impulse solve knows our tolerance for slip velocity
     // during rolling.
     m_solver->setMaxRollingSpeed(getDefaultFrictionTransitionVelocityInUse());
+    m_solver->setNumberOfThreads(m_numThreads);
 }
 
 //------------------------------------------------------------------------------
@@ -783,7 +833,9 @@ findProximalConstraints(const State& s) { //TODO: redo
 
     for (UnilateralContactIndex ux(0); ux < nUniContacts; ++ux) {
         const UnilateralContact& contact = matter.getUnilateralContact(ux);
-        if (contact.isProximal(s, m_consTol)) // may be scaled
+        if (ux < m_contactSleepGroup.size() && m_contactSleepGroup[ux] >= 0)
+            m_distalUniContacts.push_back(ux); // asleep; leave disabled
+        else if (contact.isProximal(s, m_consTol)) // may be scaled
             m_proximalUniContacts.push_back(ux);
         else m_distalUniContacts.push_back(ux);
     }
@@ -932,6 +984,189 @@ collectConstraintInfo(const State& s) { //TODO: redo
     // (all nonholonomic)
 }
 
+//------------------------------------------------------------------------------
+//                         SUPPLY WARM START GUESS
+//------------------------------------------------------------------------------
+// Contacts that weren't proximal at the end of the last step get NaN, meaning
+// no guess. The saved values are forces, so scale by the current step size to
+// get impulses.
+void SemiExplicitEulerTimeStepper::
+supplyWarmStartGuess(Real h, int m) {
+    Vector piGuess(m, NaN);
+    for (unsigned i=0; i < m_uniContact.size(); ++i) {
+        const ImpulseSolver::UniContactRT& rt = m_uniContact[i];
+        if (rt.m_ucx >= (int)m_prevUniContactForce.size())
+            continue;
+        const Vec3& f = m_prevUniContactForce[rt.m_ucx];
+        piGuess[rt.m_Nk] = h*f[0];
+        for (unsigned j=0; j < rt.m_Fk.size(); ++j)
+            piGuess[rt.m_Fk[j]] = h*f[1+j];
+    }
+    m_solver->setInitialGuess(piGuess);
+}
+
+//------------------------------------------------------------------------------
+//                   SAVE CONTACT FORCES FOR WARM START
+//------------------------------------------------------------------------------
+void SemiExplicitEulerTimeStepper::
+saveContactForcesForWarmStart(const Vector& lambda) {
+    const SimbodyMatterSubsystem& matter = m_mbs.getMatterSubsystem();
+    m_prevUniContactForce.assign(matter.getNumUnilateralContacts(), Vec3(NaN));
+    for (unsigned i=0; i < m_uniContact.size(); ++i) {
+        const ImpulseSolver::UniContactRT& rt = m_uniContact[i];
+        Vec3& f = m_prevUniContactForce[rt.m_ucx];
+        f[0] = lambda[rt.m_Nk];
+        for (unsigned j=0; j < rt.m_Fk.size(); ++j)
+            f[1+j] = lambda[rt.m_Fk[j]];
+    }
+}
+
+//------------------------------------------------------------------------------
+//                              FIND ISLANDS
+//------------------------------------------------------------------------------
+// Islands are the decoupled constraint groups that Simbody uses to form A in
+// blocks, together with their bodies. Sleeping islands have their contacts
+// disabled, so each of their base bodies appears as an island with no 
+// constraints (group -1) unless an enabled constraint reaches it.
+void SemiExplicitEulerTimeStepper::
+findIslands(const State& s) {
+    const SimbodyMatterSubsystemRep& matterRep = 
+        m_mbs.getMatterSubsystem().getRep();
+    matterRep.findDecoupledConstraintGroups(s, m_islandMults, &m_islandOfBody);
+}
+
+//------------------------------------------------------------------------------
+//                          WAKE TOUCHED ISLANDS
+//------------------------------------------------------------------------------
+// A sleeping base body that shares an island with an awake one has been 
+// reached by an enabled constraint from outside, presumably a new contact. 
+// Wake up its whole sleeping island, including its disabled contacts.
+bool SemiExplicitEulerTimeStepper::
+wakeTouchedIslands() {
+    const int nb = (int)m_baseBodyOf.size();
+    Array_<bool> hasAwake(m_islandMults.size(), false);
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const int g = m_islandOfBody[mbx];
+        if (g >= 0 && m_baseBodyOf[mbx]==mbx && m_sleepGroup[mbx] < 0)
+            hasAwake[g] = true;
+    }
+
+    Array_<int> toWake;
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const int g = m_islandOfBody[mbx];
+        if (g >= 0 && m_baseBodyOf[mbx]==mbx && m_sleepGroup[mbx] >= 0
+            && hasAwake[g])
+            toWake.push_back(m_sleepGroup[mbx]);
+    }
+    if (toWake.empty())
+        return false;
+
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        if (std::find(toWake.begin(), toWake.end(), m_sleepGroup[mbx])
+            != toWake.end()) 
+        {   m_sleepGroup[mbx] = -1; m_restTime[mbx] = 0; }
+    }
+    for (UnilateralContactIndex ux(0); ux < m_contactSleepGroup.size(); ++ux)
+        if (std::find(toWake.begin(), toWake.end(), m_contactSleepGroup[ux])
+            != toWake.end())
+            m_contactSleepGroup[ux] = -1;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//                      PUT RESTING ISLANDS TO SLEEP
+//------------------------------------------------------------------------------
+// Each awake base body accumulates resting time while all the u's in its 
+// subtree are small; an island falls asleep when all its base bodies have 
+// rested long enough. The island's proximal contacts are remembered so that
+// they can be held disabled while it sleeps.
+void SemiExplicitEulerTimeStepper::
+putRestingIslandsToSleep(State& s, Real h) {
+    const SimbodyMatterSubsystem& matter = m_mbs.getMatterSubsystem();
+    const int nb = (int)m_baseBodyOf.size();
+    const Real vSleep = getSleepVelocityInUse();
+    const Vector& u = s.getU();
+
+    Array_<Real,MobilizedBodyIndex> maxSpeed(nb, Real(0));
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+        const int nu = mobod.getNumU(s);
+        const UIndex ux0 = mobod.getFirstUIndex(s);
+        Real& speed = maxSpeed[m_baseBodyOf[mbx]];
+        for (int i=0; i < nu; ++i)
+            speed = std::max(speed, std::abs(u[ux0+i]));
+    }
+
+    // An island can sleep only if every one of its base bodies is ready. 
+    // Base bodies with no constraints (group -1) are islands by themselves.
+    const int nIslands = (int)m_islandMults.size();
+    Array_<bool> ready(nIslands, true);
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        if (m_baseBodyOf[mbx] != mbx || m_sleepGroup[mbx] >= 0) continue;
+        m_restTime[mbx] = maxSpeed[mbx] < vSleep ? m_restTime[mbx] + h : 0;
+        const int g = m_islandOfBody[mbx];
+        if (g >= 0 && m_restTime[mbx] < m_sleepTime) ready[g] = false;
+    }
+
+    Array_<int> sleepId(nIslands, -1);
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        if (m_baseBodyOf[mbx] != mbx || m_sleepGroup[mbx] >= 0) continue;
+        const int g = m_islandOfBody[mbx];
+        if (g < 0) {
+            if (m_restTime[mbx] >= m_sleepTime) m_sleepGroup[mbx] = mbx;
+        } else if (ready[g]) {
+            if (sleepId[g] < 0) sleepId[g] = mbx; // lowest base body
+            m_sleepGroup[mbx] = sleepId[g];
+        }
+    }
+
+    // Hold the contacts of newly sleeping islands disabled.
+    Array_<int,MultiplierIndex> islandOfMult(s.getNMultipliers(), -1);
+    for (int g=0; g < nIslands; ++g)
+        for (unsigned i=0; i < m_islandMults[g].size(); ++i)
+            islandOfMult[MultiplierIndex(m_islandMults[g][i])] = g;
+    for (unsigned i=0; i < m_uniContact.size(); ++i) {
+        const ImpulseSolver::UniContactRT& rt = m_uniContact[i];
+        const int g = islandOfMult[rt.m_Nk];
+        if (g >= 0 && sleepId[g] >= 0)
+            m_contactSleepGroup[rt.m_ucx] = sleepId[g];
+    }
+
+    // Stop the sleeping bodies where they are.
+    zeroSleepingMobilities(s, s.updU());
+}
+
+//------------------------------------------------------------------------------
+//                        ZERO SLEEPING MOBILITIES
+//------------------------------------------------------------------------------
+void SemiExplicitEulerTimeStepper::
+zeroSleepingMobilities(const State& s, Vector& uVec) const {
+    const SimbodyMatterSubsystem& matter = m_mbs.getMatterSubsystem();
+    const int nb = (int)m_baseBodyOf.size();
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        if (m_sleepGroup[m_baseBodyOf[mbx]] < 0) continue;
+        const MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+        uVec(mobod.getFirstUIndex(s), mobod.getNumU(s)) = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+//                     WAKE ALL ISLANDS / NUM SLEEPING
+//------------------------------------------------------------------------------
+void SemiExplicitEulerTimeStepper::wakeAllIslands() {
+    const SimbodyMatterSubsystem& matter = m_mbs.getMatterSubsystem();
+    m_restTime.assign(m_baseBodyOf.size(), 0);
+    m_sleepGroup.assign(m_baseBodyOf.size(), -1);
+    m_contactSleepGroup.assign(matter.getNumUnilateralContacts(), -1);
+}
+
+int SemiExplicitEulerTimeStepper::getNumSleepingBodies() const {
+    int n = 0;
+    for (MobilizedBodyIndex mbx(1); mbx < m_baseBodyOf.size(); ++mbx)
+        if (isBodySleeping(mbx)) ++n;
+    return n;
+}
+
 //------------------------------------------------------------------------------
 //                        TAKE UNCONSTRAINED STEP
 //------------------------------------------------------------------------------
@@ -942,10 +1177,14 @@ takeUnconstrainedStep(State& s, Real h) {
     const SBTopologyCache&           topo = matterRep.getMatterTopologyCache();
 
     m_mbs.realize(s, Stage::Acceleration);
-    const Vector& udot = s.getUDot(); // grab before invalidated
-    const Vector& zdot = s.getZDot();
+    Vector deltaU = h*s.getUDot();
+    const Vector& zdot = s.getZDot(); // grab before invalidated
+    if (m_useSleeping)
+        zeroSleepingMobilities(s, deltaU);
     s.updZ() += h*zdot;         // invalidates Stage::Dynamics
-    s.updU() += h*udot;         // invalidates Stage::Velocity
+    s.updU() += deltaU;         // invalidates Stage::Velocity
+    if (m_useSleeping)
+        putRestingIslandsToSleep(s, h);
     Vector qdot;
     matter.multiplyByN(s,false,s.getU(),qdot);
     s.updQ() += h*qdot;         // invalidates Stage::Position
@@ -1156,10 +1395,9 @@ doCompressionPhase(const State& s, Vector& verrStart, Vector& verrApplied,
     cout << "  verrStart=" << verrStart << endl;
     cout << "  verrApplied=" << verrApplied << endl;
 #endif
-    // TODO: improve initial guess
+    // The initial guess, if any, has already been given to the solver.
     m_expansionImpulse.setToZero(); //TODO: shouldn't need to zero this
-    bool converged = m_solver->solve(0,
-        m_allParticipating,m_GMInvGt,m_D,
+    bool converged = solveImpulses(0, m_allParticipating,
         Array_<MultiplierIndex>(), m_expansionImpulse, 
         verrStart, verrApplied, 
         compImpulse,
@@ -1184,8 +1422,7 @@ doExpansionPhase(const State&   state,
                  Vector&        verrStart, 
                  Vector&        reactionImpulse) {
     // TODO: improve initial guess
-    bool converged = m_solver->solve(1,
-        m_participating,m_GMInvGt,m_D,
+    bool converged = solveImpulses(1, m_participating,
         expanding,expansionImpulse, verrStart,m_emptyVector,
         reactionImpulse,
         m_unconditional,m_uniContact,m_uniSpeed,m_bounded,
@@ -1209,8 +1446,7 @@ doInducedImpactRound(const State& s,
 #ifndef NDEBUG
     printf("IMP t=%.15g verr=", s.getTime()); cout << verrStart << endl;
 #endif
-    bool converged = m_solver->solve(0,
-        m_participating,m_GMInvGt,m_D,
+    bool converged = solveImpulses(0, m_participating,
         expanding,expansionImpulse, verrStart,m_emptyVector,
         impulse,
         m_unconditional,m_uniContact,m_uniSpeed,m_bounded,
@@ -1219,6 +1455,50 @@ doInducedImpactRound(const State& s,
 }
 
 
+//------------------------------------------------------------------------------
+//                             SOLVE IMPULSES
+//------------------------------------------------------------------------------
+// Hand the problem to the ImpulseSolver in whichever form we calculated the
+// compliance matrix A for this step. D is always the full m-vector.
+bool SemiExplicitEulerTimeStepper::
+solveImpulses(int                                           phase,
+              const Array_<MultiplierIndex>&                participating,
+              const Array_<MultiplierIndex>&                expanding,
+              Vector&                                       piExpand,
+              Vector&                                       verrStart,
+              Vector&                                       verrApplied,
+              Vector&                                       pi,
+              Array_<ImpulseSolver::UncondRT>&              unconditional,
+              Array_<ImpulseSolver::UniContactRT>&          uniContact,
+              Array_<ImpulseSolver::UniSpeedRT>&            uniSpeed,
+              Array_<ImpulseSolver::BoundedRT>&             bounded,
+              Array_<ImpulseSolver::ConstraintLtdFrictionRT>& consLtdFriction,
+              Array_<ImpulseSolver::StateLtdFrictionRT>&    stateLtdFriction)
+              const
+{
+    if (m_useBlockCompliance)
+        return m_solver->solveByBlocks(phase, participating, m_GMInvGtBlocks,
+            m_D, expanding, piExpand, verrStart, verrApplied, pi,
+            unconditional, uniContact, uniSpeed, bounded, 
+            consLtdFriction, stateLtdFriction);
+
+    return m_solver->solve(phase, participating, m_GMInvGt, m_D, 
+        expanding, piExpand, verrStart, verrApplied, pi,
+        unconditional, uniContact, uniSpeed, bounded, 
+        consLtdFriction, stateLtdFriction);
+}
+
+bool SemiExplicitEulerTimeStepper::
+solveBilateralImpulses(const Array_<MultiplierIndex>&   participating,
+                       const Vector&                    rhs,
+                       Vector&                          pi) const
+{
+    if (m_useBlockCompliance)
+        return m_solver->solveBilateralByBlocks(participating, 
+                                                m_GMInvGtBlocks, m_D, rhs, pi);
+    return m_solver->solveBilateral(participating, m_GMInvGt, m_D, rhs, pi);
+}
+
 //------------------------------------------------------------------------------
 //                      DO POSITION CORRECTION PHASE
 //------------------------------------------------------------------------------
@@ -1233,8 +1513,7 @@ doPositionCorrectionPhase(const State& state, Vector& pverr,
         SimTK_DEBUG1("UNILATERAL POSITION CORRECTION, %d participators\n",
                      (int)m_posParticipating.size());
         m_expansionImpulse.setToZero(); //TODO: shouldn't need to zero this
-        converged = m_solver->solve(2,
-            m_posParticipating,m_GMInvGt,m_D,
+        converged = solveImpulses(2, m_posParticipating,
             Array_<MultiplierIndex>(), m_expansionImpulse,
             pverr, m_emptyVector,
             positionImpulse,
@@ -1255,8 +1534,8 @@ doPositionCorrectionPhase(const State& state, Vector& pverr,
         }
         SimTK_DEBUG1("BILATERAL POSITION CORRECTION, %d participators\n",
                     (int)m_participating.size());
-        converged = m_solver->solveBilateral(m_participating,m_GMInvGt,m_D,
-                                             pverr, positionImpulse);
+        converged = solveBilateralImpulses(m_participating, 
+                                           pverr, positionImpulse);
     }
     return converged;
 }
@@ -107,6 +107,68 @@ void SimbodyMatterSubsystem::setShowDefaultGeometry(bool show) {
     updRep().setShowDefaultGeometry(show);
 }
 
+void SimbodyMatterSubsystem::
+setNumberOfThreads(int numThreads, bool limitToProcessors) {
+    updRep().setNumberOfThreads(numThreads, limitToProcessors);
+}
+
+int SimbodyMatterSubsystem::getNumberOfThreads() const {
+    return getRep().getNumberOfThreads();
+}
+
+int SimbodyMatterSubsystem::getNumberOfThreadsInUse() const {
+    return getRep().getNumberOfThreadsInUse();
+}
+
+void SimbodyMatterSubsystem::setMinBodiesPerThread(int minBodies) {
+    updRep().setMinBodiesPerThread(minBodies);
+}
+
+int SimbodyMatterSubsystem::getMinBodiesPerThread() const {
+    return getRep().getMinBodiesPerThread();
+}
+
+void SimbodyMatterSubsystem::
+setUseIncrementalPositionKinematics(bool useIncremental) {
+    updRep().setUseIncrementalPositionKinematics(useIncremental);
+}
+
+bool SimbodyMatterSubsystem::getUseIncrementalPositionKinematics() const {
+    return getRep().getUseIncrementalPositionKinematics();
+}
+
+void SimbodyMatterSubsystem::setUseSparseConstraintSolver(bool useSparse) {
+    updRep().setUseSparseConstraintSolver(useSparse);
+}
+
+bool SimbodyMatterSubsystem::getUseSparseConstraintSolver() const {
+    return getRep().getUseSparseConstraintSolver();
+}
+
+void SimbodyMatterSubsystem::
+setUseModifiedNewtonProjection(bool useModifiedNewton) {
+    updRep().setUseModifiedNewtonProjection(useModifiedNewton);
+}
+
+bool SimbodyMatterSubsystem::getUseModifiedNewtonProjection() const {
+    return getRep().getUseModifiedNewtonProjection();
+}
+
+int SimbodyMatterSubsystem::
+getNumBodiesRecalculatedInPositionKinematics(const State& state) const {
+    return getRep().getNumBodiesRecalculatedInPositionKinematics(state);
+}
+
+int SimbodyMatterSubsystem::
+getNumProjectionFactorizations(const State& state) const {
+    return getRep().getNumProjectionFactorizations(state);
+}
+
+int SimbodyMatterSubsystem::
+getNumProjectionFactorizationReuses(const State& state) const {
+    return getRep().getNumProjectionFactorizationReuses(state);
+}
+
 
 ConstraintIndex SimbodyMatterSubsystem::
 adoptConstraint(Constraint& child) {return updRep().adoptConstraint(child);}
@@ -472,12 +534,122 @@ void SimbodyMatterSubsystem::multiplyByMInv(const State&    state,
 
 
 
+namespace {
+// Return true if the given matrix stores its columns one after another in a
+// single contiguous block of memory, as the multiple right-hand side operators
+// require.
+template <class ELT>
+bool hasPackedColumns(const Matrix_<ELT>& m) {
+    if (m.nrow() == 0 || m.ncol() == 0) return true;
+    if (!m.hasContiguousData()) return false;
+    return m.ncol() == 1 || &m(0,1) == &m(0,0) + m.nrow();
+}
+
+// Return true if the storage spanned by the elements of matrices a and b 
+// might overlap, for example because they are the same Matrix or views of
+// the same one. This is conservative for views with gaps between columns.
+template <class EA, class EB>
+bool mayOverlap(const Matrix_<EA>& a, const Matrix_<EB>& b) {
+    if (a.nelt() == 0 || b.nelt() == 0) return false;
+    const char* aBegin = (const char*)&a(0,0);
+    const char* aEnd   = (const char*)(&a(a.nrow()-1, a.ncol()-1) + 1);
+    const char* bBegin = (const char*)&b(0,0);
+    const char* bEnd   = (const char*)(&b(b.nrow()-1, b.ncol()-1) + 1);
+    return aBegin < bEnd && bBegin < aEnd;
+}
+
+// Resize "out" to nOutRows X in.ncol(), then call op(ncol, inData, outData) 
+// with packed-column copies of the input and output matrices if the caller's
+// matrices aren't already stored that way. The input is also copied if it
+// shares storage with the output, since the output is cleared before op is
+// called and op may write its output before it has read all its input.
+template <class EIN, class EOUT, class MultiColumnOp>
+void applyToPackedColumns(const Matrix_<EIN>& in, int nOutRows,
+                          Matrix_<EOUT>& out, const MultiColumnOp& op) 
+{
+    const int ncol = in.ncol();
+    Matrix_<EIN> in_contig; Matrix_<EOUT> out_contig; // allocate only if needed
+    const Matrix_<EIN>* inp = &in;
+    if (mayOverlap(in, out)) {
+        in_contig.resize(in.nrow(), ncol);
+        in_contig = in;
+        inp = &in_contig;
+    }
+
+    out.resize(nOutRows, ncol);
+    if (ncol == 0 || nOutRows == 0) return;
+
+    if (!hasPackedColumns(*inp)) {
+        in_contig.resize(in.nrow(), ncol);
+        in_contig = in;
+        inp = &in_contig;
+    }
+    const bool outIsPacked = hasPackedColumns(out);
+    Matrix_<EOUT>* outp = &out;
+    if (!outIsPacked) {
+        out_contig.resize(nOutRows, ncol);
+        outp = &out_contig;
+    }
+    outp->setToZero(); // operators may leave some entries unwritten
+
+    op(ncol, inp->nrow() ? &(*inp)(0,0) : nullptr, &(*outp)(0,0));
+
+    if (!outIsPacked)
+        out = out_contig;
+}
+}
+
+void SimbodyMatterSubsystem::multiplyByMMultiple(const State&   state,
+                                                 const Matrix&  A,
+                                                 Matrix&        MA) const
+{
+    const SimbodyMatterSubsystemRep& rep = getRep();
+    const int nu = rep.getNU(state);
+
+    SimTK_ERRCHK2_ALWAYS(A.nrow() == nu,
+        "SimbodyMatterSubsystem::multiplyByMMultiple()",
+        "Argument 'A' had %d rows but should have one row for each"
+        " of the %d mobilities (generalized speeds u).", A.nrow(), nu);
+
+    applyToPackedColumns(A, nu, MA, 
+        [&](int ncol, const Real* in, Real* out)
+        {   rep.multiplyByM(state, ncol, in, out); });
+}
+
+void SimbodyMatterSubsystem::multiplyByMInvMultiple(const State&    state,
+                                                    const Matrix&   V,
+                                                    Matrix&         MInvV) const
+{
+    const SimbodyMatterSubsystemRep& rep = getRep();
+    const int nu = rep.getNU(state);
+
+    SimTK_ERRCHK2_ALWAYS(V.nrow() == nu,
+        "SimbodyMatterSubsystem::multiplyByMInvMultiple()",
+        "Argument 'V' had %d rows but should have one row for each"
+        " of the %d mobilities (generalized speeds u).", V.nrow(), nu);
+
+    applyToPackedColumns(V, nu, MInvV, 
+        [&](int ncol, const Real* in, Real* out)
+        {   rep.multiplyByMInv(state, ncol, in, out); });
+}
+
+
+
 void SimbodyMatterSubsystem::calcM(const State& s, Matrix& M) const 
 {   getRep().calcM(s, M); }
 
 void SimbodyMatterSubsystem::calcMInv(const State& s, Matrix& MInv) const 
 {   getRep().calcMInv(s, MInv); }
 
+void SimbodyMatterSubsystem::
+solveWithMFactorization(const State& s, const Vector& f, Vector& x) const 
+{   getRep().solveWithMFactorization(s, f, x); }
+
+void SimbodyMatterSubsystem::
+calcMInvSubmatrix(const State& s, const Array_<UIndex>& mobilities,
+                  Matrix& MInvSub) const 
+{   getRep().calcMInvSubmatrix(s, mobilities, MInvSub); }
+
 
 // Note: the implementation methods that generate matrices do *not* require 
 // contiguous storage, so we can just forward to them with no preliminaries.
@@ -485,6 +657,25 @@ void SimbodyMatterSubsystem::calcProjectedMInv(const State&   s,
                                                Matrix&        GMInvGt) const
 {   getRep().calcGMInvGt(s, GMInvGt); }
 
+void SimbodyMatterSubsystem::
+calcProjectedMInvBlocks(const State&                        s,
+                        Array_< Array_<MultiplierIndex> >&  blockMultipliers,
+                        Array_<Matrix>&                     blocks) const
+{
+    const SimbodyMatterSubsystemRep& rep = getRep();
+    Array_< Array_<int> > groups;
+    rep.findDecoupledConstraintGroups(s, groups);
+    rep.calcGMInvGtBlocks(s, groups, blocks);
+
+    blockMultipliers.resize(groups.size());
+    for (unsigned g=0; g < groups.size(); ++g) {
+        const Array_<int>& group = groups[g];
+        blockMultipliers[g].resize(group.size());
+        for (unsigned i=0; i < group.size(); ++i)
+            blockMultipliers[g][i] = MultiplierIndex(group[i]);
+    }
+}
+
 void SimbodyMatterSubsystem::
 solveForConstraintImpulses(const State&     state,
                            const Vector&    deltaV,
@@ -1107,6 +1298,23 @@ void SimbodyMatterSubsystem::multiplyBySystemJacobian
 }
 
 
+// Multiple right-hand side version; see applyToPackedColumns() above.
+void SimbodyMatterSubsystem::multiplyBySystemJacobianMultiple
+   (const State& s, const Matrix& U, Matrix_<SpatialVec>& JU) const
+{   
+    const SimbodyMatterSubsystemRep& rep = getRep();
+    const int nb = rep.getNumBodies(), nu = rep.getNumMobilities();
+
+    SimTK_ERRCHK2_ALWAYS(U.nrow() == nu,
+        "SimbodyMatterSubsystem::multiplyBySystemJacobianMultiple()",
+        "The supplied u-space Matrix had %d rows; expected %d.",U.nrow(),nu);
+
+    applyToPackedColumns(U, nb, JU, 
+        [&](int ncol, const Real* in, SpatialVec* out)
+        {   rep.multiplyBySystemJacobian(s, ncol, in, out); });
+}
+
+
 //------------------------------------------------------------------------------
 //                  MULTIPLY BY SYSTEM JACOBIAN TRANSPOSE
 //------------------------------------------------------------------------------
@@ -1140,6 +1348,24 @@ void SimbodyMatterSubsystem::multiplyBySystemJacobianTranspose
 }
 
 
+// Multiple right-hand side version; see applyToPackedColumns() above.
+void SimbodyMatterSubsystem::multiplyBySystemJacobianTransposeMultiple
+   (const State& s, const Matrix_<SpatialVec>& F_G, Matrix& f) const
+{   
+    const SimbodyMatterSubsystemRep& rep = getRep();
+    const int nb = rep.getNumBodies(), nu = rep.getNumMobilities();
+
+    SimTK_ERRCHK2_ALWAYS(F_G.nrow() == nb,
+        "SimbodyMatterSubsystem::multiplyBySystemJacobianTransposeMultiple()",
+        "The supplied spatial forces Matrix had %d rows; expected %d.",
+        F_G.nrow(),nb);
+
+    applyToPackedColumns(F_G, nu, f, 
+        [&](int ncol, const SpatialVec* in, Real* out)
+        {   rep.multiplyBySystemJacobianTranspose(s, ncol, in, out); });
+}
+
+
 //------------------------------------------------------------------------------
 //                       CALC SYSTEM JACOBIAN (spatial)
 //------------------------------------------------------------------------------
@@ -2061,6 +2287,11 @@ realizeArticulatedBodyInertias(const State& s) const {
     getRep().realizeArticulatedBodyInertias(s);
 }
 
+void SimbodyMatterSubsystem::
+realizeMFactorization(const State& s) const {
+    getRep().realizeMFactorization(s);
+}
+
 void SimbodyMatterSubsystem::
 realizeArticulatedBodyVelocity(const State& s) const {
     getRep().realizeArticulatedBodyVelocity(s);
@@ -2091,6 +2322,11 @@ invalidateArticulatedBodyVelocity(const State& s) const {
     getRep().invalidateArticulatedBodyVelocity(s);
 }
 
+void SimbodyMatterSubsystem::
+invalidateMFactorization(const State& s) const {
+    getRep().invalidateMFactorization(s);
+}
+
 bool SimbodyMatterSubsystem::
 isPositionKinematicsRealized(const State& state) const
 {   return getRep().isPositionKinematicsRealized(state); }
@@ -2106,6 +2342,9 @@ isArticulatedBodyInertiasRealized(const State& state) const
 bool SimbodyMatterSubsystem::
 isArticulatedBodyVelocityRealized(const State& state) const
 {   return getRep().isArticulatedBodyVelocityRealized(state); }
+bool SimbodyMatterSubsystem::
+isMFactorizationRealized(const State& state) const
+{   return getRep().isMFactorizationRealized(state); }
 
 const Array_<QIndex>& SimbodyMatterSubsystem::
 getFreeQIndex(const State& state) const
@@ -37,6 +37,8 @@
 
 #include <string>
 #include <iostream>
+#include <exception>
+#include <algorithm>
 using std::cout; using std::endl;
 
 SimbodyMatterSubsystemRep::SimbodyMatterSubsystemRep
@@ -102,6 +104,9 @@ void SimbodyMatterSubsystemRep::clearTopologyCache() {
     // be deleted when the MobilizedBodyImpl objects are.
     rbNodeLevels.clear();
     nodeNum2NodeMap.clear();
+    uParent.clear();
+    uDepth.clear();
+    mFactorStart.clear();
 
     showDefaultGeometry = true;
 }
@@ -245,6 +250,113 @@ getArticulatedBodyCentrifugalForces(const State& s, MobodIndex body) const {
 
 
 
+//==============================================================================
+//                                LEVEL SWEEPS
+//==============================================================================
+namespace {
+// This is the ParallelExecutor Task used to process the nodes of one tree
+// level in parallel. The level's nodes are split into nChunks contiguous
+// chunks and each execute(chunk) call processes one of them. Any exception
+// thrown by a node is caught here and rethrown on the calling thread once
+// the whole level is done, since ParallelExecutor would otherwise swallow it.
+template <class NodeOp>
+class LevelSweepTask : public ParallelExecutor::Task {
+public:
+    LevelSweepTask(const RigidBodyNode* const* nodes, int nNodes, int nChunks,
+                   const NodeOp& nodeOp)
+    :   nodes(nodes), nNodes(nNodes), nChunks(nChunks), nodeOp(nodeOp),
+        errors(nChunks) {}
+
+    void execute(int chunk) override {
+        const int begin = (chunk*nNodes)/nChunks;
+        const int end   = ((chunk+1)*nNodes)/nChunks;
+        try {
+            for (int k=begin; k < end; ++k)
+                nodeOp(*nodes[k]);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    }
+
+    void rethrowAnyError() const {
+        for (int i=0; i < nChunks; ++i)
+            if (errors[i]) std::rethrow_exception(errors[i]);
+    }
+private:
+    const RigidBodyNode* const*     nodes;
+    const int                       nNodes, nChunks;
+    const NodeOp&                   nodeOp;
+    Array_<std::exception_ptr>      errors;
+};
+}
+
+template <class NodeOp> void SimbodyMatterSubsystemRep::
+forEachNodeAtLevel(int level, const NodeOp& nodeOp) const {
+    const RBNodePtrList& nodes = rbNodeLevels[level];
+    const int nNodes = (int)nodes.size();
+    const int nChunks = levelExecutor 
+        ? std::min(levelExecutor->getMaxThreads(), nNodes/minBodiesPerThread)
+        : 1;
+
+    // Don't wait for the executor if some other sweep is using it.
+    if (nChunks < 2 || !levelExecutorLock.try_lock()) {
+        for (int j=0 ; j<nNodes ; ++j)
+            nodeOp(*nodes[j]);
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(levelExecutorLock, std::adopt_lock);
+    LevelSweepTask<NodeOp> task(&nodes[0], nNodes, nChunks, nodeOp);
+    levelExecutor->execute(task, nChunks);
+    task.rethrowAnyError();
+}
+
+template <class NodeOp> void SimbodyMatterSubsystemRep::
+sweepInward(const NodeOp& nodeOp) const {
+    for (int i=(int)rbNodeLevels.size()-1 ; i>=0 ; --i)
+        forEachNodeAtLevel(i, nodeOp);
+}
+
+template <class NodeOp> void SimbodyMatterSubsystemRep::
+sweepOutward(const NodeOp& nodeOp) const {
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        forEachNodeAtLevel(i, nodeOp);
+}
+
+void SimbodyMatterSubsystemRep::
+setNumberOfThreads(int numThreads, bool limitToProcessors) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, "SimbodyMatterSubsystem",
+        "setNumberOfThreads", "Illegal number of threads %d.", numThreads);
+    // More threads than processors can only add overhead; timings showed
+    // the sweeps running at 0.3-0.8 times the serial speed that way.
+    const int useThreads = limitToProcessors
+        ? std::min(numThreads, ParallelExecutor::getNumProcessors())
+        : numThreads;
+    std::lock_guard<std::mutex> guard(levelExecutorLock);
+    numThreadsRequested = numThreads;
+    if (useThreads == 1) levelExecutor.reset();
+    else levelExecutor.reset(new ParallelExecutor(useThreads));
+}
+
+int SimbodyMatterSubsystemRep::getNumberOfThreads() const {
+    return numThreadsRequested;
+}
+
+int SimbodyMatterSubsystemRep::getNumberOfThreadsInUse() const {
+    std::lock_guard<std::mutex> guard(levelExecutorLock);
+    return levelExecutor ? levelExecutor->getMaxThreads() : 1;
+}
+
+void SimbodyMatterSubsystemRep::setMinBodiesPerThread(int minBodies) {
+    SimTK_APIARGCHECK1_ALWAYS(minBodies > 0, "SimbodyMatterSubsystem",
+        "setMinBodiesPerThread", 
+        "Minimum number of bodies per thread must be positive but was %d.",
+        minBodies);
+    minBodiesPerThread = minBodies;
+}
+
+
+
 //==============================================================================
 //                               REALIZE TOPOLOGY
 //==============================================================================
@@ -291,6 +403,30 @@ void SimbodyMatterSubsystemRep::endConstruction(State& s) {
         DOFTotal += ndof; SqDOFTotal += ndof*ndof;
         maxNQTotal += n.getMaxNQ();
     }
+
+    // Record the branch-induced sparsity pattern of the mass matrix. Parents
+    // precede their children in the sweep and have lower-numbered mobilities,
+    // so each mobility's parent has already been processed.
+    uParent.resize(DOFTotal);
+    uDepth.resize(DOFTotal);
+    Array_<int> lastU(getNumBodies(), -1); // indexed by nodeNum
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
+            const RigidBodyNode& node = *rbNodeLevels[i][j];
+            int prev = node.isGroundNode() 
+                ? -1 : lastU[node.getParent()->getNodeNum()];
+            for (int k=0; k < node.getDOF(); ++k) {
+                const int u = node.getUIndex() + k;
+                uParent[u] = prev;
+                uDepth[u]  = prev < 0 ? 0 : uDepth[prev] + 1;
+                prev = u;
+            }
+            lastU[node.getNodeNum()] = prev;
+        }
+    mFactorStart.resize(DOFTotal+1);
+    mFactorStart[0] = 0;
+    for (int u=0; u < DOFTotal; ++u)
+        mFactorStart[u+1] = mFactorStart[u] + uDepth[u] + 1;
     
     // Order doesn't matter for constraints as long as the bodies are already 
     // there. Quaternion normalization constraints exist only at the 
@@ -401,6 +537,19 @@ int SimbodyMatterSubsystemRep::realizeSubsystemTopologyImpl(State& s) const {
         allocateLazyCacheEntry(s, Stage::Time,
                                new Value<SBConstrainedPositionCache>());
 
+    // This remembers the q's used for the most recent position kinematics so
+    // that those can be recalculated incrementally; it must survive changes
+    // to q.
+    tc.treePositionSnapshotCacheIndex = 
+        allocateLazyCacheEntry(s, Stage::Instance,
+                               new Value<SBTreePositionSnapshotCache>());
+
+    // The factored projection matrices are kept for reuse by later 
+    // projections, so this also must survive changes to q and u.
+    tc.projectionMatrixCacheIndex = 
+        allocateLazyCacheEntry(s, Stage::Instance,
+                               new Value<SBProjectionMatrixCache>());
+
     // Composite body inertias *can* be calculated any time after 
     // PositionKinematics are available, but they aren't ever needed internally
     // so we won't compute them unless explicitly requested.
@@ -410,6 +559,14 @@ int SimbodyMatterSubsystemRep::realizeSubsystemTopologyImpl(State& s) const {
         {CacheEntryKey(getMySubsystemIndex(), tc.treePositionCacheIndex)},
         new Value<SBCompositeBodyInertiaCache>());
 
+    // The sparse mass matrix factorization is likewise computed only on 
+    // request.
+    tc.massMatrixFactorCacheIndex = s.allocateCacheEntryWithPrerequisites
+       (getMySubsystemIndex(), Stage::Instance, Stage::Infinity,
+        false /*q*/, false /*u*/, false /*z*/, {} /*dv*/, 
+        {CacheEntryKey(getMySubsystemIndex(), tc.treePositionCacheIndex)},
+        new Value<SBMassMatrixFactorCache>());
+
     // Articulated body inertias *can* be calculated any time after 
     // PositionKinematics are available but we want to put them off until 
     // Acceleration stage if possible.
@@ -534,7 +691,7 @@ int SimbodyMatterSubsystemRep::realizeSubsystemModelImpl(State& s) const {
     // which decides whether ball-like joints get quaternions or Euler angles.
     mc.totalNQInUse = mc.totalNUInUse = mc.totalNQuaternionsInUse = 0;
     mc.totalNQPoolInUse = 0;
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
         for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node  = *rbNodeLevels[i][j];
             SBModelPerMobodInfo& mbInfo = 
@@ -572,7 +729,7 @@ int SimbodyMatterSubsystemRep::realizeSubsystemModelImpl(State& s) const {
 
 
     // Give the bodies a chance to put something in the cache if they need to.
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
         for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->realizeModel(sbs); 
 
@@ -992,7 +1149,9 @@ realizeSubsystemInstanceImpl(const State& s) const {
     updTimeCache(s).allocate(topologyCache, mc, ic);
     updTreePositionCache(s).allocate(topologyCache, mc, ic);
     updConstrainedPositionCache(s).allocate(topologyCache, mc, ic);
+    updTreePositionSnapshotCache(s).allocate(topologyCache, mc, ic);
     updCompositeBodyInertiaCache(s).allocate(topologyCache, mc, ic);
+    updMassMatrixFactorCache(s).allocate(topologyCache, mc, ic);
     updArticulatedBodyInertiaCache(s).allocate(topologyCache, mc, ic);
     updTreeVelocityCache(s).allocate(topologyCache, mc, ic);
     updConstrainedVelocityCache(s).allocate(topologyCache, mc, ic);
@@ -1003,8 +1162,8 @@ realizeSubsystemInstanceImpl(const State& s) const {
 
     // Now let the implementing RigidBodyNodes do their realization.
     SBStateDigest stateDigest(s, *this, Stage::Instance);
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++)
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->realizeInstance(stateDigest); 
     
     return 0;
@@ -1130,9 +1289,52 @@ realizePositionKinematics(const State& state) const {
     // Any body which is using quaternions should calculate the quaternion
     // constraint here and put it in the appropriate slot of qErr.
     // Set generalized coordinates: sweep from base to tips.
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++)
-            rbNodeLevels[i][j]->realizePosition(stateDigest); 
+    const CacheEntryIndex snapx = topologyCache.treePositionSnapshotCacheIndex;
+    SBTreePositionSnapshotCache& snap = updTreePositionSnapshotCache(state);
+    const Vector& q = stateDigest.getQ();
+    Vector& qErr = stateDigest.updQErr();
+
+    // If q hasn't been touched since the last realization, position 
+    // kinematics must have been invalidated for some other reason, such as a
+    // call to invalidatePositionKinematics(), so we can't trust the snapshot.
+    if (useIncrementalPositionKinematics && isCacheValueRealized(state, snapx)
+        && state.getQValueVersion() != snap.lastQVersion
+        && snap.lastQ.size() == q.size() && snap.lastQErr.size() == qErr.size())
+    {
+        // Everything in the TreePositionCache is still there from the last 
+        // realization in this State (or the State it was copied from), so we
+        // only need to recalculate bodies whose own q's have changed since 
+        // then, or whose parent was recalculated. The quaternion errors are
+        // restored first so that unchanged bodies' entries are correct.
+        qErr = snap.lastQErr;
+        const SBModelCache& mc = stateDigest.getModelCache();
+        snap.changed[MobilizedBodyIndex(0)] = false; // Ground
+        int nRecalc = 0;
+        for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+            for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
+                const RigidBodyNode& node = *rbNodeLevels[i][j];
+                bool changed = snap.changed[node.getParent()->getNodeNum()];
+                const int firstQ = node.getFirstQIndex(mc);
+                const int nq = node.getNumQInUse(mc);
+                for (int k=0; k < nq && !changed; ++k)
+                    changed = (q[firstQ+k] != snap.lastQ[firstQ+k]);
+                snap.changed[node.getNodeNum()] = changed;
+                if (changed) {
+                    node.realizePosition(stateDigest);
+                    ++nRecalc;
+                }
+            }
+        snap.nBodiesRecalculated = nRecalc;
+    } else {
+        for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+            for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
+                rbNodeLevels[i][j]->realizePosition(stateDigest); 
+        snap.nBodiesRecalculated = getNumBodies() - 1; // not Ground
+    }
+    snap.lastQ = q;
+    snap.lastQErr = qErr;
+    snap.lastQVersion = state.getQValueVersion();
+    markCacheValueRealized(state, snapx);
 
     // Ask the constraints to calculate ancestor-relative kinematics (still 
     // goes in TreePositionCache).
@@ -1161,6 +1363,46 @@ invalidatePositionKinematics(const State& state) const {
     state.invalidateAllCacheAtOrAbove(Stage::Position);
     const CacheEntryIndex tpcx = topologyCache.treePositionCacheIndex;
     markCacheValueNotRealized(state, tpcx);
+    // Make sure the next realization isn't incremental.
+    markCacheValueNotRealized(state, 
+                              topologyCache.treePositionSnapshotCacheIndex);
+}
+
+// The snapshot is only valid after position kinematics has been realized at
+// least once since the last Instance-stage change.
+int SimbodyMatterSubsystemRep::
+getNumBodiesRecalculatedInPositionKinematics(const State& state) const {
+    const CacheEntryIndex snapx = topologyCache.treePositionSnapshotCacheIndex;
+    if (!isCacheValueRealized(state, snapx))
+        return 0;
+    return Value<SBTreePositionSnapshotCache>::downcast
+                (getCacheEntry(state, snapx)).get().nBodiesRecalculated;
+}
+
+// The projection matrix cache depends only on Instance stage. If that has
+// been invalidated since the cache was last used, the matrices it holds no 
+// longer match the constraints in use and must be discarded, but we keep the
+// statistics.
+SBProjectionMatrixCache& SimbodyMatterSubsystemRep::
+updProjectionMatrixCacheForReuse(const State& state) const {
+    const CacheEntryIndex pmcx = topologyCache.projectionMatrixCacheIndex;
+    SBProjectionMatrixCache& pmc = updProjectionMatrixCache(state);
+    if (!isCacheValueRealized(state, pmcx)) {
+        pmc.position.invalidate();
+        pmc.velocity.invalidate();
+        markCacheValueRealized(state, pmcx);
+    }
+    return pmc;
+}
+
+int SimbodyMatterSubsystemRep::
+getNumProjectionFactorizations(const State& state) const {
+    return updProjectionMatrixCache(state).nFactorizations;
+}
+
+int SimbodyMatterSubsystemRep::
+getNumProjectionFactorizationReuses(const State& state) const {
+    return updProjectionMatrixCache(state).nReuses;
 }
 
 //==============================================================================
@@ -1211,6 +1453,45 @@ invalidateCompositeBodyInertias(const State& state) const {
 
 
 
+//==============================================================================
+//                        REALIZE MASS MATRIX FACTORIZATION
+//==============================================================================
+void SimbodyMatterSubsystemRep::
+realizeMFactorization(const State& state) const {
+    const CacheEntryIndex mfx = topologyCache.massMatrixFactorCacheIndex;
+
+    if (isCacheValueRealized(state, mfx))
+        return; // already realized
+
+    SimTK_ERRCHK_ALWAYS(isPositionKinematicsRealized(state), 
+        "SimbodyMatterSubsystem::realizeMFactorization()",
+        "The mass matrix factorization cannot be realized unless the state "
+        "has been realized to Stage::Position or realizePositionKinematics() "
+        "has been called explicitly.");
+
+    SBMassMatrixFactorCache& mfc = Value<SBMassMatrixFactorCache>::
+                                    updDowncast(updCacheEntry(state, mfx));
+
+    calcMFactorization(state, mfc.LD);
+    markCacheValueRealized(state, mfx);
+}
+
+// The factorization is realized only if it was last realized since any change
+// to Stage::Instance, PositionKinematics, and generalized coordinates q.
+bool SimbodyMatterSubsystemRep::
+isMFactorizationRealized(const State& state) const {
+    const CacheEntryIndex mfx = topologyCache.massMatrixFactorCacheIndex;
+    return isCacheValueRealized(state, mfx);
+}
+
+void SimbodyMatterSubsystemRep::
+invalidateMFactorization(const State& state) const {
+    const CacheEntryIndex mfx = topologyCache.massMatrixFactorCacheIndex;
+    markCacheValueNotRealized(state, mfx);
+}
+
+
+
 //==============================================================================
 //                     REALIZE ARTICULATED BODY INERTIAS
 //==============================================================================
@@ -1237,10 +1518,10 @@ realizeArticulatedBodyInertias(const State& state) const {
     const SBTreePositionCache&      tpc = getTreePositionCache(state);
     SBArticulatedBodyInertiaCache&  abc = updArticulatedBodyInertiaCache(state);
 
-    // tip-to-base sweep
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; --i) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
-            rbNodeLevels[i][j]->realizeArticulatedBodyInertiasInward(ic,tpc,abc);
+    // tip-to-base sweep (bodies at the same level may be done in parallel)
+    sweepInward([&](const RigidBodyNode& node) {
+        node.realizeArticulatedBodyInertiasInward(ic,tpc,0,abc);
+    });
 
     markCacheValueRealized(state, abx);
 }
@@ -1374,7 +1655,7 @@ realizeVelocityKinematics(const State& state) const {
     // and all global velocities relative to Ground (G). Also computes qdots.
 
     // Set generalized speeds: sweep from base to tips.
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
         for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->realizeVelocity(stateDigest); 
 
@@ -1453,8 +1734,8 @@ realizeArticulatedBodyVelocity(const State& state) const {
 
     // Order doesn't matter for this calculation. Ground's entries are
     // precalculated so start at level 1.
-    for (int i=1 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++)
+    for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->realizeArticulatedBodyVelocityCache
                                                             (tpc,tvc,abc,abvc);
 
@@ -1502,8 +1783,8 @@ int SimbodyMatterSubsystemRep::realizeSubsystemDynamicsImpl(const State& s)  con
     SBDynamicsCache& dc = stateDigest.updDynamicsCache();
 
     // Probably nothing to do here.
-    for (int i=0; i < (int)rbNodeLevels.size(); ++i)
-        for (int j=0; j < (int)rbNodeLevels[i].size(); ++j)
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->realizeDynamics(stateDigest);
 
     // MobilizedBodies
@@ -1565,7 +1846,7 @@ int SimbodyMatterSubsystemRep::realizeSubsystemReportImpl(const State& s) const
 
     // realize RB nodes report
     SBStateDigest stateDigest(s, *this, Stage::Report);
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
         for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->realizeReport(stateDigest);
 
@@ -1660,8 +1941,8 @@ void SimbodyMatterSubsystemRep::setDefaultModelValues(const SBTopologyCache& top
     modelVars.useEulerAngles = false;
 
     // Node/joint-level defaults
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->setNodeDefaultModelValues(topologyCache, modelVars);
 
 }
@@ -1670,8 +1951,8 @@ void SimbodyMatterSubsystemRep::setDefaultInstanceValues(const SBModelVars& mv,
                                                          SBInstanceVars& iv) const 
 {
     // Node/joint-level defaults
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->setNodeDefaultInstanceValues(mv, iv);
 
     assert((int)iv.mobilizerLockLevel.size() == getNumBodies());
@@ -1697,8 +1978,8 @@ void SimbodyMatterSubsystemRep::setDefaultTimeValues(const SBModelVars& mv,
     // Tree-level defaults (none)
 
     // Node/joint-level defaults
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->setNodeDefaultTimeValues(mv, timeVars);
 
     // TODO: constraint defaults
@@ -1710,8 +1991,8 @@ void SimbodyMatterSubsystemRep::setDefaultPositionValues(const SBModelVars& mv,
 
 
     // Node/joint-level defaults
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->setNodeDefaultPositionValues(mv, q);
 
     // TODO: constraint defaults
@@ -1722,8 +2003,8 @@ void SimbodyMatterSubsystemRep::setDefaultVelocityValues(const SBModelVars& mv,
     // Tree-level defaults (none)
 
     // Node/joint-level defaults
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->setNodeDefaultVelocityValues(mv, u);
 
     // TODO: constraint defaults
@@ -1735,8 +2016,8 @@ void SimbodyMatterSubsystemRep::setDefaultDynamicsValues(const SBModelVars& mv,
     // Tree-level defaults (none)
 
     // Node/joint-level defaults
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->setNodeDefaultDynamicsValues(mv, dynamicsVars);
 
     // TODO: constraint defaults
@@ -1748,8 +2029,8 @@ void SimbodyMatterSubsystemRep::setDefaultAccelerationValues(const SBModelVars&
     // Tree-level defaults (none)
 
     // Node/joint-level defaults
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->setNodeDefaultAccelerationValues(mv, accVars);
 
     // TODO: constraint defaults
@@ -3559,6 +3840,233 @@ calcGMInvGt(const State&   s,
 
 
 
+// =============================================================================
+//                    FIND DECOUPLED CONSTRAINT GROUPS
+// =============================================================================
+// Each base-body subtree is a separate articulated system as far as the mass
+// matrix is concerned, so M^-1 is block diagonal by subtree. A constraint's
+// rows of G involve only mobilities along the paths from its constrained
+// bodies to their common ancestor, plus any constrained mobilizers, all of
+// which lie in the subtrees of those bodies' base bodies. Two constraints
+// therefore interact in G M^-1 ~G only if they share a subtree, and we group
+// them here with a union-find over base bodies.
+//
+// Cost is O(nb + sum of constrained bodies and mobilizers); nothing here is
+// cached since it is trivial compared to even a single O(n) sweep.
+void SimbodyMatterSubsystemRep::
+findDecoupledConstraintGroups(const State&                 s, 
+                              Array_< Array_<int> >&       groups,
+                              Array_<int,MobilizedBodyIndex>* groupOfBody) const
+{
+    const SBInstanceCache& ic = getInstanceCache(s);
+    const int mHolo    = ic.totalNHolonomicConstraintEquationsInUse;
+    const int mNonholo = ic.totalNNonholonomicConstraintEquationsInUse;
+    const int nb       = getNumBodies();
+
+    groups.clear();
+
+    // Mobilized bodies are numbered so that parents precede children, so one
+    // pass suffices to find the base body of each body. Ground is its own
+    // base and is never merged with anything.
+    Array_<int> root(nb);
+    root[0] = 0;
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const MobilizedBodyIndex parent = 
+            getRigidBodyNode(mbx).getParent()->getNodeNum();
+        root[mbx] = parent == GroundIndex ? int(mbx) : root[parent];
+    }
+
+    struct Find {
+        explicit Find(Array_<int>& root) : root(root) {}
+        int operator()(int b) const {
+            while (root[b] != b) b = root[b] = root[root[b]];
+            return b;
+        }
+        Array_<int>& root;
+    } find(root);
+
+    // Merge the subtrees touched by each enabled constraint. Remember one
+    // non-Ground body per constraint to identify its group afterwards.
+    Array_<int> anyBody(constraints.size(), 0);
+    for (ConstraintIndex cx(0); cx < constraints.size(); ++cx) {
+        if (isConstraintDisabled(s,cx))
+            continue;
+        const ConstraintImpl& crep = constraints[cx]->getImpl();
+        Array_<MobilizedBodyIndex> touched;
+        for (ConstrainedBodyIndex cbx(0); 
+             cbx < crep.getNumConstrainedBodies(); ++cbx)
+            touched.push_back(crep.getMobilizedBodyIndexOfConstrainedBody(cbx));
+        for (ConstrainedMobilizerIndex cmx(0); 
+             cmx < crep.getNumConstrainedMobilizers(); ++cmx)
+            touched.push_back
+               (crep.getMobilizedBodyIndexOfConstrainedMobilizer(cmx));
+        for (unsigned i=0; i < touched.size(); ++i) {
+            if (touched[i] == GroundIndex) continue;
+            const int b = find(touched[i]);
+            if (anyBody[cx] == 0) anyBody[cx] = b;
+            else root[b] = find(anyBody[cx]);
+        }
+    }
+
+    // Now deal out the multipliers in order. A constraint that touches only
+    // Ground (anyBody==0) generates no coupling, but must still be solved, so
+    // it gets a group of its own.
+    Array_<int> groupOfRoot(nb, -1);
+    for (ConstraintIndex cx(0); cx < constraints.size(); ++cx) {
+        if (isConstraintDisabled(s,cx))
+            continue;
+        const SBInstancePerConstraintInfo& 
+                              cInfo = ic.getConstraintInstanceInfo(cx);
+        const Segment& holoSeg    = cInfo.holoErrSegment;
+        const Segment& nonholoSeg = cInfo.nonholoErrSegment;
+        const Segment& accOnlySeg = cInfo.accOnlyErrSegment;
+        if (holoSeg.length+nonholoSeg.length+accOnlySeg.length == 0)
+            continue;
+
+        int g;
+        if (anyBody[cx] == 0) {
+            g = (int)groups.size(); groups.push_back();
+        } else {
+            const int b = find(anyBody[cx]);
+            if (groupOfRoot[b] < 0) {
+                groupOfRoot[b] = (int)groups.size(); groups.push_back();
+            }
+            g = groupOfRoot[b];
+        }
+        Array_<int>& group = groups[g];
+        for (int i=0; i < holoSeg.length; ++i)
+            group.push_back(holoSeg.offset + i);
+        for (int i=0; i < nonholoSeg.length; ++i)
+            group.push_back(mHolo + nonholoSeg.offset + i);
+        for (int i=0; i < accOnlySeg.length; ++i)
+            group.push_back(mHolo + mNonholo + accOnlySeg.offset + i);
+    }
+
+    for (unsigned g=0; g < groups.size(); ++g)
+        std::sort(groups[g].begin(), groups[g].end());
+    Array_<int> order(groups.size());
+    for (unsigned g=0; g < groups.size(); ++g) order[g] = (int)g;
+    std::sort(order.begin(), order.end(), [&groups](int a, int b) 
+              {   return groups[a].front() < groups[b].front(); });
+    Array_< Array_<int> > sorted(groups.size());
+    Array_<int> newIndex(groups.size());
+    for (unsigned g=0; g < groups.size(); ++g) {
+        sorted[g].swap(groups[order[g]]);
+        newIndex[order[g]] = (int)g;
+    }
+    groups.swap(sorted);
+
+    if (groupOfBody) {
+        groupOfBody->resize(nb);
+        (*groupOfBody)[GroundIndex] = -1;
+        for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+            const int g = groupOfRoot[find(mbx)];
+            (*groupOfBody)[mbx] = g < 0 ? -1 : newIndex[g];
+        }
+    }
+}
+
+
+
+// =============================================================================
+//                           CALC GMINVGT BLOCKS
+// =============================================================================
+// Column j of every block is formed by the same sweep, using a unit lambda 
+// with a 1 in the j'th multiplier of each group that is at least that big.
+// Since the groups don't interact, each group's part of the result is just the
+// column it asked for.
+void SimbodyMatterSubsystemRep::
+calcGMInvGtBlocks(const State&                  s,
+                  const Array_< Array_<int> >&  groups,
+                  Array_<Matrix>&               blocks) const
+{
+    const SBInstanceCache& ic = getInstanceCache(s);
+    const int mHolo    = ic.totalNHolonomicConstraintEquationsInUse;
+    const int mNonholo = ic.totalNNonholonomicConstraintEquationsInUse;
+    const int mAccOnly = ic.totalNAccelerationOnlyConstraintEquationsInUse;
+    const int m        = mHolo+mNonholo+mAccOnly;  
+    const int nu       = getNU(s);
+
+    int maxGroupSize = 0;
+    blocks.resize(groups.size());
+    for (unsigned g=0; g < groups.size(); ++g) {
+        const int mk = (int)groups[g].size();
+        blocks[g].resize(mk, mk);
+        maxGroupSize = std::max(maxGroupSize, mk);
+    }
+    if (maxGroupSize == 0)
+        return;
+
+    Vector Gtcol(nu), MInvGtcol(nu), GMInvGtcol(m);
+    Vector bias(m);
+    calcBiasForMultiplyByPVA(s,true,true,true,bias);
+
+    Vector unitLambda(m, Real(0));
+    for (int j=0; j < maxGroupSize; ++j) {
+        for (unsigned g=0; g < groups.size(); ++g)
+            if (j < (int)groups[g].size()) unitLambda[groups[g][j]] = 1;
+        multiplyByPVATranspose(s, true, true, true, unitLambda, Gtcol);
+        multiplyByMInv(s, Gtcol, MInvGtcol);
+        multiplyByPVA(s, true, true, true, bias, MInvGtcol, GMInvGtcol);
+        for (unsigned g=0; g < groups.size(); ++g) {
+            const Array_<int>& group = groups[g];
+            if (j >= (int)group.size()) continue;
+            unitLambda[group[j]] = 0;
+            for (unsigned i=0; i < group.size(); ++i)
+                blocks[g](i,j) = GMInvGtcol[group[i]];
+        }
+    }
+}
+
+
+
+// =============================================================================
+//                        SOLVE GMINVGT BY BLOCKS
+// =============================================================================
+// Form only the diagonal blocks of G M^-1 ~G, one per decoupled constraint
+// group, using calcGMInvGtBlocks(). That takes as many sweeps as there are
+// equations in the largest group rather than m of them. Then factor each
+// block separately, costing sum(mk^3) rather than m^3.
+//
+// With a single group this is the same computation as calcGMInvGt() followed
+// by a FactorQTZ solve.
+void SimbodyMatterSubsystemRep::
+solveGMInvGtByBlocks(const State&  s,
+                     const Vector& rhs,
+                     Vector&       lambda) const
+{
+    const SBInstanceCache& ic = getInstanceCache(s);
+    const int mHolo    = ic.totalNHolonomicConstraintEquationsInUse;
+    const int mNonholo = ic.totalNNonholonomicConstraintEquationsInUse;
+    const int mAccOnly = ic.totalNAccelerationOnlyConstraintEquationsInUse;
+    const int m        = mHolo+mNonholo+mAccOnly;  
+
+    assert(rhs.size() == m);
+    lambda.resize(m);
+    if (m==0) return;
+    lambda.setToZero();
+
+    Array_< Array_<int> > groups;
+    findDecoupledConstraintGroups(s, groups);
+    Array_<Matrix> blocks;
+    calcGMInvGtBlocks(s, groups, blocks);
+
+    Vector rhsk, lambdak;
+    for (unsigned g=0; g < groups.size(); ++g) {
+        const Array_<int>& group = groups[g];
+        const int mk = (int)group.size();
+        // MUST MATCH THE DENSE METHOD'S TOLERANCE, per block.
+        const Real conditioningTol = mk * SqrtEps*std::sqrt(SqrtEps);
+        FactorQTZ qtz(blocks[g], conditioningTol);
+        rhsk.resize(mk);
+        for (int i=0; i < mk; ++i) rhsk[i] = rhs[group[i]];
+        qtz.solve(rhsk, lambdak);
+        for (int i=0; i < mk; ++i) lambda[group[i]] = lambdak[i];
+    }
+}
+
+
+
 // =============================================================================
 //                     SOLVE FOR CONSTRAINT IMPULSES
 // =============================================================================
@@ -3570,6 +4078,11 @@ solveForConstraintImpulses(const State&     state,
                            const Vector&    deltaV,
                            Vector&          impulse) const
 {
+    if (useSparseConstraintSolver) {
+        solveGMInvGtByBlocks(state, deltaV, impulse);
+        return;
+    }
+
     Matrix GMInvGt;
     calcGMInvGt(state, GMInvGt);
     // MUST DUPLICATE SIMBODY'S METHOD HERE:
@@ -3615,8 +4128,8 @@ calcBodyAccelerationFromUDot(const State&           s,
     // for each body (which is Jdot*u). (sherm 110829: I tried it both ways)
 
     // Sweep outward and delegate to RB nodes.
-    for (int i=0; i<(int)rbNodeLevels.size(); i++)
-        for (int j=0; j<(int)rbNodeLevels[i].size(); j++) {
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
             node.calcBodyAccelerationsFromUdotOutward
                (tpc,tvc,knownUdotPtr,aPtr);
@@ -4057,8 +4570,8 @@ void SimbodyMatterSubsystemRep::enforcePositionConstraints
         SBStateDigest sbs(s, *this, Stage::Model);
         Vector& q  = updQ(s); // invalidates q's. TODO: see below.
 
-        for (int i=0 ; i<(int)rbNodeLevels.size() ; i++) 
-            for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) { 
+        for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+            for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
                 const RigidBodyNode& node = *rbNodeLevels[i][j];
                 const SBInstancePerMobodInfo& mobodInfo =
                     ic.mobodInstanceInfo[node.getNodeNum()];
@@ -4201,7 +4714,8 @@ int SimbodyMatterSubsystemRep::projectQ
     // initialization.
     const bool localOnly = opts.isOptionSet(ProjectOptions::LocalOnly);
     // We are permitted to use an out-of-date Jacobian for projection unless
-    // this is set. TODO: always using full Newton at the moment.
+    // this is set. Even then we use a matrix from an earlier projection only
+    // in modified Newton mode.
     const bool forceFullNewton =
         opts.isOptionSet(ProjectOptions::ForceFullNewton);
 
@@ -4229,11 +4743,26 @@ int SimbodyMatterSubsystemRep::projectQ
     // (diagonal weights are symmetric). We only retain rows that 
     // correspond to free (non prescribed) q's.
     //
-    // This is a nonlinear least squares problem. Below is a full Newton 
-    // iteration since we recalculate the iteration matrix each time around the
-    // loop. TODO: a solution could be found using the same iteration matrix, 
-    // since we are projecting from (presumably) not too far away. Q1: will it
-    // be the same solution? Q2: if not, does it matter?
+    // This is a nonlinear least squares problem. Normally we use a full
+    // Newton iteration, recalculating the iteration matrix each time around
+    // the loop. In modified Newton mode we instead start with the matrix
+    // saved by an earlier projection of this State (if it still fits) and
+    // form a new one only when an iteration fails to reduce the error norm by
+    // at least a factor of 1/MaxRateWithOldMatrix. Since we are projecting
+    // from (presumably) not too far away, the result satisfies the
+    // constraints just as well, though it may not be exactly the same
+    // least-squares solution.
+    const bool modifiedNewton =
+        useModifiedNewtonProjection && !forceFullNewton;
+    const Real MaxRateWithOldMatrix = Real(0.25);
+
+    // Full Newton doesn't touch the saved matrices or their statistics.
+    SBProjectionMatrixCache* pmc = 
+        modifiedNewton ? &updProjectionMatrixCacheForReuse(s) : 0;
+    SBProjectionMatrixCache::Factored localPq;
+    SBProjectionMatrixCache::Factored& Pq = pmc ? pmc->position : localPq;
+    if (pmc && Pq.isValidFor(nfq, mHolo))
+        ++pmc->nReuses;
 
     // These will be updated as we go.
     Real perrNormAchieved = perrNormOnEntry;
@@ -4261,25 +4790,34 @@ int SimbodyMatterSubsystemRep::projectQ
     // if the attempts here make the constraint norm worse.
     const Vector saveQ = getQ(s);
 
-    Matrix Pqwrt(nfq,mHolo);
+    Matrix Pqwrt; // nfq X mHolo, allocated only if needed
     Vector dfq_WLS(nfq), du(nu), dq(nq); // = Wq^+ dq_WLS
     Vector udfq_WLS(hasPrescribedMotion ? nq : 0); // unpacked if needed
     udfq_WLS.setToZero(); // must initialize unwritten elements
-    FactorQTZ Pqwr_qtz;
     Real prevPerrNormAchieved = perrNormAchieved; // watch for divergence
     bool diverged = false;
     const int MaxIterations  = 20;
     do {
-        calcWeightedPqrTranspose(s, perrWeights, uAbsScale, Pqwrt);//nfq X mp
+        // Set if the iteration matrix is calculated at the current q.
+        const bool isNewMatrix = !modifiedNewton || !Pq.isValidFor(nfq,mHolo);
+        if (isNewMatrix) {
+            calcWeightedPqrTranspose(s, perrWeights, uAbsScale, Pqwrt);//nfq X mp
 
-        // This factorization acts like a pseudoinverse.
-        Pqwr_qtz.factor<Real>(~Pqwrt, conditioningTol); 
+            // This factorization acts like a pseudoinverse.
+            Pq.qtz.factor<Real>(~Pqwrt, conditioningTol); 
+            Pq.rowScale = perrWeights; Pq.colScale = uAbsScale;
+            Pq.nFree = nfq; Pq.m = mHolo;
+            if (pmc) ++pmc->nFactorizations;
+        }
 
         //printf("projectQ %d: m=%d condTol=%g rank=%d rcond=%g\n",
-        //    nItsUsed, Pqwrt.ncol(), conditioningTol, Pqwr_qtz.getRank(),
-        //    Pqwr_qtz.getRCondEstimate());
+        //    nItsUsed, Pqwrt.ncol(), conditioningTol, Pq.qtz.getRank(),
+        //    Pq.qtz.getRCondEstimate());
 
-        Pqwr_qtz.solve(scaledPerrs, dfq_WLS); // this is weighted dq_WLS=Wq*dq
+        // This is weighted dq_WLS=Wq*dq, using the weights that went into
+        // the iteration matrix.
+        if (isNewMatrix) Pq.qtz.solve(scaledPerrs, dfq_WLS);
+        else Pq.qtz.solve(Vector(pErrs.rowScale(Pq.rowScale)), dfq_WLS);
         lastChangeMadeWRMS = dfq_WLS.normRMS(); // change in weighted norm
 
         // switch back to unweighted dq=Wq^+*dq_WLS
@@ -4291,7 +4829,7 @@ int SimbodyMatterSubsystemRep::projectQ
             multiplyByNInv(s,false,dfq_WLS,du);
         }
         // Here du = du_WLS = N^+ * dq_WLS
-        du.rowScaleInPlace(uAbsScale); // Now du = Wu^-1 * du_WLS.
+        du.rowScaleInPlace(Pq.colScale); // Now du = Wu^-1 * du_WLS.
         multiplyByN(s,false,du,dq);     // dq = N*du
 
         // This causes quaternions to become unnormalized, but it doesn't
@@ -4308,8 +4846,21 @@ int SimbodyMatterSubsystemRep::projectQ
                                       : scaledPerrs.normRMS();
         ++nItsUsed;
 
-        if (localOnly && nItsUsed >= 2 
-            && perrNormAchieved > prevPerrNormAchieved) {
+        if (!isNewMatrix
+            && perrNormAchieved > MaxRateWithOldMatrix*prevPerrNormAchieved)
+        {
+            // The old matrix isn't good enough here. Undo the change if it
+            // made things worse, then go around again with a new matrix.
+            if (perrNormAchieved > prevPerrNormAchieved) {
+                updQ(s) += dq;
+                realizeSubsystemPosition(s); // pErrs changes here
+                scaledPerrs = pErrs.rowScale(perrWeights);
+                perrNormAchieved = useNormInf ? scaledPerrs.normInf()
+                                              : scaledPerrs.normRMS();
+            }
+            Pq.invalidate();
+        } else if (localOnly && nItsUsed >= 2 
+                   && perrNormAchieved > prevPerrNormAchieved) {
             // perr norm got worse; restore to end of previous iteration
             updQ(s) += dq;
             realizeSubsystemPosition(s); // pErrs changes here
@@ -4393,18 +4944,18 @@ int SimbodyMatterSubsystemRep::projectQ
             Vector qErrest_0(qErrest);
             zeroKnownQ(s, qErrest_0); // zero out prescribed entries
             multiplyByPq(s, bias_p, qErrest_0, Tp_Pq_qErrest); // (Pq*qErrest)_r
-            Tp_Pq_qErrest.rowScaleInPlace(perrWeights); // now Tp*(Pq*qErrest)_r
-            Pqwr_qtz.solve(Tp_Pq_qErrest, dfq_WLS); // weighted
+            Tp_Pq_qErrest.rowScaleInPlace(Pq.rowScale); // now Tp*(Pq*qErrest)_r
+            Pq.qtz.solve(Tp_Pq_qErrest, dfq_WLS); // weighted
             unpackFreeQ(s, dfq_WLS, udfq_WLS); // zeroes in q_p slots
             multiplyByNInv(s,false,udfq_WLS,du);
         } else {
             multiplyByPq(s, bias_p, qErrest, Tp_Pq_qErrest); // Pq*qErrest
-            Tp_Pq_qErrest.rowScaleInPlace(perrWeights); // now Tp*Pq*qErrest
-            Pqwr_qtz.solve(Tp_Pq_qErrest, dfq_WLS); // weighted
+            Tp_Pq_qErrest.rowScaleInPlace(Pq.rowScale); // now Tp*Pq*qErrest
+            Pq.qtz.solve(Tp_Pq_qErrest, dfq_WLS); // weighted
             multiplyByNInv(s,false,dfq_WLS,du);
         }
         // Here du = du_WLS = N^+ * dq_WLS
-        du.rowScaleInPlace(uAbsScale); // now du = Wu^-1 * du_WLS
+        du.rowScaleInPlace(Pq.colScale); // now du = Wu^-1 * du_WLS
         multiplyByN(s,false,du,dq);     // dq = N*du
         qErrest -= dq; // unweighted
     }
@@ -4454,8 +5005,8 @@ bool SimbodyMatterSubsystemRep::normalizeQuaternions
     Vector& q  = updQ(s); // invalidates q's. TODO: see below.
 
     bool anyChangeMade = false;
-    for (int i=0; i<(int)rbNodeLevels.size(); ++i) 
-        for (int j=0; j<(int)rbNodeLevels[i].size(); ++j) { 
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
             const SBInstancePerMobodInfo& mobodInfo =
                 ic.mobodInstanceInfo[node.getNodeNum()];
@@ -4744,7 +5295,8 @@ int SimbodyMatterSubsystemRep::projectU
     // initialization.
     const bool localOnly = opts.isOptionSet(ProjectOptions::LocalOnly);
     // We are permitted to use an out-of-date Jacobian for projection unless
-    // this is set. TODO: always using modified Newton at the moment.
+    // this is set. Even then we use a matrix from an earlier projection only
+    // in modified Newton mode.
     const bool forceFullNewton =
         opts.isOptionSet(ProjectOptions::ForceFullNewton);
 
@@ -4768,6 +5320,23 @@ int SimbodyMatterSubsystemRep::projectU
     //
     // This is a nonlinear least squares problem, but we only need to factor 
     // once since only the RHS is dependent on u (TODO: see above).
+    //
+    // In modified Newton mode we go further and start with the matrix
+    // saved by an earlier projection of this State, if it still fits. That
+    // matrix was calculated at different q's, so we keep it only as long as 
+    // each iteration reduces the error norm by at least a factor of
+    // 1/MaxRateWithOldMatrix, and otherwise form a new one here. The old
+    // matrix comes with its own weights, including the relative scaling of
+    // the u's in effect when it was formed, and we use those with it.
+    const bool modifiedNewton =
+        useModifiedNewtonProjection && !forceFullNewton;
+    const Real MaxRateWithOldMatrix = Real(0.25);
+
+    // Full Newton doesn't touch the saved matrices or their statistics.
+    SBProjectionMatrixCache* pmc = 
+        modifiedNewton ? &updProjectionMatrixCacheForReuse(s) : 0;
+    SBProjectionMatrixCache::Factored localPV;
+    SBProjectionMatrixCache::Factored& PV = pmc ? pmc->velocity : localPV;
 
     // This will be updated as we go.
     Real pverrNormAchieved = pverrNormOnEntry;
@@ -4798,36 +5367,49 @@ int SimbodyMatterSubsystemRep::projectU
     // if the attempts here make the constraint norm worse.
     const Vector saveU = getU(s);
 
-    Matrix PVwrt(nfu, mHolo+mNonholo);
+    Matrix PVwrt; // nfu X (mHolo+mNonholo), allocated only if needed
     Vector dfu_WLS(nfu);
     Vector du(nu); // unpacked into here if necessary
     if (hasPrescribedMotion)
         du.setToZero(); // must initialize unwritten elements
 
-    calcWeightedPVrTranspose(s, pverrWeights, uRelScale, PVwrt);
-    // PVwrt is now Eu^-1 (Pt Vt) Tpv
-
-    // Calculate pseudoinverse (just once)
-    FactorQTZ PVwr_qtz;
-    PVwr_qtz.factor<Real>(~PVwrt, conditioningTol);
-
-    //printf("projectU m=%d condTol=%g rank=%d rcond=%g\n",
-    //    PVwrt.ncol(), conditioningTol, PVwr_qtz.getRank(),
-    //    PVwr_qtz.getRCondEstimate());
+    // Set if the iteration matrix came from an earlier projection.
+    bool isOldMatrix = PV.isValidFor(nfu, mHolo+mNonholo);
+    if (isOldMatrix)
+        ++pmc->nReuses;
 
     Real prevPVerrNormAchieved = pverrNormAchieved; // watch for divergence
     bool diverged = false;
     const int MaxIterations  = 7;
     do {
-        PVwr_qtz.solve(scaledPVerrs, dfu_WLS);
+        if (!PV.isValidFor(nfu, mHolo+mNonholo)) {
+            calcWeightedPVrTranspose(s, pverrWeights, uRelScale, PVwrt);
+            // PVwrt is now Eu^-1 (Pt Vt) Tpv
+
+            // Calculate pseudoinverse (just once unless an old matrix is
+            // abandoned above).
+            PV.qtz.factor<Real>(~PVwrt, conditioningTol);
+            PV.rowScale = pverrWeights; PV.colScale = uRelScale;
+            PV.nFree = nfu; PV.m = mHolo+mNonholo;
+            if (pmc) ++pmc->nFactorizations;
+
+            //printf("projectU m=%d condTol=%g rank=%d rcond=%g\n",
+            //    PVwrt.ncol(), conditioningTol, PV.qtz.getRank(),
+            //    PV.qtz.getRCondEstimate());
+        }
+
+        // Use the weights that went into the iteration matrix.
+        if (isOldMatrix) 
+            PV.qtz.solve(Vector(pvErrs.rowScale(PV.rowScale)), dfu_WLS);
+        else PV.qtz.solve(scaledPVerrs, dfu_WLS);
         lastChangeMadeWRMS = dfu_WLS.normRMS(); // change in weighted norm
 
         // switch back to unweighted du=Eu^-1*du_WLS
         if (hasPrescribedMotion) {
             unpackFreeU(s, dfu_WLS, du);    // zeroes in u_p slots
-            du.rowScaleInPlace(uRelScale); // du=Eu^-1*unpack(dfu_WLS)
+            du.rowScaleInPlace(PV.colScale); // du=Eu^-1*unpack(dfu_WLS)
         } else {
-            du = dfu_WLS.rowScale(uRelScale); // unscale: du=Eu^-1*du_WLS
+            du = dfu_WLS.rowScale(PV.colScale); // unscale: du=Eu^-1*du_WLS
         }
         updU(s) -= du;
         results.setAnyChangeMade(true);
@@ -4839,8 +5421,22 @@ int SimbodyMatterSubsystemRep::projectU
                                        : scaledPVerrs.normRMS();
         ++nItsUsed;
 
-        if (localOnly && nItsUsed >= 2 
-            && pverrNormAchieved > prevPVerrNormAchieved) {
+        if (isOldMatrix
+            && pverrNormAchieved > MaxRateWithOldMatrix*prevPVerrNormAchieved)
+        {
+            // The old matrix isn't good enough here. Undo the change if it
+            // made things worse, then go around again with a new matrix.
+            if (pverrNormAchieved > prevPVerrNormAchieved) {
+                updU(s) += du;
+                realizeSubsystemVelocity(s); // pvErrs changes here
+                scaledPVerrs = pvErrs.rowScale(pverrWeights);
+                pverrNormAchieved = useNormInf ? scaledPVerrs.normInf()
+                                               : scaledPVerrs.normRMS();
+            }
+            PV.invalidate();
+            isOldMatrix = false;
+        } else if (localOnly && nItsUsed >= 2 
+                   && pverrNormAchieved > prevPVerrNormAchieved) {
             // Velocity norm worse -- restore to end of previous iteration.
             updU(s) += du;
             realizeSubsystemVelocity(s); // pvErrs changes here
@@ -4920,15 +5516,15 @@ int SimbodyMatterSubsystemRep::projectU
             zeroKnownU(s, uErrest_0); // zero out prescribed entries
             multiplyByPVA(s,true,true,false,bias_pv,
                             uErrest_0,Tpv_PV_uErrest);
-            Tpv_PV_uErrest.rowScaleInPlace(pverrWeights); // = Tpv*PV*uErrest_0
-            PVwr_qtz.solve(Tpv_PV_uErrest, dfu_WLS);
+            Tpv_PV_uErrest.rowScaleInPlace(PV.rowScale); // = Tpv*PV*uErrest_0
+            PV.qtz.solve(Tpv_PV_uErrest, dfu_WLS);
             unpackFreeU(s, dfu_WLS, du); // still weighted
         } else {
             multiplyByPVA(s,true,true,false,bias_pv,uErrest,Tpv_PV_uErrest);
-            Tpv_PV_uErrest.rowScaleInPlace(pverrWeights); // = Tpv PV uErrEst
-            PVwr_qtz.solve(Tpv_PV_uErrest, du);
+            Tpv_PV_uErrest.rowScaleInPlace(PV.rowScale); // = Tpv PV uErrEst
+            PV.qtz.solve(Tpv_PV_uErrest, du);
         }
-        du.rowScaleInPlace(uRelScale); // now du=Eu^-1*unpack(dfu_WLS)
+        du.rowScaleInPlace(PV.colScale); // now du=Eu^-1*unpack(dfu_WLS)
         uErrest -= du; // this is unweighted now
     }
    
@@ -5107,32 +5703,38 @@ void SimbodyMatterSubsystemRep::calcLoopForwardDynamicsOperator
     if (m==0) return;
     if (nu==0) {multipliers.setToZero(); return;}
 
-    // Conditioning tolerance. This determines when we'll drop a 
-    // constraint. 
-    // TODO: this is probably too tight; should depend on constraint tolerance
-    // and should be consistent with position and velocity projection ranks.
-    // Tricky here because conditioning depends on mass matrix as well as
-    // constraints.
-    const Real conditioningTol = m 
-        //* SignificantReal;
-        * SqrtEps*std::sqrt(SqrtEps); // Eps^(3/4)
-
-    // Calculate multipliers lambda as
-    //     (G M^-1 ~G) lambda = aerr
-    // The method here calculates the mXm matrix G*M^-1*G^T as fast as 
-    // I know how to do, O(m*n) with O(n) temporary memory, using a series
-    // of O(n) operators. Then we'll factor it here in O(m^3) time. 
-    Matrix GMInvGt(m,m);
-    calcGMInvGt(s, GMInvGt);
+    // If requested, exploit the block structure of G M^-1 ~G when the
+    // constraints act on independent subtrees; see solveGMInvGtByBlocks().
+    if (useSparseConstraintSolver) {
+        solveGMInvGtByBlocks(s, udotErr, multipliers);
+    } else {
+        // Conditioning tolerance. This determines when we'll drop a 
+        // constraint. 
+        // TODO: this is probably too tight; should depend on constraint 
+        // tolerance and should be consistent with position and velocity
+        // projection ranks. Tricky here because conditioning depends on mass
+        // matrix as well as constraints.
+        const Real conditioningTol = m 
+            //* SignificantReal;
+            * SqrtEps*std::sqrt(SqrtEps); // Eps^(3/4)
+
+        // Calculate multipliers lambda as
+        //     (G M^-1 ~G) lambda = aerr
+        // The method here calculates the mXm matrix G*M^-1*G^T as fast as 
+        // I know how to do, O(m*n) with O(n) temporary memory, using a series
+        // of O(n) operators. Then we'll factor it here in O(m^3) time. 
+        Matrix GMInvGt(m,m);
+        calcGMInvGt(s, GMInvGt);
     
-    // specify 1/cond at which we declare rank deficiency
-    FactorQTZ qtz(GMInvGt, conditioningTol); 
+        // specify 1/cond at which we declare rank deficiency
+        FactorQTZ qtz(GMInvGt, conditioningTol); 
 
-    //printf("fwdDynamics: m=%d condTol=%g rank=%d rcond=%g\n",
-    //    GMInvGt.nrow(), conditioningTol, qtz.getRank(),
-    //    qtz.getRCondEstimate());
+        //printf("fwdDynamics: m=%d condTol=%g rank=%d rcond=%g\n",
+        //    GMInvGt.nrow(), conditioningTol, qtz.getRank(),
+        //    qtz.getRCondEstimate());
 
-    qtz.solve(udotErr, multipliers);
+        qtz.solve(udotErr, multipliers);
+    }
 
     // We have the multipliers, now turn them into forces.
 
@@ -5199,8 +5801,8 @@ void SimbodyMatterSubsystemRep::calcCompositeBodyInertias(const State& s,
     const SBTreePositionCache& tpc = getTreePositionCache(s);
     R.resize(getNumBodies());
 
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; i--) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++)
+    for (int i=(int)rbNodeLevels.size()-1 ; i>=0 ; --i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->calcCompositeBodyInertiasInward(tpc,R);
 }
 //....................... CALC COMPOSITE BODY INERTIAS .........................
@@ -5220,8 +5822,8 @@ void SimbodyMatterSubsystemRep::realizeY(const State& s) const {
     const SBArticulatedBodyInertiaCache&  abc = getArticulatedBodyInertiaCache(s);
     SBDynamicsCache&                      dc  = updDynamicsCache(s);
 
-    for (int i=0; i < (int)rbNodeLevels.size(); i++)
-        for (int j=0; j < (int)rbNodeLevels[i].size(); j++)
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             rbNodeLevels[i][j]->realizeYOutward(ic,tpc,abc,dc);
 }
 //.................................. REALIZE Y .................................
@@ -5238,8 +5840,8 @@ Real SimbodyMatterSubsystemRep::calcKineticEnergy(const State& s) const {
     Real ke = 0;
 
     // Skip ground level 0!
-    for (int i=1 ; i<(int)rbNodeLevels.size() ; i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++)
+    for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j)
             ke += rbNodeLevels[i][j]->calcKineticEnergy(tpc,tvc);
 
     return ke;
@@ -5324,22 +5926,18 @@ void SimbodyMatterSubsystemRep::calcTreeAccelerations(const State& s,
     for (int i=0; i < (int)ic.zeroUDot.size(); ++i)
         udotPtr[ic.zeroUDot[i]] = 0;
 
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; i--) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
-            const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.calcUDotPass1Inward(ic,tpc,abc,abvc,
-                mobilityForcePtr, bodyForcePtr, udotPtr, zPtr, zPlusPtr,
-                hingeForcePtr);
-        }
+    sweepInward([&](const RigidBodyNode& node) {
+        node.calcUDotPass1Inward(ic,tpc,abc,abvc,
+            mobilityForcePtr, bodyForcePtr, udotPtr, zPtr, zPlusPtr,
+            hingeForcePtr);
+    });
 
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
-            const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.calcUDotPass2Outward(ic,tpc,abc,tvc,dc, 
-                hingeForcePtr, aPtr, udotPtr, tauPtr);
-            node.calcQDotDot(sbs, &udotPtr[node.getUIndex()], 
-                             &qdotdotPtr[node.getQIndex()]);
-        }
+    sweepOutward([&](const RigidBodyNode& node) {
+        node.calcUDotPass2Outward(ic,tpc,abc,tvc,dc, 
+            hingeForcePtr, aPtr, udotPtr, tauPtr);
+        node.calcQDotDot(sbs, &udotPtr[node.getUIndex()], 
+                         &qdotdotPtr[node.getQIndex()]);
+    });
 }
 //......................... CALC TREE ACCELERATIONS ............................
 
@@ -5358,15 +5956,7 @@ void SimbodyMatterSubsystemRep::multiplyByMInv(const State& s,
     const Vector&                                           f,
     Vector&                                                 MInvf) const 
 {
-    const SBInstanceCache&                  ic  = getInstanceCache(s);
-    const SBTreePositionCache&              tpc = getTreePositionCache(s);
-
-    realizeArticulatedBodyInertias(s); // (may already have been realized)
-    const SBArticulatedBodyInertiaCache&    abc = getArticulatedBodyInertiaCache(s);
-
-    const int nb = getNumBodies();
     const int nu = getNU(s);
-
     assert(f.size() == nu);
 
     MInvf.resize(nu);
@@ -5376,32 +5966,101 @@ void SimbodyMatterSubsystemRep::multiplyByMInv(const State& s,
     assert(f.hasContiguousData());
     assert(MInvf.hasContiguousData());
 
-    // Temporaries
-    Array_<Real>        eps(nu);
-    Array_<SpatialVec>  z(nb), zPlus(nb), A_GB(nb);
+    multiplyByMInv(s, 1, &f[0], &MInvf[0]);
+}
+
+// This is the multiple right-hand side version. The tree is swept only once;
+// each node processes all the columns while its own articulated body inertia
+// and joint data are hot in the cache. Input and output are ncol columns of
+// nu contiguous entries each.
+void SimbodyMatterSubsystemRep::multiplyByMInv(const State& s, int ncol,
+    const Real*                                             f,
+    Real*                                                   MInvf) const 
+{
+    realizeArticulatedBodyInertias(s); // (may already have been realized)
+    const SBArticulatedBodyInertiaCache&    abc = getArticulatedBodyInertiaCache(s);
 
-    // Point to raw data of input arguments.
-    const Real* fPtr     = &f[0];       
-    Real*       MInvfPtr = &MInvf[0];
+    multiplyByMInvWithABIs(s, abc, ncol, f, MInvf);
+}
 
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; i--) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
-            const RigidBodyNode& node = *rbNodeLevels[i][j];
+// Calculate udot = M^-1 f for ncol right-hand sides using the given
+// articulated body inertias.
+void SimbodyMatterSubsystemRep::multiplyByMInvWithABIs(const State& s,
+    const SBArticulatedBodyInertiaCache&                    abc,
+    int                                                     ncol,
+    const Real*                                             f,
+    Real*                                                   MInvf) const 
+{
+    const SBInstanceCache&                  ic  = getInstanceCache(s);
+    const SBTreePositionCache&              tpc = getTreePositionCache(s);
+
+    const int nb = getNumBodies();
+    const int nu = getNU(s);
+    if (nu==0 || ncol==0)
+        return;
+
+    // Temporaries, one column per right-hand side.
+    Array_<Real>        eps(nu*ncol);
+    Array_<SpatialVec>  z(nb*ncol), zPlus(nb*ncol), A_GB(nb*ncol);
+
+    sweepInward([&](const RigidBodyNode& node) {
+        for (int j=0; j < ncol; ++j)
             node.multiplyByMInvPass1Inward(ic,tpc,abc,
-                fPtr, z.begin(), zPlus.begin(), eps.begin());
-        }
+                f + j*nu, &z[j*nb], &zPlus[j*nb], &eps[j*nu]);
+    });
 
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
-            const RigidBodyNode& node = *rbNodeLevels[i][j];
+    sweepOutward([&](const RigidBodyNode& node) {
+        for (int j=0; j < ncol; ++j)
             node.multiplyByMInvPass2Outward(ic,tpc,abc, 
-                eps.cbegin(), A_GB.begin(), MInvfPtr);
-        }
+                &eps[j*nu], &A_GB[j*nb], MInvf + j*nu);
+    });
 }
 //............................. CALC M INVERSE F ...............................
 
 
 
+//==============================================================================
+//                          MULTIPLY BY (M+D) INV
+//==============================================================================
+// Calculate x = (M+D)^-1 f where D is diagonal. Adding D to the mass matrix
+// just adds it to the diagonal of each mobilizer's hinge inertia in the 
+// articulated body recursion, so we compute a private set of articulated
+// body inertias that way and then use the ordinary M^-1 sweeps.
+void SimbodyMatterSubsystemRep::multiplyByMPlusDInv(const State& s,
+    const Vector&                                               d,
+    const Vector&                                               f,
+    Vector&                                                     x) const 
+{
+    const int nu = getNU(s);
+    assert(d.size() == nu && f.size() == nu);
+
+    x.resize(nu);
+    if (nu==0)
+        return;
+
+    assert(d.hasContiguousData() && f.hasContiguousData());
+    assert(x.hasContiguousData());
+
+    SimTK_ERRCHK_ALWAYS(isPositionKinematicsRealized(s), 
+    "SimbodyMatterSubsystem::multiplyByMPlusDInv()",
+    "Articulated body inertias cannot be calculated unless the state has been "
+    "realized to Stage::Position.");
+
+    const SBInstanceCache&      ic  = getInstanceCache(s);
+    const SBTreePositionCache&  tpc = getTreePositionCache(s);
+
+    SBArticulatedBodyInertiaCache abc;
+    abc.allocate(topologyCache, getModelCache(s), ic);
+    sweepInward([&](const RigidBodyNode& node) {
+        node.realizeArticulatedBodyInertiasInward(ic,tpc,&d[0],abc);
+    });
+
+    multiplyByMInvWithABIs(s, abc, 1, &f[0], &x[0]);
+}
+//.......................... MULTIPLY BY (M+D) INV .............................
+
+
+
 //==============================================================================
 //                              MULTIPLY BY M
 //==============================================================================
@@ -5412,9 +6071,6 @@ void SimbodyMatterSubsystemRep::multiplyByM(const State&    s,
                                             const Vector&   a,
                                             Vector&         Ma) const 
 {
-
-    const SBTreePositionCache& tpc = getTreePositionCache(s);
-    const int nb = getNumBodies();
     const int nu = getNU(s);
 
     assert(a.size() == nu);
@@ -5426,28 +6082,74 @@ void SimbodyMatterSubsystemRep::multiplyByM(const State&    s,
     assert(a.hasContiguousData());
     assert(Ma.hasContiguousData());
 
-    // Temporaries
-    Array_<SpatialVec>  fTmp(nb), A_GB(nb);
+    multiplyByM(s, 1, &a[0], &Ma[0]);
+}
 
-    // Point to raw data of input arguments.
-    const Real* aPtr    = &a[0];       
-    Real*       MaPtr   = &Ma[0];
+// Multiple right-hand side version: one outward and one inward sweep for all 
+// ncol columns. Input and output are ncol columns of nu contiguous entries.
+void SimbodyMatterSubsystemRep::multiplyByM(const State&    s,
+                                            int             ncol,
+                                            const Real*     a,
+                                            Real*           Ma) const 
+{
+    const SBTreePositionCache& tpc = getTreePositionCache(s);
+    const int nb = getNumBodies();
+    const int nu = getNU(s);
+
+    if (nu == 0 || ncol == 0)
+        return;
 
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    // Temporaries, one column per right-hand side.
+    Array_<SpatialVec>  fTmp(nb*ncol), A_GB(nb*ncol);
+
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.multiplyByMPass1Outward(tpc, aPtr, A_GB.begin());
+            for (int c=0; c < ncol; ++c)
+                node.multiplyByMPass1Outward(tpc, a + c*nu, &A_GB[c*nb]);
         }
 
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; i--) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=(int)rbNodeLevels.size()-1 ; i>=0 ; --i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.multiplyByMPass2Inward(tpc,A_GB.cbegin(),fTmp.begin(),MaPtr);
+            for (int c=0; c < ncol; ++c)
+                node.multiplyByMPass2Inward(tpc, &A_GB[c*nb], &fTmp[c*nb],
+                                            Ma + c*nu);
         }
 }
 
 
 
+namespace {
+// Fill in the n X n matrix "result" a block of columns at a time by applying
+// a multiple right-hand side operator op(ncol, in, out) to the corresponding
+// columns of the identity matrix. Using blocks rather than all n columns at
+// once keeps the temporary storage bounded for large systems. Any output 
+// entries not written by the operator are zero.
+template <class MultiColumnOp>
+void calcByIdentityColumnBlocks(int n, Matrix& result, 
+                                const MultiColumnOp& op) {
+    const int BlockSize = 32;
+    const int maxCol = std::min(n, BlockSize);
+    Array_<Real> in(n*maxCol, Real(0)), out(n*maxCol);
+
+    for (int j0=0; j0 < n; j0 += BlockSize) {
+        const int ncol = std::min(BlockSize, n-j0);
+        for (int j=0; j < ncol; ++j) 
+            in[j*n + j0+j] = 1;
+        out.fill(Real(0));
+
+        op(ncol, in.cbegin(), out.begin());
+
+        for (int j=0; j < ncol; ++j) {
+            in[j*n + j0+j] = 0;
+            for (int i=0; i < n; ++i)
+                result(i, j0+j) = out[j*n + i];
+        }
+    }
+}
+}
+
 //==============================================================================
 //                                  CALC M
 //==============================================================================
@@ -5459,25 +6161,13 @@ void SimbodyMatterSubsystemRep::calcM(const State& s, Matrix& M) const {
     M.resize(nu,nu);
     if (nu==0) return;
 
-    // This could be calculated much faster by doing it directly and calculating
-    // only half of it. As a placeholder, however, we're doing this with 
-    // repeated O(n) calls to multiplyByM() to get M one column at a time.
-
-    // If M's columns are contiguous we can avoid copying.
-    const bool isContiguous = M(0).hasContiguousData();
-    Vector contig_col(isContiguous ? 0 : nu);
-
-    Vector v(nu); v.setToZero();
-    for (int i=0; i < nu; ++i) {
-        v[i] = 1;
-        if (isContiguous) {
-            multiplyByM(s, v, M(i));
-        } else {
-            multiplyByM(s, v, contig_col);
-            M(i) = contig_col;
-        }
-        v[i] = 0;
-    }
+    // This could be calculated faster by doing it directly and calculating
+    // only half of it. As a placeholder, however, we're doing this with the
+    // O(n) multiplyByM() operator applied to blocks of identity columns, so 
+    // that we get a whole block of M's columns for each tree sweep.
+    calcByIdentityColumnBlocks(nu, M, 
+        [&](int ncol, const Real* in, Real* out) 
+        {   multiplyByM(s, ncol, in, out); });
 }
 
 
@@ -5494,28 +6184,190 @@ void SimbodyMatterSubsystemRep::calcMInv(const State& s, Matrix& MInv) const {
     if (nu==0) return;
 
     // This could probably be calculated faster by doing it directly and
-    // filling in only half. For now we're doing it with repeated calls to
-    // the O(n) operator multiplyByMInv().
+    // filling in only half. For now we're doing it by applying the O(n) 
+    // operator multiplyByMInv() to blocks of identity columns.
+    calcByIdentityColumnBlocks(nu, MInv, 
+        [&](int ncol, const Real* in, Real* out) 
+        {   multiplyByMInv(s, ncol, in, out); });
+}
 
-    // If M's columns are contiguous we can avoid copying.
-    const bool isContiguous = MInv(0).hasContiguousData();
-    Vector contig_col(isContiguous ? 0 : nu);
 
-    Vector f(nu); f.setToZero();
-    for (int i=0; i < nu; ++i) {
-        f[i] = 1;
-        if (isContiguous) {
-            multiplyByMInv(s, f, MInv(i));
-        } else {
-            multiplyByMInv(s, f, contig_col);
-            MInv(i) = contig_col;
+
+//==============================================================================
+//                          CALC M FACTORIZATION
+//==============================================================================
+// Calculate the branch-induced sparse factorization M = ~L*D*L (Featherstone
+// 2005, "Efficient factorization of the joint-space inertia matrix for 
+// branched kinematic trees"). Only the elements of M in the branch-induced
+// pattern are generated, using the composite rigid body method, and the 
+// factorization of that pattern produces no fill-in. For a tree whose 
+// deepest path has d mobilities this is O(n*d) to form and O(n*d^2) to 
+// factor, rather than O(n^2) and O(n^3) for the dense equivalent. The result
+// is packed as described for mFactorStart.
+// This Subsystem must already have been realized to Position stage.
+void SimbodyMatterSubsystemRep::
+calcMFactorization(const State& s, Array_<Real>& LD) const {
+    const SBTreePositionCache& tpc = getTreePositionCache(s);
+    const Array_<SpatialInertia,MobilizedBodyIndex>& R = 
+        getCompositeBodyInertias(s);
+    const int nu = getTotalDOF();
+    LD.resize(mFactorStart[nu]);
+
+    // For each mobility, the spatial force R*H(:,c) that it needs to 
+    // accelerate its composite body is projected onto its own mobilizer's 
+    // mobilities, then shifted inward one body at a time and projected onto
+    // the ancestors' mobilities. That fills in row u of M in the same order
+    // as the packed factor, diagonal first.
+    for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
+            const RigidBodyNode& node = *rbNodeLevels[i][j];
+            const SpatialInertia& Rk = R[node.getNodeNum()];
+            for (int c=0; c < node.getDOF(); ++c) {
+                Real* row = &LD[mFactorStart[node.getUIndex() + c]];
+                SpatialVec F = Rk * node.getHCol(tpc, c);
+                for (int cc=c; cc >= 0; --cc)
+                    row[c-cc] = ~node.getHCol(tpc, cc) * F;
+
+                int p = c+1; // next ancestor entry in this row
+                for (const RigidBodyNode* body = &node; body->getLevel() > 1;) {
+                    const RigidBodyNode& parent = *body->getParent();
+                    F = body->getPhi(tpc) * F;
+                    for (int cc=parent.getDOF()-1; cc >= 0; --cc, ++p)
+                        row[p] = ~parent.getHCol(tpc, cc) * F;
+                    body = &parent;
+                }
+                assert(p == mFactorStart[node.getUIndex()+c+1] 
+                            - mFactorStart[node.getUIndex()+c]);
+            }
+        }
+
+    // Factor in place from tip to base. When row k is reached, all of its
+    // descendants have been folded into it so its diagonal is final.
+    for (int k=nu-1; k >= 0; --k) {
+        Real* rowk = &LD[mFactorStart[k]];
+        SimTK_ERRCHK1_ALWAYS(rowk[0] > 0, 
+            "SimbodyMatterSubsystem::realizeMFactorization()",
+            "The mass matrix is not positive definite; the pivot for mobility"
+            " %d is not positive. Check for massless bodies.", k);
+        int p = 1;
+        for (int i=uParent[k]; i >= 0; i=uParent[i], ++p) {
+            const Real a = rowk[p] / rowk[0];
+            Real* rowi = &LD[mFactorStart[i]];
+            // Row i holds i and its ancestors, which are exactly the 
+            // ancestors of k beyond distance p.
+            for (int r=0; r <= uDepth[i]; ++r)
+                rowi[r] -= a*rowk[p+r];
+            rowk[p] = a;
         }
-        f[i] = 0;
     }
 }
 
 
 
+//==============================================================================
+//                        SOLVE WITH M FACTORIZATION
+//==============================================================================
+// Solve M*x = f as x = L^-1 * D^-1 * L^-T * f in O(n*d) time.
+void SimbodyMatterSubsystemRep::
+solveWithMFactorization(const State& s, const Vector& f, Vector& x) const {
+    const int nu = getTotalDOF();
+    SimTK_ERRCHK2_ALWAYS(f.size() == nu,
+        "SimbodyMatterSubsystem::solveWithMFactorization()",
+        "The right-hand side had length %d but there are %d mobilities.",
+        f.size(), nu);
+
+    realizeMFactorization(s);
+    const Array_<Real>& LD = getMassMatrixFactorCache(s).LD;
+
+    x = f;
+    for (int i=nu-1; i >= 0; --i) {         // x = L^-T x
+        const Real* row = &LD[mFactorStart[i]];
+        const Real  xi  = x[i];
+        int p = 1;
+        for (int j=uParent[i]; j >= 0; j=uParent[j], ++p)
+            x[j] -= row[p]*xi;
+    }
+    for (int i=0; i < nu; ++i)              // x = D^-1 x
+        x[i] /= LD[mFactorStart[i]];
+    for (int i=0; i < nu; ++i) {            // x = L^-1 x
+        const Real* row = &LD[mFactorStart[i]];
+        Real xi = x[i];
+        int p = 1;
+        for (int j=uParent[i]; j >= 0; j=uParent[j], ++p)
+            xi -= row[p]*x[j];
+        x[i] = xi;
+    }
+}
+
+
+
+//==============================================================================
+//                          CALC MInv SUBMATRIX
+//==============================================================================
+// M^-1 = L^-1 D^-1 L^-T, so M^-1(a,b) = ~y_a * D^-1 * y_b where y_u = L^-T e_u.
+// y_u is nonzero only for u and its ancestors, so each y_u costs O(d^2) and
+// each element of the submatrix costs O(d).
+void SimbodyMatterSubsystemRep::
+calcMInvSubmatrix(const State& s, const Array_<UIndex>& us, 
+                  Matrix& MInvSub) const {
+    const int nu = getTotalDOF();
+    const int m  = (int)us.size();
+    for (int b=0; b < m; ++b)
+        SimTK_ERRCHK2_ALWAYS(0 <= us[b] && us[b] < nu,
+            "SimbodyMatterSubsystem::calcMInvSubmatrix()",
+            "Mobility index %d is out of range; there are %d mobilities.",
+            (int)us[b], nu);
+
+    MInvSub.resize(m,m);
+    if (m == 0) return;
+
+    realizeMFactorization(s);
+    const Array_<Real>& LD = getMassMatrixFactorCache(s).LD;
+
+    // path[yStart[b]+t] is the ancestor of us[b] at distance t and y holds the
+    // corresponding element of y_us[b].
+    Array_<int> yStart(m+1);
+    yStart[0] = 0;
+    for (int b=0; b < m; ++b)
+        yStart[b+1] = yStart[b] + uDepth[us[b]] + 1;
+    Array_<int>  path(yStart[m]);
+    Array_<Real> y(yStart[m], Real(0));
+
+    for (int b=0; b < m; ++b) {
+        int*  pb  = &path[yStart[b]];
+        Real* yb  = &y[yStart[b]];
+        const int len = yStart[b+1] - yStart[b];
+        int t = 0;
+        for (int j=us[b]; j >= 0; j=uParent[j])
+            pb[t++] = j;
+        yb[0] = 1;
+        for (t=0; t < len; ++t) {
+            const Real* row = &LD[mFactorStart[pb[t]]];
+            for (int p=1; t+p < len; ++p)
+                yb[t+p] -= row[p]*yb[t];
+        }
+    }
+
+    for (int a=0; a < m; ++a)
+        for (int b=a; b < m; ++b) {
+            // The paths are in decreasing mobility order and share a common
+            // tail from the nearest common ancestor to the base.
+            const int alen = yStart[a+1]-yStart[a], blen = yStart[b+1]-yStart[b];
+            const int*  pa = &path[yStart[a]]; const int*  pb = &path[yStart[b]];
+            const Real* ya = &y[yStart[a]];    const Real* yb = &y[yStart[b]];
+            Real sum = 0;
+            for (int ta=0, tb=0; ta < alen && tb < blen;) {
+                if      (pa[ta] > pb[tb]) ++ta;
+                else if (pa[ta] < pb[tb]) ++tb;
+                else { sum += ya[ta]*yb[tb] / LD[mFactorStart[pa[ta]]]; 
+                       ++ta; ++tb; }
+            }
+            MInvSub(a,b) = MInvSub(b,a) = sum;
+        }
+}
+
+
+
 //==============================================================================
 //                          CALC TREE RESIDUAL FORCES
 //==============================================================================
@@ -5598,15 +6450,15 @@ void SimbodyMatterSubsystemRep::calcTreeResidualForces(const State& s,
                         ? &residualMobilityForces[0] : NULL;
     SpatialVec* tempPtr = allFTmp.size() ? &allFTmp[0] : NULL;
 
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
             node.calcBodyAccelerationsFromUdotOutward
                (tpc,tvc,knownUdotPtr,aPtr);
         }
 
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; i--) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=(int)rbNodeLevels.size()-1 ; i>=0 ; --i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
             node.calcInverseDynamicsPass2Inward(
                 tpc,tvc,aPtr,
@@ -5639,8 +6491,8 @@ void SimbodyMatterSubsystemRep::multiplyByN
     Real*           outp = out.size() ? &out[0] : 0;
 
     // Skip ground; it doesn't have qdots!
-    for (int i=1; i<(int)rbNodeLevels.size(); i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& rbn = *rbNodeLevels[i][j];
             const int maxNQ = rbn.getMaxNQ();
 
@@ -5686,8 +6538,8 @@ void SimbodyMatterSubsystemRep::multiplyByNDot
     Real*           outp = out.size() ? &out[0] : 0;
 
     // Skip ground; it doesn't have q's or u's!
-    for (int i=1; i<(int)rbNodeLevels.size(); i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& rbn = *rbNodeLevels[i][j];
             const int maxNQ = rbn.getMaxNQ();
 
@@ -5733,8 +6585,8 @@ void SimbodyMatterSubsystemRep::multiplyByNInv
     Real*           outp = out.size() ? &out[0] : 0;
 
     // Skip ground; it doesn't have qdots!
-    for (int i=1; i<(int)rbNodeLevels.size(); i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& rbn = *rbNodeLevels[i][j];
             const int maxNQ = rbn.getMaxNQ();
 
@@ -6127,10 +6979,11 @@ void SimbodyMatterSubsystemRep::calcQDot
     Real*       qdotPtr = qdot.size() ? &qdot[0] : NULL;
 
     // Skip ground; it doesn't have qdots!
-    for (int i=1; i<(int)rbNodeLevels.size(); i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.calcQDot(sbs, &uPtr[node.getUIndex()], &qdotPtr[node.getQIndex()]);
+            node.calcQDot(sbs, &uPtr[node.getUIndex()], 
+                          &qdotPtr[node.getQIndex()]);
         }
 }
 //............................... CALC QDOT ....................................
@@ -6157,8 +7010,8 @@ void SimbodyMatterSubsystemRep::calcQDotDot
     Real*       qdotdotPtr = qdotdot.size() ? &qdotdot[0] : NULL;
 
     // Skip ground; it doesn't have qdots!
-    for (int i=1; i<(int)rbNodeLevels.size(); i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=1 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
             node.calcQDotDot(sbs, &udotPtr[node.getUIndex()], 
                              &qdotdotPtr[node.getQIndex()]);
@@ -6299,15 +7152,25 @@ void SimbodyMatterSubsystemRep::multiplyBySystemJacobian(const State& s,
     assert(v.size() == getNU(s));
     assert(v.hasContiguousData() && Jv.hasContiguousData());
 
-    const SBTreePositionCache& tpc = getTreePositionCache(s);
+    multiplyBySystemJacobian(s, 1, v.size() ? &v[0] : NULL, &Jv[0]);
+}
 
-    const Real* vPtr = v.size() ? &v[0] : NULL;
-    SpatialVec* jvPtr = Jv.size() ? &Jv[0] : NULL;
+// Multiple right-hand side version. Input is ncol columns of nu contiguous 
+// entries; output is ncol columns of nb contiguous SpatialVecs.
+void SimbodyMatterSubsystemRep::multiplyBySystemJacobian(const State& s,
+    int                        ncol,
+    const Real*                v,
+    SpatialVec*                Jv) const 
+{
+    const SBTreePositionCache& tpc = getTreePositionCache(s);
+    const int nb = getNumBodies();
+    const int nu = getNU(s);
 
-    for (int i=0 ; i<(int)rbNodeLevels.size() ; i++)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=0 ; i<(int)rbNodeLevels.size() ; ++i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.multiplyBySystemJacobian(tpc, vPtr, jvPtr);
+            for (int c=0; c < ncol; ++c)
+                node.multiplyBySystemJacobian(tpc, v + c*nu, Jv + c*nb);
         }
 }
 //......................... MULTIPLY BY SYSTEM JACOBIAN ........................
@@ -6333,17 +7196,30 @@ void SimbodyMatterSubsystemRep::multiplyBySystemJacobianTranspose
 
     assert(X.hasContiguousData() && JtX.hasContiguousData());
 
+    multiplyBySystemJacobianTranspose(s, 1, &X[0], 
+                                      JtX.size() ? &JtX[0] : NULL);
+}
+
+// Multiple right-hand side version. Input is ncol columns of nb contiguous
+// SpatialVecs; output is ncol columns of nu contiguous entries.
+void SimbodyMatterSubsystemRep::multiplyBySystemJacobianTranspose
+   (const State&                s, 
+    int                         ncol,
+    const SpatialVec*           X,
+    Real*                       JtX) const
+{
     const SBTreePositionCache& tpc = getTreePositionCache(s);
+    const int nb = getNumBodies();
+    const int nu = getNU(s);
 
-    Vector_<SpatialVec> zTemp(getNumBodies()); zTemp.setToZero();
-    const SpatialVec* xPtr = X.size() ? &X[0] : NULL;
-    Real* jtxPtr = JtX.size() ? &JtX[0] : NULL;
-    SpatialVec* zPtr = zTemp.size() ? &zTemp[0] : NULL;
+    Array_<SpatialVec> zTemp(nb*ncol, SpatialVec(Vec3(0),Vec3(0)));
 
-    for (int i=rbNodeLevels.size()-1 ; i>=0 ; i--)
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=(int)rbNodeLevels.size()-1 ; i>=0 ; --i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.multiplyBySystemJacobianTranspose(tpc, zPtr, xPtr, jtxPtr);
+            for (int c=0; c < ncol; ++c)
+                node.multiplyBySystemJacobianTranspose(tpc, &zTemp[c*nb], 
+                                                       X + c*nb, JtX + c*nu);
         }
 }
 //................... MULTIPLY BY SYSTEM JACOBIAN TRANSPOSE ....................
@@ -6377,8 +7253,8 @@ void SimbodyMatterSubsystemRep::calcTreeEquivalentMobilityForces(const State& s,
     SpatialVec* zPtr = allZ.size() ? &allZ[0] : NULL;
 
     // Don't do ground's level since ground has no inboard joint.
-    for (int i=rbNodeLevels.size()-1 ; i>0 ; i--) 
-        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
+    for (int i=(int)rbNodeLevels.size()-1 ; i>=1 ; --i)
+        for (int j=0 ; j<(int)rbNodeLevels[i].size() ; ++j) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
             node.calcEquivalentJointForces(tpc,tvc,
                 bodyForcePtr, zPtr,
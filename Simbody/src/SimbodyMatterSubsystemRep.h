@@ -38,6 +38,8 @@
 
 #include <set>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <utility> // std::pair
 using std::pair;
 
@@ -141,7 +143,12 @@ private:
 class SimbodyMatterSubsystemRep : public SimTK::Subsystem::Guts {
 public:
     SimbodyMatterSubsystemRep() 
-      : Subsystem::Guts("SimbodyMatterSubsystem", "0.7.1")
+      : Subsystem::Guts("SimbodyMatterSubsystem", "0.7.1"),
+        numThreadsRequested(1),
+        minBodiesPerThread(DefaultMinBodiesPerThread),
+        useIncrementalPositionKinematics(false),
+        useSparseConstraintSolver(false),
+        useModifiedNewtonProjection(false)
     { 
         clearTopologyCache();
     }
@@ -509,6 +516,10 @@ public:
     // realized at Stage::Acceleration.
     void realizeArticulatedBodyInertias(const State&) const;
 
+    // Call at Instance + PositionKinematics Stage or later. Never realized
+    // automatically, but realized on first use by the operators that need it.
+    void realizeMFactorization(const State&) const;
+
     // Call at Instance + VelocityKinematics + ArticulatedBodyInertias;
     // automatically realized at Stage::Acceleration.
     void realizeArticulatedBodyVelocity(const State&) const;
@@ -518,6 +529,7 @@ public:
     bool isCompositeBodyInertiasRealized(const State&) const;
     bool isArticulatedBodyInertiasRealized(const State&) const;
     bool isArticulatedBodyVelocityRealized(const State&) const;
+    bool isMFactorizationRealized(const State&) const;
 
     // These are just used in timing tests.
     void invalidatePositionKinematics(const State&) const;
@@ -525,6 +537,7 @@ public:
     void invalidateCompositeBodyInertias(const State&) const;
     void invalidateArticulatedBodyInertias(const State&) const;
     void invalidateArticulatedBodyVelocity(const State&) const;
+    void invalidateMFactorization(const State&) const;
 
         // OPERATORS //
 
@@ -544,6 +557,11 @@ public:
     void multiplyBySystemJacobian(const State&,
         const Vector&        v,
         Vector_<SpatialVec>& Jv) const;
+    // Same, but for ncol right-hand sides in a single sweep. v holds ncol 
+    // contiguous columns of length nu, Jv ncol contiguous columns of length nb.
+    void multiplyBySystemJacobian(const State&, int ncol,
+        const Real*          v,
+        SpatialVec*          Jv) const;
 
     // Calculate the product ~J*X where J is the partial velocity Jacobian 
     // dV/du (~J=H*Phi)and X is a vector of force-space SpatialVec's, one per 
@@ -561,6 +579,11 @@ public:
     void multiplyBySystemJacobianTranspose(const State&, 
         const Vector_<SpatialVec>& X, 
         Vector&                    JtX) const;
+    // Same, but for ncol right-hand sides in a single sweep. X holds ncol
+    // contiguous columns of length nb, JtX ncol contiguous columns of length nu.
+    void multiplyBySystemJacobianTranspose(const State&, int ncol,
+        const SpatialVec*          X, 
+        Real*                      JtX) const;
 
     // Given a set of body forces, return the equivalent set of mobilizer torques 
     // IGNORING CONSTRAINTS.
@@ -587,6 +610,11 @@ public:
     void multiplyByM(const State& s,
         const Vector&             a,
         Vector&                   Ma) const;
+    // Same, but for ncol right-hand sides in a single pair of sweeps. a and
+    // Ma each hold ncol contiguous columns of length nu.
+    void multiplyByM(const State& s, int ncol,
+        const Real*               a,
+        Real*                     Ma) const;
 
     // Multiply by the mass matrix inverse in O(n) time. Works only with the
     // non-prescribed submatrix Mrr of M; entries f_p in f are not accessed,
@@ -594,6 +622,27 @@ public:
     void multiplyByMInv(const State&    s,
         const Vector&                   f,
         Vector&                         MInvf) const; 
+    // Same, but for ncol right-hand sides in a single pair of sweeps. f and
+    // MInvf each hold ncol contiguous columns of length nu.
+    void multiplyByMInv(const State&    s, int ncol,
+        const Real*                     f,
+        Real*                           MInvf) const; 
+
+    // The sweeps of multiplyByMInv() using the given articulated body
+    // inertias, which need not be the ones in the State.
+    void multiplyByMInvWithABIs(const State& s,
+        const SBArticulatedBodyInertiaCache& abc, int ncol,
+        const Real*                         f,
+        Real*                               MInvf) const;
+
+    // Calculate x = (M+D)^-1 f in O(n) time, where D is the diagonal matrix 
+    // with entries d, which must be nonnegative. This uses its own 
+    // articulated body inertias rather than the ones in the State. Like
+    // multiplyByMInv(), only the non-prescribed part is used.
+    void multiplyByMPlusDInv(const State&   s,
+        const Vector&                       d,
+        const Vector&                       f,
+        Vector&                             x) const;
 
     // Calculate the mass matrix in O(n^2) time. State must have already
     // been realized to Position stage. M must be resizeable or already the
@@ -608,6 +657,24 @@ public:
     // are not written.
     void calcMInv(const State& s, Matrix& MInv) const;
 
+    // Calculate the branch-induced sparse factorization M = ~L*D*L in O(n*d^2)
+    // time for a tree of depth d (in mobilities), packed row by row as 
+    // described for mFactorStart. The entries of M that are needed are 
+    // generated directly from the composite body inertias in O(n*d) time.
+    void calcMFactorization(const State& s, Array_<Real>& LD) const;
+
+    // Solve M*x=f using the realized factorization (realized first if 
+    // necessary) in O(n*d) time. Prescribed motion is ignored; this is the
+    // full mass matrix. It is OK if f and x are the same Vector.
+    void solveWithMFactorization(const State& s, const Vector& f, 
+                                 Vector& x) const;
+
+    // Calculate the m X m submatrix of M^-1 whose rows and columns are the
+    // mobilities listed in us, in O(m*d^2 + m^2*d) time, without forming
+    // the rest of M^-1.
+    void calcMInvSubmatrix(const State& s, const Array_<UIndex>& us,
+                           Matrix& MInvSub) const;
+
     void calcTreeResidualForces(const State&,
         const Vector&               appliedMobilityForces,
         const Vector_<SpatialVec>&  appliedBodyForces,
@@ -944,6 +1011,36 @@ public:
                                     const Vector&    deltaV,
                                     Vector&          impulse) const;
 
+    // Partition the constraint equations currently in use into groups whose
+    // constrained bodies and mobilizers lie in disjoint sets of base-body
+    // subtrees (a base body is one whose parent is Ground). Since M^-1 does
+    // not couple different subtrees, G M^-1 ~G is block diagonal with one
+    // block per group. Each group lists its multiplier indices in increasing
+    // order; groups are ordered by their lowest multiplier index. If 
+    // groupOfBody is given, it is set to the group acting on each mobilized 
+    // body's subtree, or -1 for Ground and for subtrees that have no enabled
+    // constraints; bodies with the same group form a dynamically independent
+    // "island".
+    void findDecoupledConstraintGroups
+       (const State& state, Array_< Array_<int> >& groups,
+        Array_<int,MobilizedBodyIndex>* groupOfBody = 0) const;
+
+    // Form just the diagonal blocks of G M^-1 ~G for the given groups, as
+    // returned by findDecoupledConstraintGroups(). The blocks are formed 
+    // together with as many O(n) sweeps as there are equations in the largest
+    // group; blocks[g] is the dense mk X mk block for groups[g].
+    void calcGMInvGtBlocks(const State&                 state,
+                           const Array_< Array_<int> >& groups,
+                           Array_<Matrix>&              blocks) const;
+
+    // Solve (G M^-1 ~G) lambda = rhs by forming and factoring only the
+    // diagonal blocks given by findDecoupledConstraintGroups(). Each block is
+    // factored with FactorQTZ using the usual conditioning tolerance scaled
+    // by its own dimension.
+    void solveGMInvGtByBlocks(const State&  state,
+                              const Vector& rhs,
+                              Vector&       lambda) const;
+
     // Given an array of nu udots, return nb body accelerations in G (including
     // Ground as the 0th body with A_GB[0]=0). The returned accelerations are
     // A = J*udot + Jdot*u, with the Jdot*u (coriolis acceleration) term
@@ -1067,10 +1164,28 @@ public:
             (updCacheEntry(s,topologyCache.compositeBodyInertiaCacheIndex));
     }
 
+    const SBMassMatrixFactorCache& getMassMatrixFactorCache(const State& s) const {
+        return Value<SBMassMatrixFactorCache>::downcast
+            (getCacheEntry(s,topologyCache.massMatrixFactorCacheIndex));
+    }
+    SBMassMatrixFactorCache& updMassMatrixFactorCache(const State& s) const { //mutable
+        return Value<SBMassMatrixFactorCache>::updDowncast
+            (updCacheEntry(s,topologyCache.massMatrixFactorCacheIndex));
+    }
+
     const SBArticulatedBodyInertiaCache& getArticulatedBodyInertiaCache(const State& s) const {
         return Value<SBArticulatedBodyInertiaCache>::downcast
             (getCacheEntry(s,topologyCache.articulatedBodyInertiaCacheIndex));
     }
+    SBTreePositionSnapshotCache& updTreePositionSnapshotCache(const State& s) const { //mutable
+        return Value<SBTreePositionSnapshotCache>::updDowncast
+            (updCacheEntry(s,topologyCache.treePositionSnapshotCacheIndex));
+    }
+    SBProjectionMatrixCache& updProjectionMatrixCache(const State& s) const { //mutable
+        return Value<SBProjectionMatrixCache>::updDowncast
+            (updCacheEntry(s,topologyCache.projectionMatrixCacheIndex));
+    }
+
     SBArticulatedBodyInertiaCache& updArticulatedBodyInertiaCache(const State& s) const { //mutable
         return Value<SBArticulatedBodyInertiaCache>::updDowncast
             (updCacheEntry(s,topologyCache.articulatedBodyInertiaCacheIndex));
@@ -1210,6 +1325,31 @@ public:
     bool getShowDefaultGeometry() const;
     void setShowDefaultGeometry(bool show);
 
+    void setNumberOfThreads(int numThreads, bool limitToProcessors);
+    int getNumberOfThreads() const;
+    int getNumberOfThreadsInUse() const;
+    void setMinBodiesPerThread(int minBodies);
+    int getMinBodiesPerThread() const {return minBodiesPerThread;}
+
+    void setUseIncrementalPositionKinematics(bool useIncremental)
+    {   useIncrementalPositionKinematics = useIncremental; }
+    bool getUseIncrementalPositionKinematics() const 
+    {   return useIncrementalPositionKinematics; }
+    void setUseSparseConstraintSolver(bool useSparse)
+    {   useSparseConstraintSolver = useSparse; }
+    bool getUseSparseConstraintSolver() const 
+    {   return useSparseConstraintSolver; }
+    int getNumBodiesRecalculatedInPositionKinematics(const State&) const;
+
+    void setUseModifiedNewtonProjection(bool useModifiedNewton)
+    {   useModifiedNewtonProjection = useModifiedNewton; }
+    bool getUseModifiedNewtonProjection() const 
+    {   return useModifiedNewtonProjection; }
+    int getNumProjectionFactorizations(const State&) const;
+    int getNumProjectionFactorizationReuses(const State&) const;
+    SBProjectionMatrixCache& 
+        updProjectionMatrixCacheForReuse(const State&) const;
+
     void calcTreeForwardDynamicsOperator(const State&,
         const Vector&                   mobilityForces,
         const Vector_<Vec3>&            particleForces,
@@ -1327,6 +1467,17 @@ private:
 
     void clearTopologyState(); // note that this requires non-const access
 
+    // Apply nodeOp to every node at the given level. The nodes at a level are
+    // independent so if a level executor has been set and the level is wide
+    // enough they are split into chunks and processed in parallel. 
+    template <class NodeOp>
+    void forEachNodeAtLevel(int level, const NodeOp& nodeOp) const;
+    // Tip-to-base and base-to-tip sweeps built from forEachNodeAtLevel().
+    template <class NodeOp>
+    void sweepInward(const NodeOp& nodeOp) const;
+    template <class NodeOp>
+    void sweepOutward(const NodeOp& nodeOp) const;
+
     // The handles in this array are the owners of the MobilizedBodies after they
     // are adopted. The MobilizedBodyIndex (converted to int) is the index of a
     // MobilizedBody in this array.
@@ -1364,6 +1515,18 @@ private:
     // Map nodeNum (a.k.a. MobilizedBodyIndex) to (level,offset).
     Array_<RigidBodyNodeIndex,MobilizedBodyIndex> nodeNum2NodeMap;
 
+    // Branch-induced sparsity pattern of the mass matrix, indexed by mobility
+    // u. uParent[u] is the nearest ancestor mobility of u: the previous 
+    // mobility of the same mobilizer, or else the last mobility of the nearest
+    // inboard mobilizer that has any, or -1 if there is none. uDepth[u] is the
+    // number of ancestor mobilities of u. In the packed sparse factorization
+    // of M, row u occupies [mFactorStart[u], mFactorStart[u+1]); the first
+    // element is the diagonal and the rest are the entries for u's ancestors 
+    // in order of increasing distance. There are nu+1 entries in mFactorStart.
+    Array_<int>                uParent;
+    Array_<int>                uDepth;
+    Array_<int>                mFactorStart;
+
         // Constraints
 
     // Here we sort the above constraints by branch (ancestor's base body), then by
@@ -1436,6 +1599,35 @@ private:
     
     // Specifies whether default decorative geometry should be shown.
     bool showDefaultGeometry;
+
+    // Optional multithreading of the level-by-level sweeps used for 
+    // articulated body inertias, forward dynamics, and M^-1*f. This is null 
+    // (all sweeps serial) unless the user asks for more than one thread and
+    // there is more than one processor to run them on. ParallelExecutor is 
+    // not reentrant, so the lock ensures that only one sweep at a time uses 
+    // it; a sweep that finds it busy (for example because another thread is
+    // realizing a different State of the same System) just runs serially.
+    static const int DefaultMinBodiesPerThread = 8;
+    std::unique_ptr<ParallelExecutor>   levelExecutor;
+    int                                 numThreadsRequested;
+    int                                 minBodiesPerThread;
+    mutable std::mutex                  levelExecutorLock;
+
+    // If set, realizePositionKinematics() recalculates only those bodies 
+    // whose mobilizer q's changed since the last realization in the same
+    // State, and their outboard bodies. This is not part of the model.
+    bool                                useIncrementalPositionKinematics;
+
+    // If set, the acceleration-level constraint multipliers and constraint
+    // impulses are found by solveGMInvGtByBlocks() rather than by forming
+    // and factoring the whole of G M^-1 ~G. This is not part of the model.
+    bool                                useSparseConstraintSolver;
+
+    // If set, projectQ() and projectU() start from the factored matrix saved
+    // by an earlier projection of the same State and keep using it while it
+    // converges quickly enough, unless ForceFullNewton is requested. This is 
+    // not part of the model.
+    bool                                useModifiedNewtonProjection;
 };
 
 std::ostream& operator<<(std::ostream&, const SimbodyMatterSubsystemRep&);
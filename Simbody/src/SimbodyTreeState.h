@@ -65,6 +65,7 @@ allocated if necessary), and then advance to stage Whatever. */
 
 #include "simbody/internal/common.h"
 #include "simbody/internal/Motion.h"
+#include "simmath/LinearAlgebra.h"
 
 #include <cassert>
 #include <iostream>
@@ -86,6 +87,9 @@ class SBTimeCache;
 class SBTreePositionCache;
 class SBConstrainedPositionCache;
 class SBCompositeBodyInertiaCache;
+class SBMassMatrixFactorCache;
+class SBTreePositionSnapshotCache;
+class SBProjectionMatrixCache;
 class SBArticulatedBodyInertiaCache;
 class SBTreeVelocityCache;
 class SBConstrainedVelocityCache;
@@ -150,7 +154,10 @@ public:
     DiscreteVariableIndex modelingVarsIndex;
     CacheEntryIndex       modelingCacheIndex,instanceCacheIndex, timeCacheIndex, 
                           treePositionCacheIndex, constrainedPositionCacheIndex,
+                          treePositionSnapshotCacheIndex,
+                          projectionMatrixCacheIndex,
                           compositeBodyInertiaCacheIndex, 
+                          massMatrixFactorCacheIndex,
                           articulatedBodyInertiaCacheIndex,
                           treeVelocityCacheIndex, constrainedVelocityCacheIndex,
                           articulatedBodyVelocityCacheIndex,
@@ -820,6 +827,116 @@ public:
 
 
 
+// =============================================================================
+//                        TREE POSITION SNAPSHOT CACHE
+// =============================================================================
+// This records the q's from which the TreePositionCache was most recently 
+// calculated in this State, so that incremental position kinematics can find
+// the mobilizers whose q's have changed since then. The quaternion errors 
+// calculated at the same time are saved too, because those live in the 
+// State's shared qErr pool which isn't copied with the cache when a State
+// is copied. This depends only on 
+// Instance stage, so it remains valid across q changes (that's the point)
+// but any Instance-stage change forces a full recalculation. The State's q 
+// version is saved too: if position kinematics has been invalidated without
+// any change to q since the snapshot was taken, the TreePositionCache must be
+// recalculated for some other reason so that must also be a full 
+// recalculation. It is updated every time position kinematics is realized,
+// whether incrementally or not.
+
+class SBTreePositionSnapshotCache {
+public:
+    Vector                          lastQ;      // nq
+    Vector                          lastQErr;   // this subsystem's nqerr
+    ValueVersion                    lastQVersion;
+    Array_<bool,MobilizedBodyIndex> changed;    // nb, scratch
+    int                             nBodiesRecalculated;
+
+public:
+    void allocate(const SBTopologyCache& tree,
+                  const SBModelCache&    model,
+                  const SBInstanceCache& instance) 
+    {
+        lastQ.clear();
+        lastQErr.clear();
+        lastQVersion = 0;
+        changed.resize(tree.nBodies);
+        nBodiesRecalculated = 0;
+    }
+};
+//....................... TREE POSITION SNAPSHOT CACHE .........................
+
+
+
+// =============================================================================
+//                          PROJECTION MATRIX CACHE
+// =============================================================================
+// This saves the most recently factored iteration matrices used by projectQ()
+// and projectU() so that they can be reused by later projections of the same
+// State in modified Newton mode, along with the weights that went into each 
+// so that the reused matrix is applied consistently. Like the position 
+// snapshot this depends only on Instance stage and must survive changes to q 
+// and u. The counts accumulate for the life of the State and are kept even 
+// when the matrices are discarded because of an Instance-stage change.
+
+class SBProjectionMatrixCache {
+public:
+    class Factored {
+    public:
+        Factored() {invalidate();}
+        bool isValidFor(int nFree_, int m_) const 
+        {   return nFree == nFree_ && m == m_; }
+        void invalidate() {nFree = m = -1;}
+
+        FactorQTZ   qtz;        // m X nFree weighted constraint matrix
+        Vector      rowScale;   // m constraint error weights
+        Vector      colScale;   // nq or nu unit changes (1/weights)
+        int         nFree, m;
+    };
+
+    Factored    position;   // Tp Pq Wq^+ for free q's
+    Factored    velocity;   // Tpv [P;V] Eu^-1 for free u's
+    int         nFactorizations;
+    int         nReuses;
+
+public:
+    SBProjectionMatrixCache() : nFactorizations(0), nReuses(0) {}
+};
+//......................... PROJECTION MATRIX CACHE ............................
+
+
+
+// =============================================================================
+//                          MASS MATRIX FACTOR CACHE
+// =============================================================================
+// The branch-induced sparse factorization M = ~L*D*L, where L is unit lower
+// triangular. Because mobilities are numbered so that every ancestor comes 
+// before its descendants, the factorization produces no fill-in: row u of L 
+// is nonzero only in the columns of u's ancestor mobilities. Each row is 
+// packed as the diagonal element D(u,u) followed by the nonzero elements of 
+// L in that row; see SimbodyMatterSubsystemRep::mFactorStart for the layout.
+//
+// Like composite body inertias, this depends only on positions and isn't
+// needed internally, so it is realized only on request.
+
+class SBMassMatrixFactorCache {
+public:
+    Array_<Real> LD; // packed rows of D and L
+
+public:
+    void allocate(const SBTopologyCache& tree,
+                  const SBModelCache&    model,
+                  const SBInstanceCache& instance) 
+    {
+        // The packed size depends on the tree shape, which the topology cache
+        // doesn't record, so this is sized when it is first calculated.
+        LD.clear();
+    }
+};
+//......................... MASS MATRIX FACTOR CACHE ...........................
+
+
+
 // =============================================================================
 //                       ARTICULATED BODY INERTIA CACHE
 // =============================================================================
@@ -133,6 +133,10 @@ struct MyMultibodySystem {
 static void runOnce(const MyMultibodySystem& mbs, Integrator& integ, 
                     Real accuracy);
 
+// Check that warm starting the impulse solvers saves iterations without
+// changing the answers.
+static void testWarmStart(const MyMultibodySystem& mbs);
+
 
 //==============================================================================
 //                                   MAIN
@@ -150,6 +154,9 @@ int main() {
         RungeKuttaMersonIntegrator rkm(mbs.m_system);
         SimTK_SUBTEST3(runOnce, mbs, rkm, 1e-6);
 
+        printf("\nWARM START\n");
+        SimTK_SUBTEST1(testWarmStart, mbs);
+
     SimTK_END_TEST();
 }
 
@@ -374,6 +381,60 @@ void runOnce(const MyMultibodySystem& mbs, Integrator& Xinteg, Real accuracy)
 
 
 
+//==============================================================================
+//                              TEST WARM START
+//==============================================================================
+// Run the first part of the simulation (while the stack is still settling)
+// with each impulse solver, with and without warm starting. The compression
+// phase (phase 0) solves are the ones that get a starting guess.
+static void testWarmStart(const MyMultibodySystem& mbs) {
+    const int NWarmSteps = 500;
+    for (int type=0; type < 2; ++type) {
+        const SemiExplicitEulerTimeStepper::ImpulseSolverType solverType =
+            SemiExplicitEulerTimeStepper::ImpulseSolverType(type);
+        long long nIters[2], nFails[2];
+        Vector q[2], u[2];
+        for (int warm=0; warm < 2; ++warm) {
+            SemiExplicitEulerTimeStepper integ(mbs.m_system);
+            integ.setPositionProjectionMethod
+               (SemiExplicitEulerTimeStepper::Bilateral);
+            integ.setAccuracy(1e-2);
+            integ.setConstraintTolerance(.001);
+            integ.setImpulseSolverType(solverType);
+            integ.setUseWarmStart(warm != 0);
+            SimTK_TEST(integ.getUseWarmStart() == (warm != 0));
+            integ.initialize(mbs.m_system.getDefaultState());
+
+            for (int stepNum=1; stepNum <= NWarmSteps; ++stepNum) {
+                // Apply discrete spring forces as in runOnce().
+                State& state = integ.updAdvancedState();
+                const Real a1err = mbs.m_link2.getAngle(state)-Target1;
+                const Real a2err = mbs.m_link3.getAngle(state)-Target2;
+                mbs.m_discrete.setOneMobilityForce(state, mbs.m_link2, 
+                    MobilizerUIndex(0), -Kp1*a1err);
+                mbs.m_discrete.setOneMobilityForce(state, mbs.m_link3, 
+                    MobilizerUIndex(0), -Kp2*a2err);
+
+                const Real tNext = stepNum * MaxStepSize;
+                do {integ.stepTo(tNext);} while (integ.getTime() < tNext);
+            }
+
+            const ImpulseSolver& solver = integ.getImpulseSolver();
+            nIters[warm] = solver.getNumIterations(0);
+            nFails[warm] = solver.getNumFailures(0);
+            q[warm] = integ.getState().getQ();
+            u[warm] = integ.getState().getU();
+        }
+        printf("%s: %lld iterations (%lld failures) cold, %lld (%lld) warm\n",
+            SemiExplicitEulerTimeStepper::getImpulseSolverTypeName(solverType),
+            nIters[0], nFails[0], nIters[1], nFails[1]);
+        SimTK_TEST(nIters[1] < nIters[0]);
+        SimTK_TEST(nFails[1] <= nFails[0]);
+        SimTK_TEST_EQ_TOL(q[1], q[0], 1e-3);
+        SimTK_TEST_EQ_TOL(u[1], u[0], 1e-2);
+    }
+}
+
 //==============================================================================
 //                            GET REACTION PAIR
 //==============================================================================
@@ -532,15 +532,129 @@ void testTriangleMeshTriangleMesh() {
     }
 }
 
+// Make sure the ContactTrackerSubsystem broad phase lets through exactly the
+// right contacts for spheres scattered in a box of the given size, whether 
+// the bodies move a little or get scrambled between calls.
+void checkContactTrackerBroadPhase(const Vec3& size) {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    ContactTrackerSubsystem tracker(system);
+    const int numBodies = 60;
+    Real radius[numBodies];
+    Random::Uniform random(0.0, 1.0);
+
+    // Surface 0 is a half space on ground with its outward normal along +y,
+    // so everything below y=0 is inside it.
+    matter.updGround().updBody().addContactSurface(
+        Transform(Rotation(-Pi/2, ZAxis)),
+        ContactSurface(ContactGeometry::HalfSpace(), ContactMaterial()));
+    for (int i = 0; i < numBodies; ++i) {
+        radius[i] = 0.2 + 0.3*random.getValue();
+        Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+        body.addContactSurface(Transform(),
+            ContactSurface(ContactGeometry::Sphere(radius[i]),
+                           ContactMaterial()));
+        MobilizedBody::Free(matter.updGround(), Transform(), body, Transform());
+    }
+    State state = system.realizeTopology();
+    Vec3 center[numBodies];
+    for (int i = 0; i < numBodies; ++i)
+        center[i] = size.elementwiseMultiply(Vec3(random.getValue(), 
+                        random.getValue(), random.getValue())) - Vec3(0,1,0);
+
+    for (int iteration = 0; iteration < 60; ++iteration) {
+        // Usually move the bodies just a little, but occasionally move them
+        // all to new places.
+        const bool scramble = (iteration % 20 == 10);
+        for (int i = 0; i < numBodies; ++i) {
+            const Vec3 r(random.getValue(), random.getValue(),
+                         random.getValue());
+            center[i] = scramble ? size.elementwiseMultiply(r) - Vec3(0,1,0)
+                                 : center[i] + 0.1*(r - Vec3(0.5));
+            matter.getMobilizedBody(MobilizedBodyIndex(i+1))
+                .setQToFitTranslation(state, center[i]);
+        }
+        system.realize(state, Stage::Position);
+
+        set<pair<int,int> > expected, found;
+        for (int i = 0; i < numBodies; ++i) {
+            if (center[i][1] < radius[i])
+                expected.insert(make_pair(0, i+1));
+            for (int j = i+1; j < numBodies; ++j)
+                if ((center[i]-center[j]).norm() < radius[i]+radius[j])
+                    expected.insert(make_pair(i+1, j+1));
+        }
+        const ContactSnapshot& active = tracker.getActiveContacts(state);
+        for (int n = 0; n < active.getNumContacts(); ++n) {
+            const Contact& contact = active.getContact(n);
+            int surf1 = contact.getSurface1(), surf2 = contact.getSurface2();
+            if (surf1 > surf2) std::swap(surf1, surf2);
+            found.insert(make_pair(surf1, surf2));
+        }
+        ASSERT(found == expected);
+    }
+}
+
+void testContactTrackerBroadPhase() {
+    checkContactTrackerBroadPhase(Vec3(4, 4, 4));
+    // Every sphere overlaps every other one along x, so pruning has to come
+    // from the other two directions.
+    checkContactTrackerBroadPhase(Vec3(0.1, 8, 8));
+    // Spread out along one direction only.
+    checkContactTrackerBroadPhase(Vec3(0.1, 0.5, 20));
+}
+
+// Track a pair of ellipsoids that stay in contact while they move slightly
+// each step. Starting from the previous step's contact points should take
+// fewer Newton iterations than starting over but give the same answer.
+void testEllipsoidEllipsoidWarmStart() {
+    const ContactGeometry::Ellipsoid ellipsoid1(Vec3(1.0, 2.0, 3.0));
+    const ContactGeometry::Ellipsoid ellipsoid2(Vec3(2.0, 1.0, 0.5));
+    const ContactTracker::ConvexImplicitPair 
+        tracker(ContactGeometry::Ellipsoid::classTypeId(),
+                ContactGeometry::Ellipsoid::classTypeId());
+    const UntrackedContact untracked(ContactSurfaceIndex(0), 
+                                     ContactSurfaceIndex(1));
+    const Transform X_GS1(Rotation(0.3, XAxis), Vec3(0));
+    Contact warm = untracked;
+    int coldIters = 0, warmIters = 0;
+    for (int step = 0; step < 50; ++step) {
+        const Real t = step*1e-4;
+        const Transform X_GS2(Rotation(BodyRotationSequence, 
+                                       0.2+t, XAxis, 0.5-t, YAxis, t, ZAxis),
+                              Vec3(2.5+0.5*t, 0.5, 0.2-t));
+        Contact cold, next;
+        ASSERT(tracker.trackContact(untracked, X_GS1, ellipsoid1, 
+                                    X_GS2, ellipsoid2, Infinity, cold));
+        ASSERT(tracker.trackContact(warm, X_GS1, ellipsoid1, 
+                                    X_GS2, ellipsoid2, Infinity, next));
+        ASSERT(EllipticalPointContact::isInstance(cold));
+        ASSERT(EllipticalPointContact::isInstance(next));
+        const EllipticalPointContact& c = EllipticalPointContact::getAs(cold);
+        const EllipticalPointContact& w = EllipticalPointContact::getAs(next);
+        ASSERT(c.hasWitnessPoints() && w.hasWitnessPoints());
+        ASSERT(abs(c.getDepth()-w.getDepth()) < 1e-8);
+        ASSERT((c.getContactFrame().p()-w.getContactFrame().p()).norm() < 1e-8);
+        ASSERT((c.getContactFrame().z()-w.getContactFrame().z()).norm() < 1e-8);
+        ASSERT(abs(~c.getCurvatures()-~w.getCurvatures()).sum() < 1e-6);
+        coldIters += c.getNumIterations();
+        warmIters += w.getNumIterations();
+        warm = next;
+    }
+    ASSERT(warmIters < coldIters);
+}
+
 int main() {
     try {
         testHalfSpaceSphere();
         testSphereSphere();
         testHalfSpaceEllipsoid();
         testEllipsoidEllipsoid();
+        testEllipsoidEllipsoidWarmStart();
         testHalfSpaceTriangleMesh();
         testSphereTriangleMesh();
         testTriangleMeshTriangleMesh();
+        testContactTrackerBroadPhase();
     }
     catch(const std::exception& e) {
         cout << "exception: " << e.what() << endl;
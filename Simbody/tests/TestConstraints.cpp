@@ -723,6 +723,165 @@ void testConstraintAccelerationErrors() {
     }
 }
 
+// Build several independent closed-loop mechanisms hanging from Ground, plus
+// one Rod coupling two of them, and check that the block-sparse constraint
+// solver gets the same multipliers, accelerations, and impulses as the dense
+// one. There are four decoupled groups here, one of them with two loops.
+void testSparseConstraintSolver() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    GeneralForceSubsystem forces(system);
+    Force::UniformGravity(forces, matter, Vec3(0, -9.8, 0));
+    const Real mass = 1.23;
+    Body::Rigid body(MassProperties(mass, Vec3(.1,.2,-.03), 
+                     mass*UnitInertia(1.1, 1.2, 1.3, .01, -.02, .07)));
+    Rotation R_PF(Pi/20, UnitVec3(1,2,3));
+    Rotation R_BM(-Pi/17, UnitVec3(2,.2,3));
+
+    const int NumLoops = 5;
+    Array_<MobilizedBodyIndex> tips;
+    for (int loop = 0; loop < NumLoops; ++loop) {
+        MobilizedBodyIndex parent = GroundIndex;
+        const Vec3 base(2*loop, 0, 0);
+        for (int i = 0; i < 4; ++i) {
+            MobilizedBody::Gimbal b(
+                matter.updMobilizedBody(parent), 
+                Transform(R_PF, i==0 ? base : Vec3(-.1,.3,.2)), 
+                body, Transform(R_BM, Vec3(BOND_LENGTH, 0, 0)));
+            parent = b.getMobilizedBodyIndex();
+        }
+        tips.push_back(parent);
+        Constraint::Ball(matter.updGround(), base + Vec3(.3,-.6,.1), 
+                         matter.updMobilizedBody(parent), Vec3(0));
+    }
+    Constraint::Rod(matter.updMobilizedBody(MobilizedBodyIndex(tips[1]-1)),
+                    matter.updMobilizedBody(MobilizedBodyIndex(tips[2]-1)), 2.);
+    Constraint::ConstantSpeed(matter.updMobilizedBody(tips[3]), 
+                              MobilizerUIndex(1), .5);
+
+    State state;
+    createState(system, state);
+
+    const int m = state.getNMultipliers();
+    SimTK_TEST(m == 3*NumLoops + 2);
+    SimTK_TEST(!matter.getUseSparseConstraintSolver());
+
+    Random::Gaussian random;
+    Vector deltaV(m);
+    for (int i = 0; i < m; ++i) deltaV[i] = random.getValue();
+
+    const Vector denseLambda = state.getMultipliers();
+    const Vector denseUDot   = state.getUDot();
+    Vector denseImpulse;
+    matter.solveForConstraintImpulses(state, deltaV, denseImpulse);
+
+    matter.setUseSparseConstraintSolver(true);
+    SimTK_TEST(matter.getUseSparseConstraintSolver());
+    state.invalidateAllCacheAtOrAbove(Stage::Acceleration);
+    system.realize(state, Stage::Acceleration);
+    Vector sparseImpulse;
+    matter.solveForConstraintImpulses(state, deltaV, sparseImpulse);
+
+    SimTK_TEST_EQ_SIZE(state.getMultipliers(), denseLambda, m);
+    SimTK_TEST_EQ_SIZE(state.getUDot(), denseUDot, state.getNU());
+    SimTK_TEST_EQ_SIZE(sparseImpulse, denseImpulse, m);
+    MACHINE_TEST(state.getUDotErr().norm(), 0);
+
+    // The impulses must actually produce the requested velocity changes.
+    Vector f, du, Gdu;
+    matter.multiplyByGTranspose(state, sparseImpulse, f);
+    matter.multiplyByMInv(state, f, du);
+    matter.multiplyByG(state, du, Gdu);
+    SimTK_TEST_EQ_SIZE(Gdu, deltaV, m);
+
+    // The blocks of G M^-1 ~G must match the dense matrix, with zeroes
+    // everywhere else. Loops 1 and 2 are coupled by the rod.
+    Matrix GMInvGt;
+    matter.calcProjectedMInv(state, GMInvGt);
+    Array_< Array_<MultiplierIndex> > blockMults;
+    Array_<Matrix> blocks;
+    matter.calcProjectedMInvBlocks(state, blockMults, blocks);
+    SimTK_TEST(blockMults.size() == NumLoops-1 && blocks.size() == NumLoops-1);
+    Matrix fromBlocks(m, m, Real(0));
+    for (unsigned b = 0; b < blocks.size(); ++b)
+        for (unsigned i = 0; i < blockMults[b].size(); ++i)
+            for (unsigned j = 0; j < blockMults[b].size(); ++j)
+                fromBlocks(blockMults[b][i], blockMults[b][j]) = 
+                    blocks[b](i,j);
+    SimTK_TEST_EQ_SIZE(fromBlocks, GMInvGt, m);
+
+    // Disabling one of the loops changes the multiplier layout; the groups
+    // must follow.
+    matter.getConstraint(ConstraintIndex(2)).disable(state);
+    system.realize(state, Stage::Acceleration);
+    SimTK_TEST(state.getNMultipliers() == m-3);
+    const Vector sparseLambda = state.getMultipliers();
+    matter.setUseSparseConstraintSolver(false);
+    state.invalidateAllCacheAtOrAbove(Stage::Acceleration);
+    system.realize(state, Stage::Acceleration);
+    SimTK_TEST_EQ_SIZE(sparseLambda, state.getMultipliers(), m-3);
+}
+
+// Integrate a closed-loop chain with and without modified Newton projection.
+// Reusing the projection matrices must save most of the factorizations while
+// keeping the constraints satisfied, and give nearly the same trajectory.
+void testModifiedNewtonProjection() {
+    MultibodySystem& system = createSystem();
+    SimbodyMatterSubsystem& matter = system.updMatterSubsystem();
+    MobilizedBody& first = matter.updMobilizedBody(MobilizedBodyIndex(1));
+    MobilizedBody& last = matter.updMobilizedBody(MobilizedBodyIndex(NUM_BODIES));
+    Constraint::Rod rod(first, last, 3.0);
+    Constraint::Ball ball(matter.updMobilizedBody(MobilizedBodyIndex(3)), 
+                          Vec3(0),
+                          matter.updMobilizedBody(MobilizedBodyIndex(7)), 
+                          Vec3(0));
+    State initState;
+    createState(system, initState);
+
+    // A loose integration accuracy with a tight constraint tolerance makes
+    // projection necessary on nearly every step.
+    const Real Accuracy = 1e-3, ConsTol = 1e-8;
+    Array_<Vector> finalQ;
+    Array_<int> nFactorizations, nReuses, nProjections;
+    for (int mode = 0; mode < 3; ++mode) {
+        // mode 0: full Newton, 1: modified Newton, 2: modified Newton but 
+        // forced full Newton by the integrator.
+        matter.setUseModifiedNewtonProjection(mode > 0);
+        RungeKuttaMersonIntegrator integ(system);
+        integ.setAccuracy(Accuracy);
+        integ.setConstraintTolerance(ConsTol);
+        if (mode == 2) integ.setForceFullNewton(true);
+        TimeStepper ts(system, integ);
+        ts.initialize(initState);
+        const int nFactorizationsOnEntry = 
+            matter.getNumProjectionFactorizations(ts.getState());
+        const int nReusesOnEntry = 
+            matter.getNumProjectionFactorizationReuses(ts.getState());
+        ts.stepTo(1);
+        const State& state = ts.getState();
+        system.realize(state, Stage::Acceleration);
+        SimTK_TEST_EQ_TOL(state.getQErr().normRMS(), 0, ConsTol);
+        SimTK_TEST_EQ_TOL(state.getUErr().normRMS(), 0, ConsTol);
+        finalQ.push_back(state.getQ());
+        nFactorizations.push_back(matter.getNumProjectionFactorizations(state)
+                                  - nFactorizationsOnEntry);
+        nReuses.push_back(matter.getNumProjectionFactorizationReuses(state)
+                          - nReusesOnEntry);
+        nProjections.push_back(integ.getNumProjections());
+    }
+    matter.setUseModifiedNewtonProjection(false);
+
+    // Full Newton forms a new matrix on every projection but doesn't count
+    // them.
+    SimTK_TEST(nFactorizations[0] == 0 && nReuses[0] == 0);
+    SimTK_TEST(nReuses[1] > 0);
+    SimTK_TEST(0 < nFactorizations[1] && nFactorizations[1] < nProjections[1]);
+    SimTK_TEST(nFactorizations[2] == 0 && nReuses[2] == 0);
+    SimTK_TEST_EQ_TOL(finalQ[1], finalQ[0], 10*Accuracy);
+    SimTK_TEST_EQ(finalQ[2], finalQ[0]);
+    delete &system;
+}
+
 int main() {
     SimTK_START_TEST("TestConstraints");
         SimTK_SUBTEST(testBallConstraint);
@@ -739,5 +898,7 @@ int main() {
         SimTK_SUBTEST(testConstraintMatrices);
         SimTK_SUBTEST(testConstraintAccelerationErrors);
         SimTK_SUBTEST(testDisablingConstraints);
+        SimTK_SUBTEST(testSparseConstraintSolver);
+        SimTK_SUBTEST(testModifiedNewtonProjection);
     SimTK_END_TEST();
 }
@@ -266,11 +266,74 @@ void testEffSphereOnPlaneNewFormulation(bool verbose = false)
     }
 }
 
+// Press a sphere mesh into a brick mesh and return the contact force on the
+// sphere. Uses a fresh system so nothing is remembered from earlier calls.
+Vec3 calcMeshOnMeshForce(Real penetration) {
+    const Real stiffness = 1e9, radius = 1.0;
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    ContactTrackerSubsystem tracker(system);
+    CompliantContactSubsystem contactForces(system, tracker);
+    matter.Ground().updBody().addContactSurface(
+        Transform(Vec3(0, penetration-radius-0.5, 0)),
+        ContactSurface(ContactGeometry::TriangleMesh(
+                           PolygonalMesh::createBrickMesh(Vec3(2,0.5,2), 8)),
+                       ContactMaterial(2*stiffness, 0, 0, 0, 0), 1.0));
+    Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+    body.addContactSurface(Transform(),
+        ContactSurface(ContactGeometry::TriangleMesh(
+                           PolygonalMesh::createSphereMesh(radius, 4)),
+                       ContactMaterial(2*stiffness, 0, 0, 0, 0), 1.0));
+    MobilizedBody::Translation mesh(matter.updGround(), Transform(), 
+                                    body, Transform());
+    State state = system.realizeTopology();
+    system.realize(state, Stage::Dynamics);
+    ASSERT(contactForces.getNumContactForces(state)==1);
+    return contactForces.getContactForce(state,0).getForceOnSurface2()[1];
+}
+
+// Both surfaces are meshes, so the nearest point queries go through the 
+// batched path that starts from the faces found on the previous evaluation.
+// Sliding the sphere around must give exactly the forces computed from 
+// scratch.
+void testEffMeshOnMesh() {
+    const Real stiffness = 1e9, radius = 1.0, penetration = 0.05;
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    ContactTrackerSubsystem tracker(system);
+    CompliantContactSubsystem contactForces(system, tracker);
+    matter.Ground().updBody().addContactSurface(
+        Transform(Vec3(0, -radius-0.5, 0)),
+        ContactSurface(ContactGeometry::TriangleMesh(
+                           PolygonalMesh::createBrickMesh(Vec3(2,0.5,2), 8)),
+                       ContactMaterial(2*stiffness, 0, 0, 0, 0), 1.0));
+    Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+    body.addContactSurface(Transform(),
+        ContactSurface(ContactGeometry::TriangleMesh(
+                           PolygonalMesh::createSphereMesh(radius, 4)),
+                       ContactMaterial(2*stiffness, 0, 0, 0, 0), 1.0));
+    MobilizedBody::Translation mesh(matter.updGround(), Transform(), 
+                                    body, Transform());
+    State state = system.realizeTopology();
+
+    for (int i = 0; i < 10; ++i) {
+        const Real depth = penetration*(1 + 0.1*i);
+        mesh.setQToFitTranslation(state, Vec3(0, -depth, 0));
+        system.realize(state, Stage::Dynamics);
+        ASSERT(contactForces.getNumContactForces(state)==1);
+        const Vec3 frc = 
+            contactForces.getContactForce(state,0).getForceOnSurface2()[1];
+        ASSERT(frc[1] > 0);
+        ASSERT((frc - calcMeshOnMeshForce(depth)).norm() <= 1e-10*frc.norm());
+    }
+}
+
 int main() {
     try {
         testForces();
         testEffSphereOnPlaneOldFormulation();
         testEffSphereOnPlaneNewFormulation();
+        testEffMeshOnMesh();
     }
     catch(const std::exception& e) {
         cout << "exception: " << e.what() << endl;
@@ -1401,6 +1401,116 @@ void testPositionKinematics() {
 
 }
 
+// With incremental position kinematics, changing a q should recalculate only
+// the affected body and its outboard bodies, and give exactly the same results
+// as a full recalculation.
+void testIncrementalPositionKinematics() {
+    MultibodySystem system;
+    MyForceImpl* frcp;
+    makeSystem(true, system, frcp);
+    SimbodyMatterSubsystem& matter = system.updMatterSubsystem();
+    const int nb = matter.getNumBodies(); // includes Ground
+
+    State incr = system.realizeTopology();
+    incr.updQ() = Test::randVector(incr.getNQ());
+    State full = incr;
+
+    // Bodies 1-10 are Ball, Weld, Pin, Screw, Translation, BendStretch,
+    // Slider (2a), Universal (2b), Slider (2x), Planar; see makeSystem().
+    const MobilizedBody& pendBody2a = matter.getMobilizedBody(MobodIndex(7));
+    const MobilizedBody& pendBody4a = matter.getMobilizedBody(MobodIndex(10));
+    const MobilizedBody& pendBody1  = matter.getMobilizedBody(MobodIndex(1));
+
+    matter.setUseIncrementalPositionKinematics(true);
+    SimTK_TEST(matter.getUseIncrementalPositionKinematics());
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)==0);
+    system.realize(incr, Stage::Position); // first time is always full
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)
+               == nb-1);
+
+    const Real delta[] = {0.1, -0.2, 0.3};
+    const MobilizedBody* changed[] = {&pendBody4a, &pendBody2a, &pendBody1};
+    const int expectRecalc[] = {1, 3, nb-1}; // a tip, a short branch, all
+    for (int i=0; i < 3; ++i) {
+        const MobilizedBody& mobod = *changed[i];
+        mobod.setOneQ(incr, 0, mobod.getOneQ(incr, 0) + delta[i]);
+        mobod.setOneQ(full, 0, mobod.getOneQ(incr, 0));
+
+        system.realize(incr, Stage::Position);
+        SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)
+                   == expectRecalc[i]);
+
+        matter.setUseIncrementalPositionKinematics(false);
+        system.realize(full, Stage::Position);
+        SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(full)
+                   == nb-1);
+        matter.setUseIncrementalPositionKinematics(true);
+
+        for (MobodIndex mbx(0); mbx < nb; ++mbx) {
+            const MobilizedBody& b = matter.getMobilizedBody(mbx);
+            SimTK_TEST(b.getBodyTransform(incr).p() 
+                       == b.getBodyTransform(full).p());
+            SimTK_TEST(b.getBodyTransform(incr).R().asMat33() 
+                       == b.getBodyTransform(full).R().asMat33());
+        }
+        SimTK_TEST((incr.getQErr()-full.getQErr()).normInf() == 0);
+    }
+
+    // A copy of the State can be updated incrementally too.
+    State incrCopy = incr;
+    pendBody4a.setOneQ(incrCopy, 1, pendBody4a.getOneQ(incrCopy, 1) + 0.1);
+    pendBody4a.setOneQ(full, 1, pendBody4a.getOneQ(incrCopy, 1));
+    system.realize(incrCopy, Stage::Position);
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incrCopy)
+               == 1);
+    matter.setUseIncrementalPositionKinematics(false);
+    system.realize(full, Stage::Position);
+    matter.setUseIncrementalPositionKinematics(true);
+    for (MobodIndex mbx(0); mbx < nb; ++mbx) {
+        const MobilizedBody& b = matter.getMobilizedBody(mbx);
+        SimTK_TEST(b.getBodyTransform(incrCopy).p() 
+                   == b.getBodyTransform(full).p());
+    }
+    SimTK_TEST((incrCopy.getQErr()-full.getQErr()).normInf() == 0);
+
+    // Nothing changed: nothing recalculated.
+    incr.updQ(); // invalidates Position stage without changing any q
+    system.realize(incr, Stage::Position);
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)==0);
+
+    // Invalidating all the Position-stage cache entries doesn't invalidate 
+    // position kinematics, which depends only on Instance stage and q. But 
+    // invalidating position kinematics explicitly must force a full 
+    // recalculation even if there were q changes too.
+    incr.invalidateAllCacheAtOrAbove(Stage::Position);
+    system.realize(incr, Stage::Position);
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)==0);
+    pendBody4a.setOneQ(incr, 0, pendBody4a.getOneQ(incr, 0) + 0.1);
+    matter.invalidatePositionKinematics(incr);
+    system.realize(incr, Stage::Position);
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)
+               == nb-1);
+
+    // After that, q changes are incremental again.
+    pendBody4a.setOneQ(incr, 0, pendBody4a.getOneQ(incr, 0) + 0.1);
+    system.realize(incr, Stage::Position);
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)==1);
+
+    // An Instance-stage change forces a full recalculation.
+    incr.invalidateAllCacheAtOrAbove(Stage::Instance);
+    system.realize(incr, Stage::Position);
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)
+               == nb-1);
+
+    // So does invalidatePositionKinematics().
+    matter.invalidatePositionKinematics(incr);
+    matter.realizePositionKinematics(incr);
+    SimTK_TEST(matter.getNumBodiesRecalculatedInPositionKinematics(incr)
+               == nb-1);
+
+    matter.setUseIncrementalPositionKinematics(false);
+}
+
 // Velocity kinematics should be valid if:
 // - realize(Velocity) has been done
 // - or, position kinematics is valid and realizeVelocityKinematics() has
@@ -1484,9 +1594,285 @@ void testVelocityKinematics() {
     syscomv = matter.calcSystemMassCenterVelocityInGround(state); // OK
 }
 
+// Check that the multi-column operators give the same results as applying
+// the single-vector operators one column at a time, including when the
+// supplied matrices don't have packed columns.
+void testMultipleRightHandSides() {
+    MultibodySystem system;
+    MyForceImpl* frcp;
+    makeSystem(false, system, frcp);
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+
+    State state = system.realizeTopology();
+    const int nu = state.getNU();
+    const int nb = matter.getNumBodies();
+    state.updQ() = Test::randVector(state.getNQ());
+    system.realize(state, Stage::Position);
+
+    const int k = 5;
+    Matrix big(nu+3, k+2);
+    for (int j=0; j < big.ncol(); ++j)
+        big(j) = Test::randVector(big.nrow());
+    const Matrix A = big(1, 0, nu, k); // a view; not packed columns
+    const Matrix Apacked = A;
+    Matrix_<SpatialVec> F(nb, k);
+    for (int j=0; j < k; ++j)
+        for (int i=0; i < nb; ++i)
+            F(i,j) = SpatialVec(Test::randVec3(), Test::randVec3());
+
+    Matrix MA, MInvA, JtF;
+    Matrix_<SpatialVec> JA;
+    matter.multiplyByMMultiple(state, A, MA);
+    matter.multiplyByMInvMultiple(state, Apacked, MInvA);
+    matter.multiplyBySystemJacobianMultiple(state, A, JA);
+    matter.multiplyBySystemJacobianTransposeMultiple(state, F, JtF);
+    Matrix bigOut(nu+1, k+1);
+    MatrixView outView = bigOut(1, 1, nu, k);
+    matter.multiplyByMMultiple(state, Apacked, outView); // output not packed
+
+    SimTK_TEST(MA.nrow()==nu && MA.ncol()==k);
+    SimTK_TEST(JA.nrow()==nb && JA.ncol()==k);
+    SimTK_TEST(JtF.nrow()==nu && JtF.ncol()==k);
+    for (int j=0; j < k; ++j) {
+        Vector col, colMInv, colJtF; Vector_<SpatialVec> colJ;
+        matter.multiplyByM(state, Apacked(j), col);
+        SimTK_TEST_EQ(MA(j), col);
+        SimTK_TEST_EQ(outView(j), col);
+        matter.multiplyByMInv(state, Apacked(j), colMInv);
+        SimTK_TEST_EQ(MInvA(j), colMInv);
+        matter.multiplyBySystemJacobian(state, Apacked(j), colJ);
+        SimTK_TEST_EQ(JA(j), colJ);
+        matter.multiplyBySystemJacobianTranspose(state, F(j), colJtF);
+        SimTK_TEST_EQ(JtF(j), colJtF);
+    }
+
+    // Single columns taken from unpacked views go through the single-vector
+    // operators.
+    Matrix MACols(nu, k), MInvACols(nu, k);
+    for (int j=0; j < k; ++j) {
+        matter.multiplyByM(state, A(j), MACols(j));
+        matter.multiplyByMInv(state, A(j), MInvACols(j));
+    }
+    SimTK_TEST_EQ(MACols, MA);
+    SimTK_TEST_EQ(MInvACols, MInvA);
+
+    // The output may be the same Matrix as the input.
+    Matrix inPlace = Apacked;
+    matter.multiplyByMMultiple(state, inPlace, inPlace);
+    SimTK_TEST_EQ(inPlace, MA);
+    inPlace = Apacked;
+    matter.multiplyByMInvMultiple(state, inPlace, inPlace);
+    SimTK_TEST_EQ(inPlace, MInvA);
+
+    // calcM() and calcMInv() are built from the block operators.
+    Matrix M, MInv;
+    matter.calcM(state, M);
+    matter.calcMInv(state, MInv);
+    Matrix I(nu,nu); I = 1;
+    SimTK_TEST_EQ_SIZE(M*MInv, I, 10*nu);
+    SimTK_TEST_EQ(M*Apacked, MA);
+}
+
+// Check the branch-induced sparse factorization of M against the O(n)
+// operators and the explicitly-formed M^-1.
+void testSparseMFactorization() {
+    MultibodySystem system;
+    MyForceImpl* frcp;
+    makeSystem(false, system, frcp);
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+
+    State state = system.realizeTopology();
+    const int nu = state.getNU();
+    state.updQ() = Test::randVector(state.getNQ());
+    system.realize(state, Stage::Position);
+
+    SimTK_TEST(!matter.isMFactorizationRealized(state));
+    const Vector f = Test::randVector(nu);
+    Vector x, MInvf, Mx;
+    matter.solveWithMFactorization(state, f, x);
+    SimTK_TEST(matter.isMFactorizationRealized(state));
+
+    matter.multiplyByMInv(state, f, MInvf);
+    SimTK_TEST_EQ_SIZE(x, MInvf, nu);
+    matter.multiplyByM(state, x, Mx);
+    SimTK_TEST_EQ_SIZE(Mx, f, nu);
+
+    Vector y = f; // solve in place
+    matter.solveWithMFactorization(state, y, y);
+    SimTK_TEST_EQ(y, x);
+
+    Matrix MInv;
+    matter.calcMInv(state, MInv);
+    Array_<UIndex> us;
+    us.push_back(UIndex(nu-1)); us.push_back(UIndex(0)); 
+    us.push_back(UIndex(nu/2)); us.push_back(UIndex(3));
+    Matrix MInvSub;
+    matter.calcMInvSubmatrix(state, us, MInvSub);
+    SimTK_TEST(MInvSub.nrow()==4 && MInvSub.ncol()==4);
+    for (int i=0; i < 4; ++i)
+        for (int j=0; j < 4; ++j)
+            SimTK_TEST_EQ_SIZE(MInvSub(i,j), MInv(us[i],us[j]), nu);
+
+    // The factorization is q-dependent.
+    state.updQ()[0] += 0.1;
+    SimTK_TEST(!matter.isMFactorizationRealized(state));
+    SimTK_TEST_MUST_THROW(matter.realizeMFactorization(state));
+    system.realize(state, Stage::Position);
+    matter.realizeMFactorization(state);
+    SimTK_TEST(matter.isMFactorizationRealized(state));
+    matter.invalidateMFactorization(state);
+    SimTK_TEST(!matter.isMFactorizationRealized(state));
+
+    SimTK_TEST_MUST_THROW(
+        matter.solveWithMFactorization(state, Vector(nu+1, Real(1)), x));
+    us.push_back(UIndex(nu));
+    SimTK_TEST_MUST_THROW(matter.calcMInvSubmatrix(state, us, MInvSub));
+}
+
+// Mobilizers with more than three dofs have their hinge inertias D inverted
+// by a specialized Cholesky-based routine rather than the general one used
+// for small ones. Check that the O(n) operators still agree with the
+// explicitly-formed mass matrix.
+void testHighDofMobilizers() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body(MassProperties(1.3, Vec3(.1,.2,-.3),
+                     UnitInertia(1.2,1.1,1.4,.01,.02,-.03)));
+    MobilizedBody::Free free1(matter.Ground(), Vec3(1,0,0), body, Vec3(0,1,0));
+    MobilizedBody::FreeLine freeLine(free1, Vec3(0,-1,0), body, Vec3(0,1,0));
+    MobilizedBody::Bushing bushing(freeLine, Vec3(0,-1,0), body, Vec3(0,1,0));
+    MobilizedBody::Universal univ(bushing, Vec3(0,-1,0), body, Vec3(0,1,0));
+    MobilizedBody::Free free2(univ, Vec3(0,-1,0), body, Vec3(0,1,0));
+
+    State state = system.realizeTopology();
+    const int nu = state.getNU();
+    state.updQ() = Test::randVector(state.getNQ());
+    system.realize(state, Stage::Position);
+
+    Matrix M, MInv;
+    matter.calcM(state, M);
+    matter.calcMInv(state, MInv);
+    Matrix MInvCalc(M);
+    MInvCalc.invertInPlace();
+    SimTK_TEST_EQ_SIZE(MInv, MInvCalc, nu);
+    Matrix identity(nu,nu); identity = 1;
+    SimTK_TEST_EQ_SIZE(M*MInv, identity, nu);
+
+    const Vector f = Test::randVector(nu);
+    Vector MInvf;
+    matter.multiplyByMInv(state, f, MInvf);
+    SimTK_TEST_EQ_SIZE(MInvf, MInvCalc*f, nu);
+}
+
+// Build a wide, shallow system (many independent two-link chains hanging
+// from Ground) and check that the multithreaded level sweeps produce exactly
+// the same answers as the serial ones.
+void testParallelTreeSweeps() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    GeneralForceSubsystem forces(system);
+    Force::Gravity(forces, matter, -YAxis, 9.8);
+
+    const Body::Rigid body(MassProperties(1.5, Vec3(.1,.2,.3), 
+                                          UnitInertia(1,2,3)));
+    for (int i=0; i < 40; ++i) {
+        MobilizedBody::Pin link1(matter.Ground(), Vec3(i,0,0), 
+                                 body, Vec3(0,1,0));
+        MobilizedBody::Ball link2(link1, Vec3(0,-1,0), body, Vec3(0,1,0));
+        if (i % 3 == 0)
+            MobilizedBody::Universal(link2, Vec3(0,-1,0), body, Vec3(0,1,0));
+    }
+
+    State state = system.realizeTopology();
+    const int nu = state.getNU();
+    state.updQ() = Test::randVector(state.getNQ());
+    state.updU() = Test::randVector(nu);
+    system.realize(state, Stage::Acceleration);
+    const Vector udotSerial = state.getUDot();
+
+    const Vector f = Test::randVector(nu);
+    Vector MInvfSerial;
+    matter.multiplyByMInv(state, f, MInvfSerial);
+
+    SimTK_TEST(matter.getNumberOfThreads() == 1);
+    matter.setNumberOfThreads(4);
+    matter.setMinBodiesPerThread(3);
+    SimTK_TEST(matter.getNumberOfThreads() == 4);
+    SimTK_TEST(matter.getMinBodiesPerThread() == 3);
+    SimTK_TEST_MUST_THROW(matter.setMinBodiesPerThread(0));
+    SimTK_TEST_MUST_THROW(matter.setNumberOfThreads(0));
+    SimTK_TEST_MUST_THROW(matter.setNumberOfThreads(-1));
+    SimTK_TEST(matter.getNumberOfThreads() == 4);
+
+    // Force recalculation of everything, including articulated body inertias.
+    state.invalidateAllCacheAtOrAbove(Stage::Position);
+    system.realize(state, Stage::Acceleration);
+    SimTK_TEST((state.getUDot()-udotSerial).normInf() == 0);
+
+    Vector MInvfParallel;
+    matter.multiplyByMInv(state, f, MInvfParallel);
+    SimTK_TEST((MInvfParallel-MInvfSerial).normInf() == 0);
+
+    // A single processor machine would have done all that serially, so 
+    // repeat it making sure the threaded path is really taken.
+    matter.setNumberOfThreads(4, false);
+    SimTK_TEST(matter.getNumberOfThreadsInUse() == 4);
+    state.invalidateAllCacheAtOrAbove(Stage::Position);
+    system.realize(state, Stage::Acceleration);
+    SimTK_TEST((state.getUDot()-udotSerial).normInf() == 0);
+    matter.multiplyByMInv(state, f, MInvfParallel);
+    SimTK_TEST((MInvfParallel-MInvfSerial).normInf() == 0);
+
+    matter.setNumberOfThreads(1);
+    SimTK_TEST(matter.getNumberOfThreads() == 1);
+    SimTK_TEST(matter.getNumberOfThreadsInUse() == 1);
+}
+
+// Check the System-level mass matrix operators that integrators use, and 
+// that (M+D)^-1 handles the D added on the diagonal for every kind of 
+// mobilizer, including a lone particle.
+void testSystemMassMatrixOperators() {
+    MultibodySystem system;
+    MyForceImpl* frcp;
+    makeSystem(false, system, frcp);
+    SimbodyMatterSubsystem& matter = system.updMatterSubsystem();
+    MobilizedBody::Translation particle(matter.Ground(),
+        Body::Rigid(MassProperties(1.5, Vec3(0), Inertia(0))));
+
+    State state = system.realizeTopology();
+    const int nu = state.getNU();
+    state.updQ() = Test::randVector(state.getNQ());
+    system.realize(state, Stage::Position);
+
+    Matrix M;
+    matter.calcM(state, M);
+    const Vector a = Test::randVector(nu);
+    Vector Ma;
+    SimTK_TEST(system.multiplyByM(state, a, Ma));
+    SimTK_TEST_EQ(Ma, M*a);
+
+    Vector d(nu);
+    for (int i=0; i < nu; ++i) d[i] = 10*std::abs(Test::randReal());
+    const Vector f = Test::randVector(nu);
+    Vector x;
+    SimTK_TEST(system.multiplyByMPlusDInv(state, d, f, x));
+    Matrix MPlusD = M;
+    MPlusD.updDiag() += d;
+    SimTK_TEST_EQ_TOL(MPlusD*x, f, nu*SignificantReal);
+
+    // D == 0 gives M^-1 f.
+    Vector MInvf;
+    matter.multiplyByMInv(state, f, MInvf);
+    SimTK_TEST(system.multiplyByMPlusDInv(state, Vector(nu, Real(0)), f, x));
+    SimTK_TEST_EQ(x, MInvf);
+
+    SimTK_TEST_MUST_THROW(system.multiplyByMPlusDInv(state, d(0,nu-1), f, x));
+}
+
 int main() {
     SimTK_START_TEST("TestMassMatrix");
         SimTK_SUBTEST(testPositionKinematics);
+        SimTK_SUBTEST(testIncrementalPositionKinematics);
         SimTK_SUBTEST(testVelocityKinematics);
         SimTK_SUBTEST(testRel2Cart);
         SimTK_SUBTEST(testJacobianBiasTerms);
@@ -1494,8 +1880,13 @@ int main() {
         SimTK_SUBTEST(testArticulatedBodyInertia);
         SimTK_SUBTEST(testArticulatedBodyVelocity);
         SimTK_SUBTEST(testUnconstrainedSystem);
+        SimTK_SUBTEST(testSystemMassMatrixOperators);
         SimTK_SUBTEST(testConstrainedSystem);
         SimTK_SUBTEST(testTaskJacobians);
+        SimTK_SUBTEST(testMultipleRightHandSides);
+        SimTK_SUBTEST(testSparseMFactorization);
+        SimTK_SUBTEST(testHighDofMobilizers);
+        SimTK_SUBTEST(testParallelTreeSweeps);
     SimTK_END_TEST();
 }
 
@@ -68,6 +68,12 @@ void testParallelForce()
     
     for(int x = 0; x < 50; x++)
       Force::Custom custom(forces, new ParallelForceImpl());
+
+    forces.setNumberOfThreads(3);
+    SimTK_TEST(forces.getNumberOfThreads() == 3);
+    SimTK_TEST_MUST_THROW(forces.setNumberOfThreads(0));
+    SimTK_TEST_MUST_THROW(forces.setNumberOfThreads(-1));
+    SimTK_TEST(forces.getNumberOfThreads() == 3);
     
     system.realizeTopology();
     State state = system.getDefaultState();
@@ -88,9 +94,178 @@ void testNonParallelForce()
     system.realize(state, Stage::Dynamics);
 }
 
+// A cheap parallel force so that realizeBatch() exercises concurrent use of
+// the force subsystem's executor: a spring on every mobility.
+class ParallelSpringImpl : public Force::Custom::Implementation {
+public:
+    bool shouldBeParallelIfPossible() const override {return true;}
+    void calcForce(const State& state, Vector_<SpatialVec>& bodyForces,
+          Vector_<Vec3>& particleForces, Vector& mobilityForces) const override{
+        mobilityForces -= 10*state.getQ();
+    }
+    Real calcPotentialEnergy(const State& state) const override {
+        return 5*state.getQ().normSqr();
+    }
+};
+
+void testRealizeBatch()
+{
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    GeneralForceSubsystem forces(system);
+    Force::Gravity(forces, matter, -YAxis, 9.8);
+    Force::Custom(forces, new ParallelSpringImpl());
+    Force::Custom(forces, new ParallelSpringImpl());
+
+    const Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(1)));
+    MobilizedBody::Pin link1(matter.Ground(), Vec3(0), body, Vec3(0,1,0));
+    MobilizedBody::Pin link2(link1, Vec3(0,-1,0), body, Vec3(0,1,0));
+    Constraint::PrescribedMotion(matter, new Function::Linear(Vector(Vec2(.5,.1))),
+                                 link2, MobilizerQIndex(0));
+    system.realizeTopology();
+
+    const int NStates = 64;
+    Array_<State> states(NStates, system.getDefaultState());
+    for (int i=0; i < NStates; ++i) {
+        states[i].updTime() = i/10.;
+        link1.setAngle(states[i], i/20.);
+        link1.setRate(states[i], 1 - i/30.);
+    }
+    Array_<State> serial(states);
+    for (auto& state : serial)
+        system.realize(state, Stage::Acceleration);
+
+    system.realizeBatch(states, Stage::Acceleration);
+    for (int i=0; i < NStates; ++i) {
+        SimTK_TEST(states[i].getSystemStage() == Stage::Acceleration);
+        SimTK_TEST_EQ(states[i].getUDot(), serial[i].getUDot());
+        SimTK_TEST_EQ(states[i].getMultipliers(), serial[i].getMultipliers());
+    }
+
+    // States held by pointer, each in a different stage.
+    Array_<const State*> ptrs;
+    for (int i=0; i < NStates; ++i) {
+        states[i].invalidateAllCacheAtOrAbove(i%2 ? Stage::Position
+                                                  : Stage::Dynamics);
+        ptrs.push_back(&states[i]);
+    }
+    system.realizeBatch(ptrs); // default is highest runtime stage
+    for (int i=0; i < NStates; ++i) {
+        SimTK_TEST(states[i].getSystemStage() == Stage::Report);
+        SimTK_TEST_EQ(states[i].getUDot(), serial[i].getUDot());
+    }
+
+    // A bad State causes an exception but the others are still realized.
+    for (auto& state : states)
+        state.invalidateAllCacheAtOrAbove(Stage::Position);
+    const State badState; // not even realized to Model stage
+    ptrs[NStates/2] = &badState;
+    SimTK_TEST_MUST_THROW(system.realizeBatch(ptrs, Stage::Velocity));
+    for (int i=0; i < NStates; ++i)
+        if (i != NStates/2)
+            SimTK_TEST(states[i].getSystemStage() == Stage::Velocity);
+
+    ptrs[0] = nullptr;
+    SimTK_TEST_MUST_THROW(system.realizeBatch(ptrs));
+}
+
+// Contact detection and contact forces calculated with several threads must
+// be bitwise identical to the serial results.
+void testParallelContact()
+{
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    ContactTrackerSubsystem tracker(system);
+    CompliantContactSubsystem contactForces(system, tracker);
+    const ContactMaterial material(1e6, 0.1, 0.8, 0.7, 0.5);
+
+    // The floor is the half space y < 0.
+    matter.Ground().updBody().addContactSurface(
+        Transform(Rotation(-Pi/2, ZAxis)),
+        ContactSurface(ContactGeometry::HalfSpace(), material));
+
+    // A grid of alternating spheres and meshed cubes that touch the floor
+    // and their neighbors.
+    Body::Rigid sphereBody(MassProperties(1, Vec3(0), UnitInertia(1)));
+    sphereBody.addContactSurface(Transform(),
+        ContactSurface(ContactGeometry::Sphere(.5), material));
+    Body::Rigid cubeBody(MassProperties(1, Vec3(0), UnitInertia(1)));
+    cubeBody.addContactSurface(Transform(),
+        ContactSurface(ContactGeometry::TriangleMesh
+                        (PolygonalMesh::createBrickMesh(Vec3(.4), 2)),
+                       material, .1));
+    const int NBodies = 16;
+    for (int i=0; i < NBodies; ++i)
+        MobilizedBody::Free(matter.Ground(), Transform(),
+                            i%2 ? cubeBody : sphereBody, Transform());
+    system.realizeTopology();
+
+    State state = system.getDefaultState();
+    for (int i=0; i < NBodies; ++i) {
+        const MobilizedBody& mobod = matter.getMobilizedBody(MobodIndex(i+1));
+        mobod.setQToFitTransform(state, Transform(Rotation(.1*i, XAxis),
+                                        Vec3(.8*(i%4), .35, .8*(i/4))));
+        mobod.setUToFitLinearVelocity(state, Vec3(.1*i, -1, 0));
+    }
+
+    State serial = state;
+    system.realize(serial, Stage::Acceleration);
+    const Real serialPE = system.calcPotentialEnergy(serial);
+
+    SimTK_TEST(tracker.getNumberOfThreads() == 1);
+    SimTK_TEST(contactForces.getNumberOfThreads() == 1);
+    tracker.setNumberOfThreads(4);
+    contactForces.setNumberOfThreads(4);
+    SimTK_TEST(tracker.getNumberOfThreads() == 4);
+    SimTK_TEST(contactForces.getNumberOfThreads() == 4);
+    SimTK_TEST_MUST_THROW(contactForces.setNumberOfThreads(0));
+    SimTK_TEST_MUST_THROW(contactForces.setNumberOfThreads(-1));
+    SimTK_TEST_MUST_THROW(tracker.setNumberOfThreads(0));
+    SimTK_TEST_MUST_THROW(tracker.setNumberOfThreads(-1));
+    SimTK_TEST(tracker.getNumberOfThreads() == 4);
+    SimTK_TEST(contactForces.getNumberOfThreads() == 4);
+
+    State parallel = state;
+    system.realize(parallel, Stage::Acceleration);
+
+    const ContactSnapshot& serialContacts = tracker.getActiveContacts(serial);
+    const ContactSnapshot& parallelContacts = 
+        tracker.getActiveContacts(parallel);
+    SimTK_TEST(serialContacts.getNumContacts() > NBodies);
+    SimTK_TEST(parallelContacts.getNumContacts() 
+               == serialContacts.getNumContacts());
+    for (int i=0; i < serialContacts.getNumContacts(); ++i) {
+        const Contact& c1 = serialContacts.getContact(i);
+        const Contact& c2 = parallelContacts.getContact(i);
+        SimTK_TEST(c1.getSurface1() == c2.getSurface1());
+        SimTK_TEST(c1.getSurface2() == c2.getSurface2());
+        SimTK_TEST(c1.getTypeId() == c2.getTypeId());
+    }
+
+    const int nForces = contactForces.getNumContactForces(serial);
+    SimTK_TEST(contactForces.getNumContactForces(parallel) == nForces);
+    for (int i=0; i < nForces; ++i) {
+        const ContactForce& f1 = contactForces.getContactForce(serial, i);
+        const ContactForce& f2 = contactForces.getContactForce(parallel, i);
+        SimTK_TEST(f1.getForceOnSurface2() == f2.getForceOnSurface2());
+        SimTK_TEST(f1.getContactPoint() == f2.getContactPoint());
+    }
+    for (int i=0; i < serial.getNU(); ++i)
+        SimTK_TEST(parallel.getUDot()[i] == serial.getUDot()[i]);
+
+    // Potential energy can also be calculated at Position stage, in which
+    // case the forces are calculated at zero velocity.
+    State positionOnly = state;
+    system.realize(positionOnly, Stage::Position);
+    SimTK_TEST(system.calcPotentialEnergy(positionOnly) == serialPE);
+}
+
 int main()
 {
     SimTK_START_TEST("TestParallelForces");
+        SimTK_SUBTEST(testRealizeBatch);
+        SimTK_SUBTEST(testParallelContact);
+
         //Simply pass the test if only one thread is supported on this machine
         unsigned concurrentThreadsSupported = std::thread::hardware_concurrency();
         if(concurrentThreadsSupported <= 1)
@@ -0,0 +1,230 @@
+/* -------------------------------------------------------------------------- *
+ *               Simbody(tm): SemiExplicitEuler Time Stepper                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* These tests check the SemiExplicitEulerTimeStepper options that split the
+impulse problem into independent pieces. The models are piles of bricks
+touching the ground (or each other) at their corners through point-plane
+unilateral contacts. Each option is checked by running the same motion with
+and without it; the answers must agree. */
+
+#include "Simbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+const Vec3 Cube(.5,.5,.5); // half-dimensions of each brick
+const Real Mu_s = 0.15, Mu_d = 0.1, Mu_v = 0;
+const Real MaxStepSize = Real(1/1000.); // 1 ms
+
+// Add gravity and nBricks free bricks, all mobilized from Ground at its 
+// origin, and realize the system's topology. Each brick has a contact point at
+// each of its 8 corners that touches the ground plane z=0, or if lastOnFirst 
+// is set, the last brick touches the first brick's x-y plane instead. That
+// plane passes through the first brick's origin, so the last brick settles
+// halfway into it. Gravity keeps a reference to the matter subsystem handle,
+// so that must outlive the system.
+static void buildBrickPile(SimbodyMatterSubsystem& matter, 
+                           GeneralForceSubsystem& forces, int nBricks,
+                           MobilizedBody::Free brick[], 
+                           bool lastOnFirst=false) {
+    Force::Gravity(forces, matter, -ZAxis, 9.81);
+
+    const Body::Rigid brickInfo(MassProperties(1, Vec3(0), 
+                                               UnitInertia::brick(Cube)));
+    for (int b=0; b < nBricks; ++b) {
+        brick[b] = MobilizedBody::Free(matter.updGround(), Vec3(0), 
+                                       brickInfo, Vec3(0));
+        MobilizedBody& below = lastOnFirst && b == nBricks-1 
+            ? (MobilizedBody&)brick[0] : (MobilizedBody&)matter.updGround();
+        for (int i=-1; i<=1; i+=2)
+        for (int j=-1; j<=1; j+=2)
+        for (int k=-1; k<=1; k+=2) {
+            const Vec3 pt = Vec3(i,j,k).elementwiseMultiply(Cube);
+            matter.adoptUnilateralContact(new PointPlaneContact
+               (below, ZAxis, 0., brick[b], pt, 0., Mu_s, Mu_d, Mu_v));
+        }
+    }
+    matter.getSystem().realizeTopology();
+}
+
+//==============================================================================
+//                          TEST BLOCK COMPLIANCE
+//==============================================================================
+// Two bricks sliding and tumbling on the ground don't interact, so the 
+// compliance matrix has one block for each brick's contacts. Working with the
+// independent blocks must give the same motion as working with the whole 
+// matrix.
+void testBlockCompliance() {
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter(system);
+    GeneralForceSubsystem   forces(system);
+    MobilizedBody::Free     brick[2];
+    buildBrickPile(matter, forces, 2, brick);
+
+    // One brick sliding flat, the other dropped on an edge while spinning.
+    State initState = system.getDefaultState();
+    brick[0].setQToFitTranslation(initState, Vec3(0,0,Cube[2]));
+    brick[0].setUToFitLinearVelocity(initState, Vec3(1,.5,0));
+    brick[1].setQToFitTransform(initState, 
+        Transform(Rotation(Pi/8, YAxis), Vec3(3,0,1)));
+    brick[1].setUToFitAngularVelocity(initState, Vec3(0,0,2));
+
+    const int NBlockSteps = 500;
+    for (int type=0; type < 2; ++type) {
+        const SemiExplicitEulerTimeStepper::ImpulseSolverType solverType =
+            SemiExplicitEulerTimeStepper::ImpulseSolverType(type);
+        Vector q[2], u[2];
+        for (int blocks=0; blocks < 2; ++blocks) {
+            SemiExplicitEulerTimeStepper integ(system);
+            integ.setConstraintTolerance(.001);
+            integ.setImpulseSolverType(solverType);
+            integ.setUseBlockCompliance(blocks != 0);
+            SimTK_TEST(integ.getUseBlockCompliance() == (blocks != 0));
+            integ.initialize(initState);
+            for (int step=1; step <= NBlockSteps; ++step)
+                integ.stepTo(step*MaxStepSize);
+            q[blocks] = integ.getState().getQ();
+            u[blocks] = integ.getState().getU();
+        }
+        SimTK_TEST_EQ_TOL(q[1], q[0], 1e-5);
+        SimTK_TEST_EQ_TOL(u[1], u[0], 1e-4);
+    }
+}
+
+//==============================================================================
+//                               TEST ISLANDS
+//==============================================================================
+// Three bricks rest on the ground in separate places while a fourth falls 
+// onto the first one. The three should fall asleep, the first should be 
+// woken when the fourth lands on it, and then all four should sleep.
+void testIslands() {
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter(system);
+    GeneralForceSubsystem   forces(system);
+    MobilizedBody::Free     brick[4];
+    buildBrickPile(matter, forces, 4, brick, true);
+
+    State initState = system.getDefaultState();
+    for (int b=0; b < 3; ++b)
+        brick[b].setQToFitTranslation(initState, Vec3(3*b,0,Cube[2]));
+    brick[3].setQToFitTranslation(initState, Vec3(.1,0,2.5));
+
+    const Real SleepTime = .05;
+    const int  NIslandSteps = 1000;
+    Vector q[2];
+    for (int nThreads=1; nThreads <= 2; ++nThreads) {
+        SemiExplicitEulerTimeStepper integ(system);
+        integ.setConstraintTolerance(.001);
+        integ.setUseBlockCompliance(true);
+        integ.setNumberOfThreads(nThreads);
+        integ.setUseSleeping(true);
+        integ.setSleepTime(SleepTime);
+        integ.initialize(initState);
+
+        bool sawAllButFallingAsleep = false, sawWakeUp = false;
+        for (int step=1; step <= NIslandSteps; ++step) {
+            integ.stepTo(step*MaxStepSize);
+            const bool falling = brick[3].getBodyOriginLocation
+                                    (integ.getState())[2] > 2*Cube[2]+.01;
+            if (falling && integ.getNumSleepingBodies() == 3)
+                sawAllButFallingAsleep = true;
+            if (sawAllButFallingAsleep && !falling
+                && !integ.isBodySleeping(brick[0].getMobilizedBodyIndex()))
+                sawWakeUp = true;
+        }
+        SimTK_TEST(sawAllButFallingAsleep);
+        SimTK_TEST(sawWakeUp);
+        SimTK_TEST(integ.getNumSleepingBodies() == 4);
+        SimTK_TEST_EQ_TOL(brick[3].getBodyOriginLocation(integ.getState()),
+                          Vec3(.1,0,2*Cube[2]), 1e-2);
+
+        // Nothing is left to solve while everything is asleep.
+        const ImpulseSolver& solver = integ.getImpulseSolver();
+        const long long nSolves = solver.getNumSolves(0);
+        const Vector qAsleep = integ.getState().getQ();
+        for (int step=NIslandSteps+1; step <= NIslandSteps+100; ++step)
+            integ.stepTo(step*MaxStepSize);
+        SimTK_TEST(solver.getNumSolves(0) == nSolves);
+        SimTK_TEST_EQ(integ.getState().getQ(), qAsleep);
+
+        q[nThreads-1] = integ.getState().getQ();
+    }
+    SimTK_TEST_EQ(q[1], q[0]);
+}
+
+//==============================================================================
+//                     TEST THREADED SOLVER SETTINGS
+//==============================================================================
+// Three tilted bricks slide on the ground in separate places so that each is
+// its own block. Partway through we loosen the PGS solver's convergence
+// tolerance and iteration limit; if those didn't reach the solvers used by
+// the other threads, the threaded run would drift from the serial one.
+void testThreadedSolverSettings() {
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter(system);
+    GeneralForceSubsystem   forces(system);
+    MobilizedBody::Free     brick[3];
+    buildBrickPile(matter, forces, 3, brick);
+
+    State initState = system.getDefaultState();
+    for (int b=0; b < 3; ++b) {
+        brick[b].setQToFitTransform(initState, 
+            Transform(Rotation(.2*(b+1), XAxis), Vec3(3*b,0,.75)));
+        brick[b].setUToFitLinearVelocity(initState, Vec3(1+b,0,0));
+    }
+
+    const int NSettingsSteps = 300;
+    Vector q[2];
+    for (int nThreads=1; nThreads <= 2; ++nThreads) {
+        PGSImpulseSolver* solver = new PGSImpulseSolver(.01);
+        SemiExplicitEulerTimeStepper integ(system);
+        integ.setImpulseSolver(solver); // takes over ownership
+        integ.setConstraintTolerance(.001);
+        integ.setUseBlockCompliance(true);
+        integ.setNumberOfThreads(nThreads);
+        integ.initialize(initState);
+
+        for (int step=1; step <= NSettingsSteps; ++step) {
+            if (step == NSettingsSteps/2) {
+                solver->setConvergenceTol(.1);
+                solver->setMaxIterations(2);
+                solver->clearStats();
+            }
+            integ.stepTo(step*MaxStepSize);
+        }
+        // Stats include the blocks solved by other threads.
+        SimTK_TEST(solver->getNumSolves(0) > 0);
+        SimTK_TEST(solver->getNumIterations(0) <= 2*solver->getNumSolves(0));
+        q[nThreads-1] = integ.getState().getQ();
+    }
+    SimTK_TEST_EQ(q[1], q[0]);
+}
+
+int main() {
+    SimTK_START_TEST("TestSemiExplicitEulerTimeStepper");
+        SimTK_SUBTEST(testBlockCompliance);
+        SimTK_SUBTEST(testIslands);
+        SimTK_SUBTEST(testThreadedSolverSettings);
+    SimTK_END_TEST();
+}
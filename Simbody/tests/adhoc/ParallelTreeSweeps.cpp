@@ -0,0 +1,184 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKsimbody.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+using std::string;
+
+using namespace SimTK;
+
+/**
+ * This program measures how the level-by-level tree sweeps scale with the
+ * number of threads given to SimbodyMatterSubsystem::setNumberOfThreads().
+ * The test system is a wide tree: many free-floating bases, each carrying a
+ * short chain of ball-jointed links, so that every level of the tree holds
+ * enough bodies to be divided among the threads. Each operation is timed
+ * with 1 thread and with more, and the results are checked to be the same.
+ *
+ * Times are wall clock (real) times since CPU time would count the work done
+ * by all threads.
+ */
+
+static const int NumBases  = 128;
+static const int ChainLen  = 8;
+
+// The following routines define the operations to be profiled.
+
+void doRealizePositionKinematics(MultibodySystem& system, State& state) {
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+    matter.invalidatePositionKinematics(state);
+    matter.realizePositionKinematics(state);
+}
+
+void doRealizeVelocityKinematics(MultibodySystem& system, State& state) {
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+    matter.invalidateVelocityKinematics(state);
+    matter.realizeVelocityKinematics(state);
+}
+
+void doRealizeArticulatedBodyInertias(MultibodySystem& system, State& state) {
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+    matter.invalidateArticulatedBodyInertias(state);
+    matter.realizeArticulatedBodyInertias(state);
+}
+
+void doRealizeDynamics2Acceleration(MultibodySystem& system, State& state) {
+    state.invalidateAllCacheAtOrAbove(Stage::Dynamics);
+    system.realize(state, Stage::Acceleration);
+}
+
+void doRealizeTime2Acceleration(MultibodySystem& system, State& state) {
+    state.invalidateAllCacheAtOrAbove(Stage::Time);
+    system.realize(state, Stage::Acceleration);
+}
+
+void doMultiplyByM(MultibodySystem& system, State& state) {
+    Vector v(state.getNU(), 1.0), mv;
+    system.getMatterSubsystem().multiplyByM(state, v, mv);
+}
+
+void doMultiplyByMInv(MultibodySystem& system, State& state) {
+    Vector v(state.getNU(), 1.0), minvv;
+    system.getMatterSubsystem().multiplyByMInv(state, v, minvv);
+}
+
+/**
+ * Time how long it takes to perform an operation the given number of times
+ * with each thread count, and print the speedup relative to 1 thread. The
+ * best of several repeats is used to reduce noise from other processes.
+ */
+void timeComputation(MultibodySystem& system,
+                     void function(MultibodySystem& system, State& state),
+                     const string& name, int iterations,
+                     const Array_<int>& threadCounts) {
+    const int repeats = 5;
+    SimbodyMatterSubsystem& matter = system.updMatterSubsystem();
+
+    std::printf("%32s:", name.c_str());
+    double serialUs = 0;
+    Vector serialUDot;
+    for (unsigned t=0; t < threadCounts.size(); ++t) {
+        matter.setNumberOfThreads(threadCounts[t]);
+        State state = system.getDefaultState();
+        for (int i=0; i < state.getNQ(); ++i)
+            state.updQ()[i] = .01*(i%17);
+        for (int i=0; i < state.getNU(); ++i)
+            state.updU()[i] = .1 - .02*(i%11);
+        system.realize(state, Stage::Acceleration);
+        function(system, state); // warm up the threads and the caches
+
+        double best = Infinity;
+        for (int i = 0; i < repeats; i++) {
+            const double start = realTime();
+            for (int j = 0; j < iterations; j++)
+                function(system, state);
+            best = std::min(best, realTime() - start);
+        }
+        const double timePerIterUs = best*1000000/iterations;
+
+        // Threads must not change the answers.
+        system.realize(state, Stage::Acceleration);
+        if (t == 0) {
+            serialUs = timePerIterUs;
+            serialUDot = state.getUDot();
+        } else if ((state.getUDot() - serialUDot).normInf() != 0)
+            std::printf(" MISMATCH");
+
+        std::printf(" %2dT %7.4gus (%4.2fx)", threadCounts[t], timePerIterUs,
+                    serialUs/timePerIterUs);
+    }
+    std::printf("\n");
+    matter.setNumberOfThreads(1);
+}
+
+int main() {
+    // Always ask for a few threads, even on a small machine; the sweeps
+    // should then run no slower than serial since Simbody won't use more 
+    // threads than there are processors.
+    Array_<int> threadCounts;
+    const int nProc = ParallelExecutor::getNumProcessors();
+    const int maxThreads = std::max(4, nProc);
+    for (int n = 1; n < maxThreads; n *= 2)
+        threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+
+    // Create the wide tree. Gravity gives the dynamics sweeps something to 
+    // do. The force holds on to the matter subsystem handle, so these must
+    // stay in scope.
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    GeneralForceSubsystem forces(system);
+    Force::Gravity(forces, matter, -YAxis, 9.8);
+    Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(.1,.2,.3)));
+    for (int b = 0; b < NumBases; b++) {
+        MobilizedBody last = MobilizedBody::Free(matter.updGround(),
+            Vec3(2*b, 0, 0), body, Vec3(0));
+        for (int i = 1; i < ChainLen; i++)
+            last = MobilizedBody::Ball(last, Vec3(0, -.5, 0),
+                                       body, Vec3(0, .5, 0));
+    }
+    system.realizeTopology();
+
+    std::printf("%d bases x %d links = %d bodies, %d dofs, %d processors\n",
+        NumBases, ChainLen, matter.getNumBodies()-1,
+        matter.getNumMobilities(), nProc);
+
+    timeComputation(system, doRealizePositionKinematics,
+                    "realizePositionKinematics", 500, threadCounts);
+    timeComputation(system, doRealizeVelocityKinematics,
+                    "realizeVelocityKinematics", 500, threadCounts);
+    timeComputation(system, doRealizeArticulatedBodyInertias,
+                    "realizeArticulatedBodyInertias", 500, threadCounts);
+    timeComputation(system, doRealizeDynamics2Acceleration,
+                    "realizeDynamics2Acceleration", 500, threadCounts);
+    timeComputation(system, doRealizeTime2Acceleration,
+                    "realizeTime2Acceleration", 200, threadCounts);
+    timeComputation(system, doMultiplyByM,
+                    "multiplyByM", 500, threadCounts);
+    timeComputation(system, doMultiplyByMInv,
+                    "multiplyByMInv", 500, threadCounts);
+    return 0;
+}
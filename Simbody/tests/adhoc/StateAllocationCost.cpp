@@ -0,0 +1,118 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* This program measures how much of the cost of copying and realizing a
+State goes to the heap. It replaces the global operator new so it can count
+the allocations made while copying a State into a new one, copying it into
+an existing State with the same layout, realizing Instance stage, and
+realizing Position through Acceleration after a change of q. For each it
+prints the allocations, bytes and time per operation, for chains of pin
+jointed bodies with gravity and a spring on every joint. To bound what a
+contiguous arena for the State's values could save, it also times just
+making and freeing as many blocks as a new copy allocates. */
+
+#include "Simbody.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace SimTK;
+
+static long long numAllocations = 0, numBytes = 0;
+
+void* operator new(std::size_t size) {
+    ++numAllocations; numBytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Run op() reps times and print the allocations, bytes and time per call.
+// Returns the allocations per call and sets the bytes per call.
+template <class Op>
+static long long measure(const char* name, int reps, Op op, 
+                         long long* bytesPerCall=0) {
+    const long long allocs0 = numAllocations, bytes0 = numBytes;
+    const double start = realTime();
+    for (int i=0; i < reps; ++i)
+        op();
+    const double elapsed = realTime() - start;
+    std::printf("  %-26s allocs=%7.1f bytes=%9.1f time=%8.2fus\n", name,
+                double(numAllocations-allocs0)/reps,
+                double(numBytes-bytes0)/reps, 1e6*elapsed/reps);
+    if (bytesPerCall) *bytesPerCall = (numBytes-bytes0)/reps;
+    return (numAllocations-allocs0)/reps;
+}
+
+int main() {
+  try {
+    const int chainLengths[] = {10, 100};
+    for (int n : chainLengths) {
+        MultibodySystem system;
+        SimbodyMatterSubsystem matter(system);
+        GeneralForceSubsystem forces(system);
+        Force::Gravity(forces, matter, -YAxis, 9.8);
+        Body::Rigid body(MassProperties(1, Vec3(0), Inertia(1)));
+        MobilizedBody parent = matter.Ground();
+        for (int i=0; i < n; ++i) {
+            MobilizedBody::Pin b(parent, Vec3(0,-1,0), body, Vec3(0));
+            Force::MobilityLinearSpring(forces, b, MobilizerQIndex(0), 10, 0);
+            parent = b;
+        }
+        State state = system.realizeTopology();
+        system.realize(state, Stage::Acceleration);
+
+        const int reps = n < 100 ? 20000 : 2000;
+        std::printf("chain of %d bodies, ny=%d\n", n, state.getNY());
+        long long copyBytes;
+        const long long copyAllocs = measure("copy into new State", reps, 
+            [&]() { State copy(state); }, &copyBytes);
+        // The most an arena could save on that copy.
+        const std::size_t avgBytes = std::size_t(copyBytes/copyAllocs);
+        Array_<char*> blocks((unsigned)copyAllocs);
+        measure("  its allocations alone", reps, [&]() {
+            for (unsigned i=0; i < blocks.size(); ++i)
+                blocks[i] = new char[avgBytes];
+            for (unsigned i=0; i < blocks.size(); ++i)
+                delete[] blocks[i]; });
+        State target(state);
+        measure("copy into same layout", reps, [&]() {
+            target = state; });
+        measure("realize Instance", reps, [&]() {
+            state.invalidateAllCacheAtOrAbove(Stage::Instance);
+            system.realize(state, Stage::Instance); });
+        measure("realize Position..Accel", reps, [&]() {
+            state.updQ()[0] += 1e-9;
+            system.realize(state, Stage::Acceleration); });
+    }
+  } catch (const std::exception& e) {
+    std::printf("EXCEPTION THROWN: %s\n", e.what());
+    return 1;
+  }
+    return 0;
+}
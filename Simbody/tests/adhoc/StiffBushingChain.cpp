@@ -0,0 +1,101 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 Stanford University and the Authors.           *
+ * Authors:                                                                   *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* This program compares an explicit integrator (RungeKuttaMerson), CPodes
+(BDF, with the dense and preconditioned Krylov linear solvers) and the
+Rosenbrock integrator on a stiff multibody system: a chain of free bodies
+held together by stiff, damped LinearBushings and swinging in gravity. For
+each integrator it prints the number of steps and realizations (and Krylov
+iterations), the wall clock time, and a couple of final coordinates so that
+the answers can be compared. */
+
+#include "Simbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+static const int  NumBodies = 6;
+static const Real FinalTime = 2;
+static const Real Accuracy  = 1e-3;
+
+int main() {
+  try {
+    for (int which = 0; which < 5; ++which) {
+        MultibodySystem system;
+        SimbodyMatterSubsystem matter(system);
+        GeneralForceSubsystem forces(system);
+        Force::Gravity(forces, matter, -YAxis, 9.8);
+
+        Body::Rigid body(MassProperties(1, Vec3(0),
+                                        Inertia(Vec3(0.1,0.2,0.3))));
+        MobilizedBody parent = matter.Ground();
+        for (int i=0; i < NumBodies; ++i) {
+            MobilizedBody::Free b(parent, Vec3(0,-0.5,0), body, Vec3(0,0.5,0));
+            // Stiff in rotation and translation, with some damping.
+            Force::LinearBushing(forces, parent, Vec3(0,-0.5,0),
+                                 b, Vec3(0,0.5,0),
+                                 Vec6(1e4,1e4,1e4,1e6,1e6,1e6),
+                                 Vec6(10,10,10,100,100,100));
+            parent = b;
+        }
+        State state = system.realizeTopology();
+        matter.getMobilizedBody(MobilizedBodyIndex(1)).setOneU(state, 0, 1.0);
+
+        Integrator* integp =
+              which==0 ? (Integrator*)new RungeKuttaMersonIntegrator(system)
+            : which==2 ? (Integrator*)new RosenbrockIntegrator(system)
+            :            (Integrator*)new CPodesIntegrator(system);
+        Integrator& integ = *integp;
+        if (which==3 || which==4)
+            static_cast<CPodesIntegrator&>(integ).setUseKrylovSolver(true);
+        if (which==4)
+            static_cast<CPodesIntegrator&>(integ).setUseKrylovPreconditioner(false);
+        integ.setAccuracy(Accuracy);
+
+        TimeStepper ts(system, integ);
+        ts.initialize(state);
+        const double startTime = realTime();
+        ts.stepTo(FinalTime);
+        const double elapsed = realTime() - startTime;
+
+        const State& s = integ.getState();
+        static const char* variant[] = 
+            {"", "", "", " Krylov", " Krylov noPrec"};
+        const int nKrylov = which >= 3 
+            ? static_cast<CPodesIntegrator&>(integ).getNumKrylovIterations() : 0;
+        std::printf("%-18s%-14s ny=%d steps=%5d realizations=%6d errtest fails=%4d"
+                    " krylov=%6d time=%6.3gs q0=%.6f qlast=%.6f\n",
+                    integ.getMethodName(), variant[which],
+                    s.getNY(),
+                    integ.getNumStepsTaken(), integ.getNumRealizations(),
+                    integ.getNumErrorTestFailures(), nKrylov, elapsed,
+                    s.getQ()[0], s.getQ()[s.getNQ()-2]);
+        delete integp;
+    }
+  } catch (const std::exception& e) {
+    std::printf("EXCEPTION THROWN: %s\n", e.what());
+    return 1;
+  }
+    return 0;
+}
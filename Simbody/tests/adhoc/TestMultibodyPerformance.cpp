@@ -273,6 +273,27 @@ void createBallChain(MultibodySystem& system) {
     system.realizeTopology();
 }
 
+void createUniversalChain(MultibodySystem& system) {
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body;
+    MobilizedBody last = matter.updGround();
+    for (int i = 0; i < 256; i++) {
+        MobilizedBody::Universal next(last, Vec3(1, 0, 0), body, Vec3(0));
+        last = next;
+    }
+    system.realizeTopology();
+}
+
+void createFreeChain(MultibodySystem& system) {
+    SimbodyMatterSubsystem matter(system);
+    Body::Rigid body;
+    MobilizedBody last = matter.updGround();
+    for (int i = 0; i < 256; i++) {
+        MobilizedBody::Free next(last, Vec3(1, 0, 0), body, Vec3(0));
+        last = next;
+    }
+    system.realizeTopology();
+}
 
 void createGimbalChain(MultibodySystem& system) {
     SimbodyMatterSubsystem matter(system);
@@ -591,6 +612,18 @@ int main() {
         createBallChain(system);
         runAllTests(system, true);
     }
+    {
+        std::cout << "\nUniversal Chain:\n" << std::endl;
+        MultibodySystem system;
+        createUniversalChain(system);
+        runAllTests(system);
+    }
+    {
+        std::cout << "\nFree Chain (Quaternions):\n" << std::endl;
+        MultibodySystem system;
+        createFreeChain(system);
+        runAllTests(system, false);
+    }
     {
         std::cout << "\nGimbal Chain:\n" << std::endl;
         MultibodySystem system;